@@ -0,0 +1,125 @@
+/**
+ * Benchmarks for ALT on the synthetic road networks with arterials and
+ * highways: single queries with A* and bidirectional A* on landmark bounds,
+ * for several numbers of landmarks and both selection methods, against
+ * Dijkstra on the same node pairs. The landmark costs take num_landmarks
+ * floats per node, reported as memory_mb.
+ */
+#include <map>
+#include <chrono>
+#include <tuple>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <planning.h>
+#include <alt_landmarks.h>
+
+#include "bench_utils.h"
+#include "road_graph_utils.h"
+
+static const int kNumAltQueries = 64;
+
+/**
+ * Selects the landmarks of a road network once per count and method, and
+ * reports how long that took.
+ */
+static const AltLandmarks& roadGraphLandmarks(int side, int num_landmarks, int method, double& seconds)
+{
+    static std::map<std::tuple<int, int, int>, std::pair<AltLandmarks, double> > selected;
+    auto key = std::make_tuple(side, num_landmarks, method);
+    auto it = selected.find(key);
+    if (it == selected.end())
+    {
+        auto begin = std::chrono::steady_clock::now();
+        AltLandmarks alt = selectLandmarks(loadRoadGraph(side, true), num_landmarks, method);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        it = selected.emplace(key, std::make_pair(std::move(alt), elapsed)).first;
+    }
+    seconds = it->second.second;
+    return it->second.first;
+}
+
+/**
+ * The mean time of a Dijkstra query over the benchmark queries, timed once
+ * per network.
+ */
+static double dijkstraSeconds(int side)
+{
+    static std::map<int, double> timed;
+    auto it = timed.find(side);
+    if (it != timed.end()) return it->second;
+    const Graph& g = loadRoadGraph(side, true);
+    GraphSearchState search;
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto& query : roadGraphQueries(g, kNumAltQueries))
+    {
+        benchmark::DoNotOptimize(dijkstra(query.first, query.second, g, search).data());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    return timed[side] = seconds / kNumAltQueries;
+}
+
+/**
+ * Times single queries between random nodes, one per iteration.
+ */
+template <typename Search>
+static void runAltQueries(benchmark::State& state, Search search)
+{
+    const Graph& g = loadRoadGraph(state.range(0), true);
+    double select_seconds = 0;
+    const AltLandmarks& alt = roadGraphLandmarks(state.range(0), state.range(1), state.range(2), select_seconds);
+    auto queries = roadGraphQueries(g, kNumAltQueries);
+    double baseline = dijkstraSeconds(state.range(0));
+
+    size_t k = 0;
+    double expanded = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        const auto& query = queries[k++ % queries.size()];
+        expanded += search(query.first, query.second, g, alt);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    setExpansions(state, expanded);
+    state.counters["speedup"] = baseline / (seconds / state.iterations());
+    state.counters["memory_mb"] = alt.bytes() / 1e6;
+    state.counters["select_s"] = select_seconds;
+}
+
+/**
+ * Sets the network sizes, landmark counts and selection methods.
+ */
+static void altArgs(benchmark::internal::Benchmark* b)
+{
+    for (int side : {512, 1024})
+    {
+        for (int num_landmarks : {1, 4, 8, 16})
+        {
+            for (int method : {ALT_SELECT_FARTHEST, ALT_SELECT_AVOID}) b->Args({side, num_landmarks, method});
+        }
+    }
+    b->ArgNames({"side", "landmarks", "avoid"})->Unit(benchmark::kMillisecond);
+}
+
+static void BM_AltAStar(benchmark::State& state)
+{
+    GraphSearchState search;
+    runAltQueries(state, [&](int start, int goal, const Graph& g, const AltLandmarks& alt)
+    {
+        benchmark::DoNotOptimize(altAStar(start, goal, g, alt, search).data());
+        return search.expanded;
+    });
+}
+BENCHMARK(BM_AltAStar)->Apply(altArgs);
+
+static void BM_AltBidirectional(benchmark::State& state)
+{
+    AltQueryState search;
+    runAltQueries(state, [&](int start, int goal, const Graph& g, const AltLandmarks& alt)
+    {
+        benchmark::DoNotOptimize(altBidirectionalAStar(start, goal, g, alt, search).data());
+        return search.expanded;
+    });
+}
+BENCHMARK(BM_AltBidirectional)->Apply(altArgs);
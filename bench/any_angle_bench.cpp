@@ -0,0 +1,129 @@
+/**
+ * Benchmarks for any-angle planning. Theta*, Lazy Theta* and aStarSearch()
+ * followed by shortcutPath() are compared with plain aStarSearch() over the
+ * same start and goal pairs, reporting the waypoints and Euclidean length of
+ * each path along with the time.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/any_angle.h>
+
+#include "bench_utils.h"
+
+static const int kNumRooms = 12;
+static const int kCorridorWidth = 16;
+static const int kNumQueries = 16;
+static const int kMaxAnyAngleSize = 1024;
+
+/**
+ * The planners compared.
+ */
+enum AnyAnglePlanner
+{
+    PLANNER_ASTAR,
+    PLANNER_ASTAR_SHORTCUT,
+    PLANNER_THETA_STAR,
+    PLANNER_LAZY_THETA_STAR
+};
+
+/**
+ * Prepares a map with its C-space and random collision free start and goal
+ * pairs. Synthetic maps are rooms joined by corridors.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph, const std::string& map)
+{
+    if (map.empty())
+    {
+        generateRoomsMap(state.range(0), state.range(0), kNumRooms, kCorridorWidth, 0, graph);
+    }
+    else
+    {
+        loadDataMap(map, graph);
+    }
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+    std::vector<std::pair<Cell, Cell>> queries;
+    if (std::count(graph.cspace.begin(), graph.cspace.end(), 0) == 0) return queries;
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+static void runAnyAngleQueries(benchmark::State& state, const std::string& map, AnyAnglePlanner planner)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+
+    double expanded = 0, waypoints = 0, length = 0, checks = 0;
+    for (auto _ : state)
+    {
+        waypoints = length = 0;
+        for (const auto& query : queries)
+        {
+            graph.visited_cells.clear();
+            AnyAngleStats stats;
+            std::vector<Cell> path;
+            if (planner == PLANNER_THETA_STAR)
+            {
+                path = thetaStarSearch(graph, query.first, query.second, &stats);
+            }
+            else if (planner == PLANNER_LAZY_THETA_STAR)
+            {
+                path = lazyThetaStarSearch(graph, query.first, query.second, &stats);
+            }
+            else
+            {
+                path = aStarSearch(graph, query.first, query.second);
+                if (planner == PLANNER_ASTAR_SHORTCUT) path = shortcutPath(graph, path, &stats);
+                stats.expanded = graph.visited_cells.size();
+            }
+            benchmark::DoNotOptimize(path.data());
+            expanded += stats.expanded;
+            checks += stats.line_of_sight_checks;
+            waypoints += path.size();
+            length += anyAnglePathLength(path);
+        }
+    }
+    double num_queries = queries.empty() ? 1 : queries.size();
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, expanded / num_queries);
+    state.counters["line_of_sight_checks"] = benchmark::Counter(checks / num_queries, benchmark::Counter::kAvgIterations);
+    state.counters["waypoints"] = waypoints / num_queries;
+    state.counters["path_length"] = length / num_queries;
+}
+
+#define ANY_ANGLE_BENCHMARKS(name, planner)                                                                        \
+    static void BM_##name##_Synthetic(benchmark::State& state)                                                    \
+    {                                                                                                              \
+        runAnyAngleQueries(state, "", planner);                                                                    \
+    }                                                                                                              \
+    BENCHMARK(BM_##name##_Synthetic)                                                                              \
+        ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxAnyAngleSize); })                   \
+        ->Unit(benchmark::kMillisecond);                                                                           \
+    static void run##name(benchmark::State& state, const std::string& map)                                         \
+    {                                                                                                              \
+        runAnyAngleQueries(state, map, planner);                                                                   \
+    }                                                                                                              \
+    static int reg_##name = registerDataMapBenchmarks("BM_" #name, run##name, [](benchmark::internal::Benchmark* b) \
+                                                      { b->Unit(benchmark::kMillisecond); });
+
+ANY_ANGLE_BENCHMARKS(AnyAngleAStar, PLANNER_ASTAR)
+ANY_ANGLE_BENCHMARKS(AnyAngleAStarShortcut, PLANNER_ASTAR_SHORTCUT)
+ANY_ANGLE_BENCHMARKS(ThetaStar, PLANNER_THETA_STAR)
+ANY_ANGLE_BENCHMARKS(LazyThetaStar, PLANNER_LAZY_THETA_STAR)
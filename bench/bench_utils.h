@@ -0,0 +1,208 @@
+#ifndef PATH_PLANNING_BENCH_BENCH_UTILS_H
+#define PATH_PLANNING_BENCH_BENCH_UTILS_H
+
+#include <map>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <utility>
+#include <functional>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+
+#ifndef PATH_PLANNING_DATA_DIR
+#define PATH_PLANNING_DATA_DIR "../data"
+#endif
+
+/**
+ * The maps shipped in data/ that every data map benchmark runs over.
+ */
+static const std::vector<std::string> kDataMaps = {
+    "empty_map", "maze1", "maze2", "maze3", "maze4", "narrow",
+    "one_obstacle", "test_map", "tiny_map", "two_obstacles"
+};
+
+/**
+ * Returns the full path of a map in data/ given its name without extension.
+ */
+static inline std::string dataMapPath(const std::string& name)
+{
+    return std::string(PATH_PLANNING_DATA_DIR) + "/" + name + ".map";
+}
+
+/**
+ * Loads a map from data/. Maps are loaded once and cached since they are
+ * small, so callers get a copy they are free to modify.
+ * @param  name The name of the map without extension.
+ * @param[out]  graph The graph to populate.
+ * @return  True if the load succeeded, false otherwise.
+ */
+static inline bool loadDataMap(const std::string& name, GridGraph& graph)
+{
+    static std::map<std::string, GridGraph> cache;
+    auto it = cache.find(name);
+    if (it == cache.end())
+    {
+        GridGraph loaded;
+        if (!loadFromFile(dataMapPath(name), loaded)) return false;
+        it = cache.emplace(name, loaded).first;
+    }
+    graph = it->second;
+    return true;
+}
+
+/**
+ * Finds the first cell that is not in collision, scanning the rows from the
+ * given corner towards the opposite one. Maps too small to have a collision
+ * free cell fall back to the first unoccupied cell.
+ * @param  graph The graph to search.
+ * @param  from_end Whether to start from the last cell instead of the first.
+ * @return  The free cell, or {-1, -1} if there is none.
+ */
+static inline Cell findFreeCell(const GridGraph& graph, bool from_end = false)
+{
+    int num_cells = graph.width * graph.height;
+    for (int k = 0; k < num_cells; ++k)
+    {
+        int idx = from_end ? num_cells - 1 - k : k;
+        if (!checkCollision(idx, graph)) return idxToCell(idx, graph);
+    }
+    for (int k = 0; k < num_cells; ++k)
+    {
+        int idx = from_end ? num_cells - 1 - k : k;
+        if (!isIdxOccupied(idx, graph)) return idxToCell(idx, graph);
+    }
+    return {-1, -1};
+}
+
+/**
+ * Registers one benchmark per map in data/. The map name is passed to the
+ * benchmark function and appended to the benchmark name.
+ * @param  name The base name of the benchmark.
+ * @param  fn The benchmark function.
+ * @param  configure Optional callback to set units, iterations, etc.
+ * @return  Zero, so the call can be used to initialize a static variable.
+ */
+static inline int registerDataMapBenchmarks(const std::string& name,
+                                            void (*fn)(benchmark::State&, const std::string&),
+                                            std::function<void(benchmark::internal::Benchmark*)> configure = nullptr)
+{
+    for (const std::string& map : kDataMaps)
+    {
+        auto* b = benchmark::RegisterBenchmark((name + "/" + map).c_str(), fn, map);
+        if (configure) configure(b);
+    }
+    return 0;
+}
+
+/**
+ * Sets the synthetic map sizes, from 256x256 up to the given size.
+ */
+static inline void syntheticSizes(benchmark::internal::Benchmark* b, int max_size = 8192)
+{
+    b->RangeMultiplier(2)->Range(256, max_size);
+}
+
+/**
+ * Adds a counter reporting the time per cell in seconds. The console shows it
+ * with an SI prefix, so "12n" means 12 ns/cell.
+ */
+static inline void setTimePerCell(benchmark::State& state, double num_cells)
+{
+    state.counters["time_per_cell"] = benchmark::Counter(
+        num_cells, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * Adds counters reporting the node expansions per search and per second.
+ */
+static inline void setExpansions(benchmark::State& state, double expansions)
+{
+    state.counters["expansions"] = benchmark::Counter(expansions, benchmark::Counter::kAvgIterations);
+    state.counters["expansions_per_sec"] = benchmark::Counter(expansions, benchmark::Counter::kIsRate);
+}
+
+/**
+ * The DIMACS files of a synthetic road network, removed when the benchmarks
+ * exit.
+ */
+struct RoadGraphFiles
+{
+    std::string gr_path, co_path;
+
+    ~RoadGraphFiles()
+    {
+        std::remove(gr_path.c_str());
+        std::remove(co_path.c_str());
+    }
+};
+
+/**
+ * Writes a synthetic road network as DIMACS .gr and .co files: a side x side
+ * grid of intersections 1000 units apart, with a road in both directions
+ * between neighbors. Each road costs its length times a random factor from 1
+ * to 2, so the straight line distance never overestimates the cost. With a
+ * hierarchy, like real roads, every 16th row and column is an arterial twice
+ * as fast and every 64th a highway four times as fast, dividing the cost of
+ * their roads by their speed. Files are written once per size and kind and
+ * shared by every benchmark.
+ * @param  side The number of intersections along each side.
+ * @param  hierarchy Whether to add arterials and highways.
+ * @return  The files of the network.
+ */
+static inline const RoadGraphFiles& roadGraphFiles(int side, bool hierarchy = false)
+{
+    static std::map<std::pair<int, bool>, RoadGraphFiles> written;
+    auto key = std::make_pair(side, hierarchy);
+    auto it = written.find(key);
+    if (it != written.end()) return it->second;
+
+    RoadGraphFiles& files = written[key];
+    std::string name = "bench_road_" + std::to_string(side) + (hierarchy ? "_hierarchy" : "");
+    files.gr_path = name + ".gr";
+    files.co_path = name + ".co";
+    const int kSpacing = 1000;
+
+    FILE* gr = std::fopen(files.gr_path.c_str(), "w");
+    std::mt19937 gen(side);
+    std::uniform_int_distribution<int> cost(kSpacing, 2 * kSpacing);
+    auto speed = [hierarchy](int line)
+    {
+        if (!hierarchy) return 1;
+        return line % 64 == 0 ? 4 : line % 16 == 0 ? 2 : 1;
+    };
+    long num_arcs = 4L * side * (side - 1);
+    std::fprintf(gr, "c Synthetic grid road network\np sp %d %ld\n", side * side, num_arcs);
+    for (int j = 0; j < side; ++j)
+    {
+        for (int i = 0; i < side; ++i)
+        {
+            int id = 1 + i + j * side;
+            if (i + 1 < side)
+            {
+                int c = cost(gen) / speed(j);
+                std::fprintf(gr, "a %d %d %d\na %d %d %d\n", id, id + 1, c, id + 1, id, c);
+            }
+            if (j + 1 < side)
+            {
+                int c = cost(gen) / speed(i);
+                std::fprintf(gr, "a %d %d %d\na %d %d %d\n", id, id + side, c, id + side, id, c);
+            }
+        }
+    }
+    std::fclose(gr);
+
+    FILE* co = std::fopen(files.co_path.c_str(), "w");
+    std::fprintf(co, "c Synthetic grid road network\np aux sp co %d\n", side * side);
+    for (int j = 0; j < side; ++j)
+    {
+        for (int i = 0; i < side; ++i) std::fprintf(co, "v %d %d %d\n", 1 + i + j * side, i * kSpacing, j * kSpacing);
+    }
+    std::fclose(co);
+    return files;
+}
+
+#endif  // PATH_PLANNING_BENCH_BENCH_UTILS_H
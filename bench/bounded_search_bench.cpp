@@ -0,0 +1,130 @@
+/**
+ * Benchmarks for weighted A* and focal search, sweeping the suboptimality
+ * bound w. Each benchmark reports the expansions, the path cost and the
+ * proven bound, so that scripts/plot_bounded_search.py can plot expansions
+ * against w from the JSON output.
+ */
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/flow_field.h>
+#include <path_planning/graph_search/bounded_search.h>
+
+#include "bench_utils.h"
+
+static const std::vector<std::string> kMazeMaps = {"maze1", "maze2", "maze3", "maze4"};
+static const std::vector<int> kWeightsPercent = {100, 110, 125, 150, 200, 300, 500};
+static const float kObstacleDensity = 0.1;
+static const int kMinBoundedSize = 512;
+static const int kMaxBoundedSize = 2048;
+
+/**
+ * Runs a search between the first and last free cells reachable from the
+ * middle of the map, with w given in percent. Starting from the middle skips
+ * the small pockets that are often left in the corners.
+ */
+static void runBoundedSearch(benchmark::State& state, GridGraph& graph, int w_percent,
+                             BoundedSearchResult (*search)(GridGraph&, const Cell&, const Cell&, float))
+{
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+    int num_cells = graph.width * graph.height;
+    int middle = num_cells / 2 + graph.width / 2;
+    while (middle < num_cells - 1 && graph.cspace[middle]) ++middle;
+    FlowField field;
+    computeFlowField(graph, idxToCell(middle, graph), field);
+    auto reachable = [&](int idx) { return field.directions[idx] != FLOW_FIELD_UNREACHABLE && !graph.cspace[idx]; };
+    int first = 0, last = num_cells - 1;
+    while (first < last && !reachable(first)) ++first;
+    while (last > first && !reachable(last)) --last;
+    Cell start = idxToCell(first, graph), goal = idxToCell(last, graph);
+    float w = w_percent / 100.0f;
+
+    BoundedSearchResult result;
+    for (auto _ : state)
+    {
+        graph.visited_cells.clear();
+        result = search(graph, start, goal, w);
+        benchmark::DoNotOptimize(result.path.data());
+    }
+    setExpansions(state, state.iterations() * static_cast<double>(result.expanded));
+    state.counters["w"] = w;
+    state.counters["cost"] = result.cost;
+    state.counters["bound"] = result.bound;
+    state.counters["path_found"] = !result.path.empty();
+}
+
+/**
+ * Sets the synthetic map sizes and the bounds to sweep.
+ */
+static void syntheticBoundedArgs(benchmark::internal::Benchmark* b)
+{
+    for (int size = kMinBoundedSize; size <= kMaxBoundedSize; size *= 2)
+    {
+        for (int w_percent : kWeightsPercent) b->Args({size, w_percent});
+    }
+    b->ArgNames({"size", "w_percent"})->Unit(benchmark::kMillisecond);
+}
+
+static void runSynthetic(benchmark::State& state,
+                         BoundedSearchResult (*search)(GridGraph&, const Cell&, const Cell&, float))
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kObstacleDensity, 0, graph);
+    runBoundedSearch(state, graph, state.range(1), search);
+}
+
+static void BM_WeightedAStar_Synthetic(benchmark::State& state)
+{
+    runSynthetic(state, weightedAStarSearch);
+}
+BENCHMARK(BM_WeightedAStar_Synthetic)->Apply(syntheticBoundedArgs);
+
+static void BM_FocalSearch_Synthetic(benchmark::State& state)
+{
+    runSynthetic(state, focalSearch);
+}
+BENCHMARK(BM_FocalSearch_Synthetic)->Apply(syntheticBoundedArgs);
+
+static void runMaze(benchmark::State& state, const std::string& map,
+                    BoundedSearchResult (*search)(GridGraph&, const Cell&, const Cell&, float))
+{
+    GridGraph graph;
+    if (!loadDataMap(map, graph))
+    {
+        state.SkipWithError("Failed to load map");
+        return;
+    }
+    runBoundedSearch(state, graph, state.range(0), search);
+}
+
+static void runWeightedAStarMaze(benchmark::State& state, const std::string& map)
+{
+    runMaze(state, map, weightedAStarSearch);
+}
+
+static void runFocalSearchMaze(benchmark::State& state, const std::string& map)
+{
+    runMaze(state, map, focalSearch);
+}
+
+/**
+ * Registers a benchmark per maze map and bound.
+ */
+static int registerMazeBenchmarks(const std::string& name, void (*fn)(benchmark::State&, const std::string&))
+{
+    for (const std::string& map : kMazeMaps)
+    {
+        auto* b = benchmark::RegisterBenchmark((name + "/" + map).c_str(), fn, map);
+        for (int w_percent : kWeightsPercent) b->Arg(w_percent);
+        b->ArgName("w_percent")->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}
+
+static int reg_weighted_astar = registerMazeBenchmarks("BM_WeightedAStar", runWeightedAStarMaze);
+static int reg_focal = registerMazeBenchmarks("BM_FocalSearch", runFocalSearchMaze);
@@ -0,0 +1,100 @@
+/**
+ * Benchmarks for contraction hierarchies on the synthetic road networks with
+ * arterials and highways, which give the hierarchy its structure:
+ * preprocessing with a growing number of threads, and single queries against
+ * Dijkstra on the same node pairs. Preprocessing the 1024 network takes
+ * minutes, so only the smaller ones are run.
+ */
+#include <map>
+#include <chrono>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <planning.h>
+#include <contraction_hierarchy.h>
+
+#include "bench_utils.h"
+#include "road_graph_utils.h"
+
+static const int kNumChQueries = 64;
+static const int kMaxChSide = 512;
+
+/**
+ * Builds the hierarchy of a road network once, for the query benchmarks.
+ */
+static const ContractionHierarchy& roadGraphHierarchy(int side)
+{
+    static std::map<int, ContractionHierarchy> built;
+    auto it = built.find(side);
+    if (it == built.end())
+    {
+        it = built.emplace(side, buildContractionHierarchy(loadRoadGraph(side, true))).first;
+    }
+    return it->second;
+}
+
+static void BM_ChPreprocess(benchmark::State& state)
+{
+    const Graph& g = loadRoadGraph(state.range(0), true);
+    ContractionHierarchy ch;
+    for (auto _ : state)
+    {
+        ch = buildContractionHierarchy(g, state.range(1));
+        benchmark::DoNotOptimize(ch.up_arcs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * numNodes(g));
+    state.counters["shortcuts"] = ch.num_shortcuts;
+    state.counters["levels"] = ch.num_levels;
+    state.counters["arcs_per_node"] = static_cast<double>(ch.up_arcs.size() + ch.down_arcs.size()) / numNodes(g);
+}
+BENCHMARK(BM_ChPreprocess)->Apply([](benchmark::internal::Benchmark* b)
+    {
+        for (int side = 256; side <= kMaxChSide; side *= 2)
+        {
+            for (int threads : {1, 2, 4}) b->Args({side, threads});
+        }
+        b->ArgNames({"side", "threads"})->Unit(benchmark::kMillisecond)->Iterations(1);
+    });
+
+/**
+ * Times single queries between random nodes, one per iteration. The speedup
+ * counter compares with Dijkstra over the same queries, timed once.
+ */
+static void BM_ChQuery(benchmark::State& state)
+{
+    const Graph& g = loadRoadGraph(state.range(0), true);
+    const ContractionHierarchy& ch = roadGraphHierarchy(state.range(0));
+    auto queries = roadGraphQueries(g, kNumChQueries);
+
+    using Clock = std::chrono::steady_clock;
+    GraphSearchState search;
+    auto begin = Clock::now();
+    double dijkstra_expanded = 0;
+    for (const auto& query : queries)
+    {
+        benchmark::DoNotOptimize(dijkstra(query.first, query.second, g, search).data());
+        dijkstra_expanded += search.expanded;
+    }
+    double dijkstra_seconds = std::chrono::duration<double>(Clock::now() - begin).count() / queries.size();
+
+    ChQueryState query_state;
+    size_t k = 0;
+    double settled = 0;
+    begin = Clock::now();
+    for (auto _ : state)
+    {
+        const auto& query = queries[k++ % queries.size()];
+        benchmark::DoNotOptimize(chQuery(query.first, query.second, ch, query_state).data());
+        settled += query_state.settled;
+    }
+    double ch_seconds = std::chrono::duration<double>(Clock::now() - begin).count() / state.iterations();
+    setExpansions(state, settled);
+    state.counters["dijkstra_expansions"] = dijkstra_expanded / queries.size();
+    state.counters["speedup"] = dijkstra_seconds / ch_seconds;
+}
+BENCHMARK(BM_ChQuery)->Apply([](benchmark::internal::Benchmark* b)
+    {
+        roadGraphSizes(b, kMaxChSide);
+        b->Unit(benchmark::kMicrosecond);
+    });
@@ -0,0 +1,106 @@
+/**
+ * Benchmarks for many-to-many distance tables on the synthetic road
+ * networks with arterials and highways, against filling the same table with
+ * one bfs() or dijkstra() call per pair. Every benchmark reports the pairs it
+ * fills per second.
+ */
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <planning.h>
+#include <distance_table.h>
+
+#include "bench_utils.h"
+#include "road_graph_utils.h"
+
+/**
+ * Picks random source and target nodes, the same ones for every benchmark
+ * on a graph of that size.
+ */
+static void tableNodes(const Graph& g, int count, std::vector<int>& sources, std::vector<int>& targets)
+{
+    std::mt19937 gen(numNodes(g) + count);
+    std::uniform_int_distribution<int> node(0, numNodes(g) - 1);
+    sources.clear();
+    targets.clear();
+    for (int k = 0; k < count; ++k) sources.push_back(node(gen));
+    for (int k = 0; k < count; ++k) targets.push_back(node(gen));
+}
+
+static void BM_DistanceTable(benchmark::State& state)
+{
+    const Graph& g = loadRoadGraph(state.range(0), true);
+    std::vector<int> sources, targets;
+    tableNodes(g, state.range(1), sources, targets);
+    for (auto _ : state)
+    {
+        DistanceTable table = distanceTable(sources, targets, g, state.range(3), state.range(2));
+        benchmark::DoNotOptimize(table.cost.data());
+    }
+    state.SetItemsProcessed(state.iterations() * sources.size() * targets.size());
+}
+BENCHMARK(BM_DistanceTable)->Apply([](benchmark::internal::Benchmark* b)
+    {
+        for (int side : {256, 1024})
+        {
+            for (int count : {16, 64})
+            {
+                for (int threads : {1, 2, 4}) b->Args({side, count, threads, 0});
+                b->Args({side, count, 1, 1});
+            }
+        }
+        b->ArgNames({"side", "count", "threads", "paths"})->Unit(benchmark::kMillisecond)->UseRealTime();
+    });
+
+/**
+ * Fills a count x count table with one Dijkstra query per pair, reusing the
+ * search state.
+ */
+static void BM_PairwiseDijkstra(benchmark::State& state)
+{
+    const Graph& g = loadRoadGraph(state.range(0), true);
+    std::vector<int> sources, targets;
+    tableNodes(g, state.range(1), sources, targets);
+    GraphSearchState search;
+    std::vector<double> table(sources.size() * targets.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            for (size_t j = 0; j < targets.size(); ++j)
+            {
+                dijkstra(sources[i], targets[j], g, search);
+                table[i * targets.size() + j] = pathCost(targets[j], search);
+            }
+        }
+        benchmark::DoNotOptimize(table.data());
+    }
+    state.SetItemsProcessed(state.iterations() * table.size());
+}
+BENCHMARK(BM_PairwiseDijkstra)->Args({256, 16})->Args({1024, 16})->ArgNames({"side", "count"})
+    ->Unit(benchmark::kMillisecond)->Iterations(1);
+
+/**
+ * Fills a count x count table with one bfs() call per pair, which resets the
+ * whole graph every time.
+ */
+static void BM_PairwiseBfs(benchmark::State& state)
+{
+    Graph& g = loadRoadGraph(state.range(0), true);
+    std::vector<int> sources, targets;
+    tableNodes(g, state.range(1), sources, targets);
+    std::vector<size_t> lengths(sources.size() * targets.size());
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            for (size_t j = 0; j < targets.size(); ++j) lengths[i * targets.size() + j] = bfs(sources[i], targets[j], g).size();
+        }
+        benchmark::DoNotOptimize(lengths.data());
+    }
+    state.SetItemsProcessed(state.iterations() * lengths.size());
+}
+BENCHMARK(BM_PairwiseBfs)->Args({256, 16})->Args({1024, 16})->ArgNames({"side", "count"})
+    ->Unit(benchmark::kMillisecond)->Iterations(1);
@@ -0,0 +1,100 @@
+/**
+ * Benchmarks for sending many robots to one goal: one search per robot
+ * against one flow field shared by all of them.
+ */
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/flow_field.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.1;
+static const int kNumStarts = 64;
+static const int kMaxFlowFieldSize = 2048;  // Computing the C-space of larger maps takes too long.
+
+/**
+ * Generates a synthetic map with its C-space and picks a goal and random
+ * collision free starts.
+ */
+static Cell prepareMap(benchmark::State& state, GridGraph& graph, std::vector<Cell>& starts)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    computeCSpace(graph);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    while (starts.size() < kNumStarts)
+    {
+        int idx = pos(gen);
+        if (!graph.cspace[idx]) starts.push_back(idxToCell(idx, graph));
+    }
+    return findFreeCell(graph, true);
+}
+
+static void BM_ManyStarts_AStar(benchmark::State& state)
+{
+    GridGraph graph;
+    std::vector<Cell> starts;
+    Cell goal = prepareMap(state, graph, starts);
+    for (auto _ : state)
+    {
+        for (const Cell& start : starts)
+        {
+            auto path = aStarSearch(graph, start, goal);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+BENCHMARK(BM_ManyStarts_AStar)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, 1024); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Includes computing the field, as for the first robot sent to a goal.
+static void BM_ManyStarts_FlowField(benchmark::State& state)
+{
+    GridGraph graph;
+    std::vector<Cell> starts;
+    Cell goal = prepareMap(state, graph, starts);
+    FlowField field;
+    for (auto _ : state)
+    {
+        computeFlowField(graph, goal, field);
+        for (const Cell& start : starts)
+        {
+            auto path = flowFieldPath(field, start);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+BENCHMARK(BM_ManyStarts_FlowField)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxFlowFieldSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Paths from a field that is already cached.
+static void BM_ManyStarts_CachedFlowField(benchmark::State& state)
+{
+    GridGraph graph;
+    std::vector<Cell> starts;
+    Cell goal = prepareMap(state, graph, starts);
+    FlowFieldCache cache;
+    cache.getField(graph, goal);
+    for (auto _ : state)
+    {
+        for (const Cell& start : starts)
+        {
+            auto path = cache.findPath(graph, start, goal);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+    state.counters["field_bytes"] = static_cast<double>(graph.width) * graph.height;
+}
+BENCHMARK(BM_ManyStarts_CachedFlowField)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxFlowFieldSize); })
+    ->Unit(benchmark::kMicrosecond)->UseRealTime();
@@ -0,0 +1,102 @@
+/**
+ * Benchmarks for HPA*: building the abstraction, and queries against
+ * full-resolution aStarSearch() over the same start and goal pairs.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/hpa_star.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.1;
+static const int kNumQueries = 16;
+static const int kMaxHpaSize = 2048;  // Computing the C-space of larger maps takes too long.
+
+/**
+ * Generates a synthetic map with its C-space and random collision free
+ * start and goal pairs.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    computeCSpace(graph);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    std::vector<std::pair<Cell, Cell>> queries;
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+static void BM_HpaBuild_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    prepareMap(state, graph);
+    HierarchicalGraph hpa;
+    for (auto _ : state)
+    {
+        buildHierarchicalGraph(graph, HPA_DEFAULT_CLUSTER_SIZE, hpa);
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+    state.counters["abstract_nodes"] = hpa.node_cells.size();
+    state.counters["abstract_bytes"] = hierarchicalGraphBytes(hpa);
+}
+BENCHMARK(BM_HpaBuild_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxHpaSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_HpaQuery_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    HierarchicalGraph hpa;
+    buildHierarchicalGraph(graph, HPA_DEFAULT_CLUSTER_SIZE, hpa);
+
+    double abstract_expanded = 0, cell_expanded = 0, fallbacks = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            HpaSearchStats stats;
+            auto path = hierarchicalSearch(graph, hpa, query.first, query.second, &stats);
+            benchmark::DoNotOptimize(path.data());
+            abstract_expanded += stats.abstract_expanded;
+            cell_expanded += stats.cell_expanded;
+            fallbacks += stats.fallback;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, (abstract_expanded + cell_expanded) / queries.size());
+    state.counters["fallbacks"] = benchmark::Counter(fallbacks, benchmark::Counter::kAvgIterations);
+    state.counters["build_ms"] = 1000 * hpa.build_seconds;
+}
+BENCHMARK(BM_HpaQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxHpaSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_AStarQuery_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            auto path = aStarSearch(graph, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_AStarQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxHpaSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,189 @@
+/**
+ * Benchmarks for reading and writing text map files. The iostream based
+ * reference implementations below are the original loadFromFile() and
+ * mapAsString(), kept here to measure the native parser and writer against.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/utils/map_generator.h>
+
+#include "bench_utils.h"
+
+/**
+ * Reference map loader reading each cell with operator>>.
+ */
+static bool loadFromFileStream(const std::string& file_path, GridGraph& graph)
+{
+    std::ifstream in(file_path);
+    if (!in.is_open()) return false;
+
+    in >> graph.origin_x >> graph.origin_y >> graph.width >> graph.height >> graph.meters_per_cell;
+    int num_cells = graph.width * graph.height;
+    graph.cell_odds.resize(num_cells);
+    graph.obstacle_distances = std::vector<float>(num_cells, 0);
+
+    int odds;
+    for (int idx = 0; idx < num_cells; ++idx)
+    {
+        in >> odds;
+        graph.cell_odds[idx] = odds;
+    }
+    initGraph(graph);
+    return true;
+}
+
+/**
+ * Reference map writer formatting each cell with an std::ostringstream.
+ */
+static std::string mapAsStringStream(GridGraph& graph)
+{
+    std::ostringstream oss;
+    oss << graph.origin_x << " " << graph.origin_y << " ";
+    oss << graph.width << " " << graph.height << " " << graph.meters_per_cell << " ";
+
+    for (int j = 0; j < graph.height; j++)
+    {
+        for (int i = 0; i < graph.width; i++)
+        {
+            oss << +graph.cell_odds[cellToIdx(i, j, graph)] << " ";
+        }
+    }
+    return oss.str();
+}
+
+/**
+ * Gets the size of a file in bytes.
+ */
+static long fileSize(const std::string& file_path)
+{
+    std::ifstream in(file_path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? static_cast<long>(in.tellg()) : 0;
+}
+
+/**
+ * Writes a generated map of the given size to a text or binary map file,
+ * with a distance transform layer for binary maps, in the working directory, which is removed when the object goes out of scope.
+ */
+struct TempMapFile
+{
+    explicit TempMapFile(int size, bool binary = false)
+        : path("planner_bench_" + std::to_string(size) + (binary ? ".bin" : ".map"))
+    {
+        GridGraph graph;
+        generateRandomObstacleMap(size, size, 0.1, 0, graph);
+        if (binary) saveToBinaryFile(path, graph, true);
+        else saveToFile(path, graph);
+    }
+    ~TempMapFile() { std::remove(path.c_str()); }
+
+    std::string path;
+};
+
+using LoadFn = bool (*)(const std::string&, GridGraph&);
+
+/**
+ * Loads a map file repeatedly, reporting the bytes read per second.
+ */
+static void runLoad(benchmark::State& state, const std::string& file_path, LoadFn load)
+{
+    for (auto _ : state)
+    {
+        GridGraph graph;
+        if (!load(file_path, graph))
+        {
+            state.SkipWithError(("Failed to load map " + file_path).c_str());
+            return;
+        }
+        benchmark::DoNotOptimize(graph.cell_odds.data());
+    }
+    state.SetBytesProcessed(state.iterations() * fileSize(file_path));
+}
+
+/**
+ * Converts a map to a string repeatedly, reporting the bytes written per second.
+ */
+static void runWrite(benchmark::State& state, GridGraph& graph, std::string (*write)(GridGraph&))
+{
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+        std::string out = write(graph);
+        benchmark::DoNotOptimize(out.data());
+        bytes += out.size();
+    }
+    state.SetBytesProcessed(bytes);
+}
+
+static void BM_LoadFromFileStream(benchmark::State& state, const std::string& map)
+{
+    runLoad(state, dataMapPath(map), loadFromFileStream);
+}
+static int reg_load_stream = registerDataMapBenchmarks("BM_LoadFromFileStream", BM_LoadFromFileStream);
+
+static void BM_LoadFromFile(benchmark::State& state, const std::string& map)
+{
+    runLoad(state, dataMapPath(map), loadFromFile);
+}
+static int reg_load = registerDataMapBenchmarks("BM_LoadFromFile", BM_LoadFromFile);
+
+static void BM_LoadFromFileStream_Synthetic(benchmark::State& state)
+{
+    TempMapFile file(state.range(0));
+    runLoad(state, file.path, loadFromFileStream);
+}
+BENCHMARK(BM_LoadFromFileStream_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, 4096); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LoadFromFile_Synthetic(benchmark::State& state)
+{
+    TempMapFile file(state.range(0));
+    runLoad(state, file.path, loadFromFile);
+}
+BENCHMARK(BM_LoadFromFile_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, 4096); })
+    ->Unit(benchmark::kMillisecond);
+
+// Loading a binary map maps the file without reading the cells, so this is
+// the startup latency rather than a throughput.
+static void BM_LoadFromBinaryFile_Synthetic(benchmark::State& state)
+{
+    TempMapFile file(state.range(0), true);
+    runLoad(state, file.path, loadFromFile);
+}
+BENCHMARK(BM_LoadFromBinaryFile_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_LoadFromBinaryFileVerified_Synthetic(benchmark::State& state)
+{
+    TempMapFile file(state.range(0), true);
+    runLoad(state, file.path, [](const std::string& path, GridGraph& graph) {
+        return loadFromBinaryFile(path, graph, true);
+    });
+}
+BENCHMARK(BM_LoadFromBinaryFileVerified_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_MapAsStringStream_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), 0.1, 0, graph);
+    runWrite(state, graph, mapAsStringStream);
+}
+BENCHMARK(BM_MapAsStringStream_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, 4096); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_MapAsString_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), 0.1, 0, graph);
+    runWrite(state, graph, mapAsString);
+}
+BENCHMARK(BM_MapAsString_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, 4096); })
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,145 @@
+/**
+ * Benchmarks for coarse to fine search over a map pyramid, against
+ * aStarSearch() and a full resolution search of the C-space over the same
+ * start and goal pairs.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/map_pyramid.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.02;  // The pyramid targets mostly open maps.
+static const int kNumQueries = 16;
+static const int kMaxPyramidSize = 2048;  // Computing the C-space of larger maps takes too long.
+
+/**
+ * Generates a synthetic map with its C-space and random collision free
+ * start and goal pairs.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    computeCSpace(graph);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    std::vector<std::pair<Cell, Cell>> queries;
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+/**
+ * Total octile cost of a path.
+ */
+static double pathCost(const std::vector<Cell>& path)
+{
+    double cost = 0;
+    for (size_t k = 1; k < path.size(); ++k)
+    {
+        cost += path[k].i != path[k - 1].i && path[k].j != path[k - 1].j ? M_SQRT2 : 1;
+    }
+    return cost;
+}
+
+/**
+ * Searches with a pyramid of the given number of coarse levels. With none,
+ * this is A* over the full resolution C-space.
+ */
+static void runPyramidQueries(benchmark::State& state, int num_levels)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    MapPyramid pyramid;
+    buildMapPyramid(graph, pyramid, num_levels);
+
+    // The cost of the paths relative to the shortest ones.
+    MapPyramid full;
+    buildMapPyramid(graph, full, 0);
+    double cost = 0, optimal_cost = 0;
+    for (const auto& query : queries)
+    {
+        cost += pathCost(pyramidSearch(graph, pyramid, query.first, query.second));
+        optimal_cost += pathCost(pyramidSearch(graph, full, query.first, query.second));
+    }
+
+    double expanded = 0, fallbacks = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            PyramidSearchStats stats;
+            auto path = pyramidSearch(graph, pyramid, query.first, query.second, &stats);
+            benchmark::DoNotOptimize(path.data());
+            expanded += stats.expanded;
+            fallbacks += stats.fallback;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, expanded / queries.size());
+    state.counters["fallbacks"] = benchmark::Counter(fallbacks, benchmark::Counter::kAvgIterations);
+    state.counters["cost_ratio"] = optimal_cost > 0 ? cost / optimal_cost : 1;
+}
+
+static void BM_PyramidQuery_Synthetic(benchmark::State& state)
+{
+    runPyramidQueries(state, PYRAMID_DEFAULT_LEVELS);
+}
+BENCHMARK(BM_PyramidQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPyramidSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PyramidFullResolutionQuery_Synthetic(benchmark::State& state)
+{
+    runPyramidQueries(state, 0);
+}
+BENCHMARK(BM_PyramidFullResolutionQuery_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPyramidSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PyramidAStarQuery_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            graph.visited_cells.clear();
+            auto path = aStarSearch(graph, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+            expanded += graph.visited_cells.size();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, expanded / queries.size());
+}
+BENCHMARK(BM_PyramidAStarQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPyramidSize); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PyramidBuild_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    prepareMap(state, graph);
+    MapPyramid pyramid;
+    for (auto _ : state)
+    {
+        buildMapPyramid(graph, pyramid);
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+    state.counters["levels_bytes"] = mapPyramidBytes(pyramid);
+}
+BENCHMARK(BM_PyramidBuild_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPyramidSize); })
+    ->Unit(benchmark::kMillisecond);
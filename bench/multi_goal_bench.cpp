@@ -0,0 +1,96 @@
+/**
+ * Benchmarks for finding the nearest of many goals, with one multi-goal
+ * search against one aStarSearch() per goal.
+ */
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/multi_goal_search.h>
+
+#include "bench_utils.h"
+
+static const float kObstacleDensity = 0.1;
+static const int kMaxMultiGoalSize = 1024;
+
+/**
+ * Prepares a random obstacle map with its C-space, a free start near the
+ * middle and the given number of random free goals.
+ */
+static void prepareMap(benchmark::State& state, GridGraph& graph, Cell& start, std::vector<Cell>& goals)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kObstacleDensity, 0, graph);
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+
+    int num_cells = graph.width * graph.height;
+    int middle = num_cells / 2 + graph.width / 2;
+    while (middle < num_cells - 1 && graph.cspace[middle]) ++middle;
+    start = idxToCell(middle, graph);
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, num_cells - 1);
+    goals.clear();
+    while (static_cast<int>(goals.size()) < state.range(1))
+    {
+        int idx = pos(gen);
+        if (!graph.cspace[idx]) goals.push_back(idxToCell(idx, graph));
+    }
+}
+
+/**
+ * Sets the synthetic map sizes and the numbers of goals.
+ */
+static void multiGoalArgs(benchmark::internal::Benchmark* b)
+{
+    for (int size = 256; size <= kMaxMultiGoalSize; size *= 2)
+    {
+        for (int num_goals : {4, 16, 64}) b->Args({size, num_goals});
+    }
+    b->ArgNames({"size", "goals"})->Unit(benchmark::kMillisecond);
+}
+
+static void BM_MultiGoalSearch(benchmark::State& state)
+{
+    GridGraph graph;
+    Cell start;
+    std::vector<Cell> goals;
+    prepareMap(state, graph, start, goals);
+
+    MultiGoalResult result;
+    for (auto _ : state)
+    {
+        graph.visited_cells.clear();
+        result = multiGoalSearch(graph, start, goals);
+        benchmark::DoNotOptimize(result.path.data());
+    }
+    setExpansions(state, state.iterations() * static_cast<double>(result.expanded));
+    state.counters["cost"] = result.cost;
+}
+BENCHMARK(BM_MultiGoalSearch)->Apply(multiGoalArgs);
+
+static void BM_MultiGoalAStarPerGoal(benchmark::State& state)
+{
+    GridGraph graph;
+    Cell start;
+    std::vector<Cell> goals;
+    prepareMap(state, graph, start, goals);
+
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const Cell& goal : goals)
+        {
+            graph.visited_cells.clear();
+            auto path = aStarSearch(graph, start, goal);
+            benchmark::DoNotOptimize(path.data());
+            expanded += graph.visited_cells.size();
+        }
+    }
+    setExpansions(state, expanded);
+}
+BENCHMARK(BM_MultiGoalAStarPerGoal)->Apply(multiGoalArgs);
@@ -0,0 +1,166 @@
+/**
+ * Benchmarks for the bit-packed occupancy grid, each against a version that
+ * reads the cell odds one byte at a time.
+ */
+#include <array>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/utils/occupancy_bits.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.1;
+static const int kNumSegments = 4096;
+static const int kSegmentReach = 64;
+
+/**
+ * Picks random segments of up to kSegmentReach cells in each direction.
+ */
+static std::vector<std::array<int, 4>> randomSegments(const GridGraph& graph)
+{
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos_i(0, graph.width - 1), pos_j(0, graph.height - 1);
+    std::uniform_int_distribution<int> offset(-kSegmentReach, kSegmentReach);
+    std::vector<std::array<int, 4>> segments(kNumSegments);
+    for (auto& segment : segments)
+    {
+        segment[0] = pos_i(gen);
+        segment[1] = pos_j(gen);
+        segment[2] = std::min(std::max(segment[0] + offset(gen), 0), graph.width - 1);
+        segment[3] = std::min(std::max(segment[1] + offset(gen), 0), graph.height - 1);
+    }
+    return segments;
+}
+
+/**
+ * The same row by row line of sight test as lineOfSight(), checking each span
+ * one cell odds byte at a time.
+ */
+static bool lineOfSightOdds(const GridGraph& graph, int i0, int j0, int i1, int j1)
+{
+    auto spanClear = [&graph](int j, int first, int last)
+    {
+        if (first < 0 || last >= graph.width) return false;
+        const int8_t* row = graph.cell_odds.data() + j * static_cast<size_t>(graph.width);
+        for (int i = first; i <= last; ++i)
+        {
+            if (row[i] >= graph.threshold) return false;
+        }
+        return true;
+    };
+    if (j0 > j1)
+    {
+        std::swap(i0, i1);
+        std::swap(j0, j1);
+    }
+    if (j0 == j1) return spanClear(j0, std::min(i0, i1), std::max(i0, i1));
+
+    int64_t x0 = 2 * i0 + 1, y0 = 2 * j0 + 1, dx = 2 * (i1 - i0), dy = 2 * (j1 - j0);
+    for (int j = j0; j <= j1; ++j)
+    {
+        int64_t lo = x0 * dy + (std::max<int64_t>(2 * j, y0) - y0) * dx;
+        int64_t hi = x0 * dy + (std::min<int64_t>(2 * j + 2, y0 + dy) - y0) * dx;
+        if (lo > hi) std::swap(lo, hi);
+        int first = lo / (2 * dy) - (lo % (2 * dy) == 0);
+        if (!spanClear(j, first, hi / (2 * dy))) return false;
+    }
+    return true;
+}
+
+static void BM_CountOccupied_Odds(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    int64_t num_cells = static_cast<int64_t>(graph.width) * graph.height;
+    for (auto _ : state)
+    {
+        int64_t count = 0;
+        for (int64_t idx = 0; idx < num_cells; ++idx) count += graph.cell_odds[idx] >= graph.threshold;
+        benchmark::DoNotOptimize(count);
+    }
+    setTimePerCell(state, num_cells);
+}
+BENCHMARK(BM_CountOccupied_Odds)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_CountOccupied_Bits(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(countSetBits(graph.occupancy_bits, 0, 0, graph.width - 1, graph.height - 1));
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+}
+BENCHMARK(BM_CountOccupied_Bits)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_LineOfSight_Odds(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    auto segments = randomSegments(graph);
+    for (auto _ : state)
+    {
+        int num_clear = 0;
+        for (const auto& s : segments) num_clear += lineOfSightOdds(graph, s[0], s[1], s[2], s[3]);
+        benchmark::DoNotOptimize(num_clear);
+    }
+    state.SetItemsProcessed(state.iterations() * segments.size());
+}
+BENCHMARK(BM_LineOfSight_Odds)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_LineOfSight_Bits(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    auto segments = randomSegments(graph);
+    for (auto _ : state)
+    {
+        int num_clear = 0;
+        for (const auto& s : segments) num_clear += lineOfSight(graph.occupancy_bits, s[0], s[1], s[2], s[3]);
+        benchmark::DoNotOptimize(num_clear);
+    }
+    state.SetItemsProcessed(state.iterations() * segments.size());
+}
+BENCHMARK(BM_LineOfSight_Bits)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMicrosecond);
+
+// Empty maps, so that every segment is scanned to the end.
+static void BM_LineOfSight_Bits_Empty(benchmark::State& state)
+{
+    GridGraph graph;
+    generateEmptyMap(state.range(0), state.range(0), graph);
+    auto segments = randomSegments(graph);
+    for (auto _ : state)
+    {
+        int num_clear = 0;
+        for (const auto& s : segments) num_clear += lineOfSight(graph.occupancy_bits, s[0], s[1], s[2], s[3]);
+        benchmark::DoNotOptimize(num_clear);
+    }
+    state.SetItemsProcessed(state.iterations() * segments.size());
+}
+BENCHMARK(BM_LineOfSight_Bits_Empty)->Arg(1024)->Unit(benchmark::kMicrosecond);
+
+static void BM_LineOfSight_Odds_Empty(benchmark::State& state)
+{
+    GridGraph graph;
+    generateEmptyMap(state.range(0), state.range(0), graph);
+    auto segments = randomSegments(graph);
+    for (auto _ : state)
+    {
+        int num_clear = 0;
+        for (const auto& s : segments) num_clear += lineOfSightOdds(graph, s[0], s[1], s[2], s[3]);
+        benchmark::DoNotOptimize(num_clear);
+    }
+    state.SetItemsProcessed(state.iterations() * segments.size());
+}
+BENCHMARK(BM_LineOfSight_Odds_Empty)->Arg(1024)->Unit(benchmark::kMicrosecond);
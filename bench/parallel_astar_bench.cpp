@@ -0,0 +1,125 @@
+/**
+ * Benchmarks for parallel A* on large maps, across thread counts. Each run
+ * reports its speedup and search overhead (expansions per expansion) against
+ * a single aStarSearch() over the same query, timed once per map.
+ */
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/parallel_astar.h>
+
+#include "bench_utils.h"
+
+static const int kNumRooms = 64;
+static const int kCorridorWidth = 16;
+
+/**
+ * The seconds and expansions of aStarSearch() on a map.
+ */
+struct AStarBaseline
+{
+    double seconds;
+    double expanded;
+};
+
+/**
+ * Prepares a rooms map or a maze with its C-space, with a query
+ * between its first and last collision free cells.
+ */
+static void prepareMap(benchmark::State& state, GridGraph& graph, Cell& start, Cell& goal, bool maze)
+{
+    if (maze)
+    {
+        generateMazeMap(state.range(0), state.range(0), kCorridorWidth, 0, graph);
+    }
+    else
+    {
+        generateRoomsMap(state.range(0), state.range(0), kNumRooms, kCorridorWidth, 0, graph);
+    }
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+    int num_cells = graph.width * graph.height, first = 0, last = num_cells - 1;
+    while (first < num_cells - 1 && graph.cspace[first]) ++first;
+    while (last > 0 && graph.cspace[last]) --last;
+    start = idxToCell(first, graph);
+    goal = idxToCell(last, graph);
+}
+
+/**
+ * Times aStarSearch() once per map, since it does not depend on the number
+ * of threads.
+ */
+static const AStarBaseline& aStarBaseline(GridGraph& graph, const Cell& start, const Cell& goal, bool maze)
+{
+    static std::map<std::pair<int, bool>, AStarBaseline> baselines;
+    auto key = std::make_pair(graph.width, maze);
+    auto it = baselines.find(key);
+    if (it != baselines.end()) return it->second;
+
+    graph.visited_cells.clear();
+    auto begin = std::chrono::steady_clock::now();
+    auto path = aStarSearch(graph, start, goal);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    benchmark::DoNotOptimize(path.data());
+    AStarBaseline baseline = {elapsed.count(), static_cast<double>(graph.visited_cells.size())};
+    return baselines.emplace(key, baseline).first->second;
+}
+
+static void runParallelAStar(benchmark::State& state, bool maze)
+{
+    GridGraph graph;
+    Cell start, goal;
+    prepareMap(state, graph, start, goal, maze);
+    const AStarBaseline& baseline = aStarBaseline(graph, start, goal, maze);
+
+    ParallelAStarResult result;
+    double seconds = 0;
+    for (auto _ : state)
+    {
+        graph.visited_cells.clear();
+        auto begin = std::chrono::steady_clock::now();
+        result = parallelAStarSearch(graph, start, goal, state.range(1));
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        seconds += elapsed.count();
+        benchmark::DoNotOptimize(result.path.data());
+    }
+    double iterations = state.iterations();
+    setExpansions(state, iterations * result.expanded);
+    state.counters["reexpanded"] = result.reexpanded;
+    state.counters["messages"] = result.messages;
+    state.counters["cost"] = result.cost;
+    state.counters["search_overhead"] = baseline.expanded > 0 ? result.expanded / baseline.expanded : 0;
+    state.counters["speedup"] = seconds > 0 ? baseline.seconds * iterations / seconds : 0;
+}
+
+/**
+ * Sets the map sizes and the numbers of threads.
+ */
+static void parallelAStarArgs(benchmark::internal::Benchmark* b)
+{
+    for (int size : {4096, 8192})
+    {
+        for (int num_threads : {1, 2, 4, 8}) b->Args({size, num_threads});
+    }
+    b->ArgNames({"size", "threads"})->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+static void BM_ParallelAStar_Rooms(benchmark::State& state)
+{
+    runParallelAStar(state, false);
+}
+BENCHMARK(BM_ParallelAStar_Rooms)->Apply(parallelAStarArgs);
+
+static void BM_ParallelAStar_Maze(benchmark::State& state)
+{
+    runParallelAStar(state, true);
+}
+BENCHMARK(BM_ParallelAStar_Maze)->Apply(parallelAStarArgs);
@@ -0,0 +1,131 @@
+/**
+ * Benchmarks for the path cache on a dispatch-like workload: queries between
+ * a few depots and to random cells, with the map optionally edited every few
+ * queries. Each iteration starts from an empty cache and the original map, and
+ * is compared with planning every query.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/bounded_search.h>
+#include <path_planning/graph_search/path_cache.h>
+
+#include "bench_utils.h"
+
+static const int kNumRooms = 12;
+static const int kCorridorWidth = 16;
+static const int kNumDepots = 6;
+static const int kNumQueries = 256;
+
+/**
+ * A query, and the cell to block before it if any.
+ */
+struct CacheQuery
+{
+    Cell start, goal;
+    int edit;   // The index of the cell to block first, or -1.
+};
+
+/**
+ * Prepares a rooms map with its C-space and the queries. Half the queries
+ * are between two depots, the rest from a depot to a random cell.
+ */
+static std::vector<CacheQuery> prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRoomsMap(state.range(0), state.range(0), kNumRooms, kCorridorWidth, 0, graph);
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idx;
+    };
+    std::vector<Cell> depots;
+    while (depots.size() < kNumDepots) depots.push_back(idxToCell(freeCell(), graph));
+
+    std::uniform_int_distribution<int> depot(0, kNumDepots - 1);
+    std::vector<CacheQuery> queries;
+    int edit_every = state.range(1);
+    for (int k = 0; k < kNumQueries; ++k)
+    {
+        Cell start = depots[depot(gen)];
+        Cell goal = k % 2 == 0 ? depots[depot(gen)] : idxToCell(freeCell(), graph);
+        int edit = edit_every > 0 && k > 0 && k % edit_every == 0 ? freeCell() : -1;
+        queries.push_back({start, goal, edit});
+    }
+    return queries;
+}
+
+/**
+ * Sets the map sizes and how often the map is edited.
+ */
+static void pathCacheArgs(benchmark::internal::Benchmark* b)
+{
+    for (int size = 256; size <= 1024; size *= 2)
+    {
+        for (int edit_every : {0, 16}) b->Args({size, edit_every});
+    }
+    b->ArgNames({"size", "edit_every"})->Unit(benchmark::kMillisecond);
+}
+
+static void BM_PathCache(benchmark::State& state)
+{
+    GridGraph original;
+    auto queries = prepareMap(state, original);
+
+    double hit_rate = 0, subpath_hits = 0, revalidated = 0, invalidated = 0, saved = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        GridGraph graph = original;
+        PathCache cache;
+        state.ResumeTiming();
+        for (const CacheQuery& query : queries)
+        {
+            if (query.edit >= 0) setCellOdds(query.edit, 127, graph);
+            auto path = cache.findPath(graph, query.start, query.goal);
+            benchmark::DoNotOptimize(path.data());
+        }
+        hit_rate = cache.hitRate();
+        subpath_hits = cache.subpathHits();
+        revalidated = cache.revalidated();
+        invalidated = cache.invalidated();
+        saved = cache.savedSeconds();
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    state.counters["hit_rate"] = hit_rate;
+    state.counters["subpath_hits"] = subpath_hits;
+    state.counters["revalidated"] = revalidated;
+    state.counters["invalidated"] = invalidated;
+    state.counters["saved_ms"] = saved * 1000;
+}
+BENCHMARK(BM_PathCache)->Apply(pathCacheArgs);
+
+static void BM_PathCacheUncached(benchmark::State& state)
+{
+    GridGraph original;
+    auto queries = prepareMap(state, original);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        GridGraph graph = original;
+        state.ResumeTiming();
+        for (const CacheQuery& query : queries)
+        {
+            if (query.edit >= 0) setCellOdds(query.edit, 127, graph);
+            auto result = weightedAStarSearch(graph, query.start, query.goal, 1);
+            benchmark::DoNotOptimize(result.path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PathCacheUncached)->Apply(pathCacheArgs);
@@ -0,0 +1,100 @@
+/**
+ * Benchmarks for the compressed path database: the offline build, and path
+ * extraction against aStarSearch() over the same start and goal pairs.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/path_database.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.1;
+static const int kNumQueries = 16;
+
+/**
+ * The build runs a search from every free cell, so it is quadratic in the
+ * number of cells and only small maps are benchmarked.
+ */
+static void databaseSizes(benchmark::internal::Benchmark* b)
+{
+    b->Arg(64)->Arg(128);
+}
+
+/**
+ * Generates a synthetic map with its C-space and random collision free
+ * start and goal pairs.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    computeCSpace(graph);
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    std::vector<std::pair<Cell, Cell>> queries;
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+static void BM_PathDatabaseBuild_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    prepareMap(state, graph);
+    PathDatabase db;
+    for (auto _ : state)
+    {
+        buildPathDatabase(graph, db);
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+    state.counters["free_cells"] = db.rank_cells.size();
+    state.counters["runs"] = db.runs.size();
+    state.counters["bytes"] = pathDatabaseBytes(db);
+    state.counters["bytes_per_free_cell"] = static_cast<double>(pathDatabaseBytes(db)) / db.rank_cells.size();
+}
+BENCHMARK(BM_PathDatabaseBuild_Synthetic)->Apply(databaseSizes)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_PathDatabaseQuery_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    PathDatabase db;
+    buildPathDatabase(graph, db);
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            auto path = pathDatabasePath(db, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PathDatabaseQuery_Synthetic)->Apply(databaseSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_PathDatabaseAStarQuery_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            auto path = aStarSearch(graph, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(BM_PathDatabaseAStarQuery_Synthetic)->Apply(databaseSizes)->Unit(benchmark::kMicrosecond);
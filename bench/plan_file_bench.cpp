@@ -0,0 +1,109 @@
+/**
+ * Benchmarks for writing plan files in each output mode, against the
+ * std::to_string() writer generatePlanFile() used to be.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/viz_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/distance_transform.h>
+
+#include "bench_utils.h"
+
+static const char* kPlanFile = "bench.planner";
+static const int kMaxPlanFileSize = 2048;
+
+/**
+ * The output modes benchmarked, see parsePlanFileMode().
+ */
+static const std::vector<std::string> kPlanFileModes = {"full", "compact", "hash", "path"};
+
+/**
+ * Prepares a random obstacle map with its distance transform, a path along
+ * its diagonal and as many visited cells as a search would leave.
+ */
+static std::vector<Cell> prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), 0.1, 0, graph);
+    distanceTransformEuclidean2D(graph);
+    std::vector<Cell> path;
+    for (int k = 0; k < graph.width; ++k) path.push_back({k, k});
+    for (int idx = 0; idx < graph.width * graph.height; idx += 4) graph.visited_cells.push_back(idxToCell(idx, graph));
+    return path;
+}
+
+/**
+ * The previous plan file writer, kept as a baseline.
+ */
+static void writeLegacyPlanFile(const std::vector<Cell>& path, GridGraph& graph)
+{
+    std::ofstream outfile(kPlanFile);
+    outfile << "{ \"path\" : [";
+    for (size_t k = 0; k < path.size(); ++k)
+    {
+        outfile << "[" + std::to_string(path[k].i) + "," + std::to_string(path[k].j) + "]";
+        if (k != path.size() - 1) outfile << ",";
+    }
+    outfile << "], \"visited_cells\":[";
+    for (size_t k = 0; k < graph.visited_cells.size(); ++k)
+    {
+        outfile << "[" + std::to_string(graph.visited_cells[k].i) + "," + std::to_string(graph.visited_cells[k].j) + "]";
+        if (k != graph.visited_cells.size() - 1) outfile << ",";
+    }
+    outfile << "], \"dt\":[";
+    for (size_t k = 0; k < graph.obstacle_distances.size(); ++k)
+    {
+        outfile << std::to_string(graph.obstacle_distances[k]);
+        if (k != graph.obstacle_distances.size() - 1) outfile << ",";
+    }
+    outfile << "], \"map\": \"" << mapAsString(graph) << "\"";
+    outfile << ", \"start\": [0,0], \"goal\": [0,0], \"planning_algo\": \"\"}";
+}
+
+static void BM_PlanFileLegacy(benchmark::State& state)
+{
+    GridGraph graph;
+    auto path = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        writeLegacyPlanFile(path, graph);
+    }
+    setTimePerCell(state, graph.width * graph.height);
+    std::remove(kPlanFile);
+}
+BENCHMARK(BM_PlanFileLegacy)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPlanFileSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void runPlanFile(benchmark::State& state, const std::string& mode)
+{
+    GridGraph graph;
+    auto path = prepareMap(state, graph);
+    PlanFileOptions options;
+    parsePlanFileMode(mode, options);
+    for (auto _ : state)
+    {
+        generatePlanFile({0, 0}, {0, 0}, path, graph, "", kPlanFile, options);
+    }
+    setTimePerCell(state, graph.width * graph.height);
+    std::ifstream written(kPlanFile, std::ios::binary | std::ios::ate);
+    state.counters["bytes"] = static_cast<double>(written.tellg());
+    std::remove(kPlanFile);
+}
+
+static int registerPlanFileBenchmarks()
+{
+    for (const std::string& mode : kPlanFileModes)
+    {
+        benchmark::RegisterBenchmark(("BM_PlanFile/" + mode).c_str(), runPlanFile, mode)
+            ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxPlanFileSize); })
+            ->Unit(benchmark::kMillisecond);
+    }
+    return 0;
+}
+static int reg_plan_file = registerPlanFileBenchmarks();
@@ -0,0 +1,279 @@
+/**
+ * Benchmarks for the distance transforms, collision checks, neighbor lookup
+ * and graph searches. Each benchmark runs over the maps in data/ and most also
+ * run over synthetic maps from 256x256 up to 8192x8192.
+ *
+ * To record results that can be compared between commits:
+ *
+ *   ./planner_bench --benchmark_out=bench.json --benchmark_out_format=json
+ *   python3 scripts/compare_bench.py old.json new.json
+ */
+#include <vector>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/distance_transform.h>
+
+#include "bench_utils.h"
+
+// The brute force transforms are quadratic in the number of cells, so they only
+// run over the data maps. The Euclidean transform is cubic in the side length
+// and is capped at 1024x1024.
+static const int kMaxEuclideanSize = 1024;
+
+// Fraction of a synthetic map covered by obstacles.
+static const float kSyntheticDensity = 0.1;
+
+using SearchFn = std::vector<Cell> (*)(GridGraph&, const Cell&, const Cell&);
+
+/**
+ * Runs a distance transform over a graph, reporting the time per cell.
+ */
+static void runTransform(benchmark::State& state, GridGraph& graph, void (*transform)(GridGraph&))
+{
+    for (auto _ : state)
+    {
+        transform(graph);
+        benchmark::DoNotOptimize(graph.obstacle_distances.data());
+        benchmark::ClobberMemory();
+    }
+    setTimePerCell(state, graph.width * graph.height);
+}
+
+/**
+ * Runs a search between the given cells, reporting expansions and calls to
+ * checkCollision().
+ */
+static void runSearch(benchmark::State& state, GridGraph& graph, SearchFn search,
+                      const Cell& start, const Cell& goal)
+{
+    double expansions = 0;
+    graph.collision_checks = 0;
+    for (auto _ : state)
+    {
+        graph.visited_cells.clear();
+        auto path = search(graph, start, goal);
+        benchmark::DoNotOptimize(path.data());
+        expansions += graph.visited_cells.size();
+    }
+    setExpansions(state, expansions);
+    state.counters["collision_checks"] = benchmark::Counter(graph.collision_checks, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * Runs a search between opposite corners of the graph.
+ */
+static void runCornerSearch(benchmark::State& state, GridGraph& graph, SearchFn search)
+{
+    Cell start = findFreeCell(graph);
+    Cell goal = findFreeCell(graph, true);
+    if (start.i < 0 || goal.i < 0)
+    {
+        state.SkipWithError("No free cells in map.");
+        return;
+    }
+    runSearch(state, graph, search, start, goal);
+}
+
+/**
+ * Applies a per-cell operation to every cell in the graph, reporting the time per cell.
+ */
+template <class Op>
+static void runPerCell(benchmark::State& state, const GridGraph& graph, Op op)
+{
+    int num_cells = graph.width * graph.height;
+    for (auto _ : state)
+    {
+        for (int idx = 0; idx < num_cells; ++idx)
+        {
+            benchmark::DoNotOptimize(op(idx, graph));
+        }
+    }
+    setTimePerCell(state, num_cells);
+}
+
+/**
+ * Loads a data map for a benchmark, flagging an error if it fails.
+ */
+static bool loadForBenchmark(benchmark::State& state, const std::string& map, GridGraph& graph)
+{
+    if (!loadDataMap(map, graph))
+    {
+        state.SkipWithError(("Failed to load map " + map).c_str());
+        return false;
+    }
+    return true;
+}
+
+/* Distance transforms. */
+
+static void BM_DistanceTransformSlow(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (loadForBenchmark(state, map, graph)) runTransform(state, graph, distanceTransformSlow);
+}
+static int reg_dt_slow = registerDataMapBenchmarks("BM_DistanceTransformSlow", BM_DistanceTransformSlow);
+
+static void BM_DistanceTransformManhattan(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (loadForBenchmark(state, map, graph)) runTransform(state, graph, distanceTransformManhattan);
+}
+static int reg_dt_manhattan = registerDataMapBenchmarks("BM_DistanceTransformManhattan", BM_DistanceTransformManhattan);
+
+static void BM_DistanceTransformEuclidean2D(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (loadForBenchmark(state, map, graph)) runTransform(state, graph, distanceTransformEuclidean2D);
+}
+static int reg_dt_euclidean = registerDataMapBenchmarks("BM_DistanceTransformEuclidean2D", BM_DistanceTransformEuclidean2D);
+
+static void BM_DistanceTransformEuclidean2D_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kSyntheticDensity, 0, graph);
+    runTransform(state, graph, distanceTransformEuclidean2D);
+}
+BENCHMARK(BM_DistanceTransformEuclidean2D_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxEuclideanSize); })
+    ->Unit(benchmark::kMillisecond);
+
+/* Collision checks and neighbors. */
+
+static void BM_CheckCollision(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (loadForBenchmark(state, map, graph)) runPerCell(state, graph, checkCollision);
+}
+static int reg_collision = registerDataMapBenchmarks("BM_CheckCollision", BM_CheckCollision);
+
+static void BM_CheckCollision_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kSyntheticDensity, 0, graph);
+    runPerCell(state, graph, checkCollision);
+}
+BENCHMARK(BM_CheckCollision_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CheckCollisionFast(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (!loadForBenchmark(state, map, graph)) return;
+    distanceTransformEuclidean2D(graph);
+    runPerCell(state, graph, checkCollisionFast);
+}
+static int reg_collision_fast = registerDataMapBenchmarks("BM_CheckCollisionFast", BM_CheckCollisionFast);
+
+// The lookup cost does not depend on the distance values, so the synthetic maps
+// skip the (cubic) distance transform.
+static void BM_CheckCollisionFast_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kSyntheticDensity, 0, graph);
+    runPerCell(state, graph, checkCollisionFast);
+}
+BENCHMARK(BM_CheckCollisionFast_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_FindNeighbors(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (loadForBenchmark(state, map, graph)) runPerCell(state, graph, findNeighbors);
+}
+static int reg_neighbors = registerDataMapBenchmarks("BM_FindNeighbors", BM_FindNeighbors);
+
+static void BM_FindNeighbors_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    generateRandomObstacleMap(state.range(0), state.range(0), kSyntheticDensity, 0, graph);
+    runPerCell(state, graph, findNeighbors);
+}
+BENCHMARK(BM_FindNeighbors_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond);
+
+/* Searches. */
+
+static void configureSearch(benchmark::internal::Benchmark* b)
+{
+    b->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+#define PLANNER_SEARCH_BENCHMARKS(NAME, FN)                                         \
+    static void BM_##NAME(benchmark::State& state, const std::string& map)         \
+    {                                                                              \
+        GridGraph graph;                                                           \
+        if (loadForBenchmark(state, map, graph)) runCornerSearch(state, graph, FN); \
+    }                                                                              \
+    static int reg_##NAME = registerDataMapBenchmarks("BM_" #NAME, BM_##NAME, configureSearch); \
+    static void BM_##NAME##_Synthetic(benchmark::State& state)                     \
+    {                                                                              \
+        GridGraph graph;                                                           \
+        generateRandomObstacleMap(state.range(0), state.range(0), kSyntheticDensity, 0, graph);             \
+        runCornerSearch(state, graph, FN);                                         \
+    }                                                                              \
+    BENCHMARK(BM_##NAME##_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { \
+        syntheticSizes(b);                                                         \
+        configureSearch(b);                                                        \
+    });
+
+PLANNER_SEARCH_BENCHMARKS(BreadthFirstSearch, breadthFirstSearch)
+PLANNER_SEARCH_BENCHMARKS(DepthFirstSearch, depthFirstSearch)
+PLANNER_SEARCH_BENCHMARKS(AStarSearch, aStarSearch)
+
+// Iterative deepening repeats a recursive search for every depth, so it only
+// runs over the data maps with a goal a few cells away from the start.
+static void BM_IterativeDeepeningSearch(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    if (!loadForBenchmark(state, map, graph)) return;
+    Cell start = findFreeCell(graph);
+    if (start.i < 0)
+    {
+        state.SkipWithError("No free cells in map.");
+        return;
+    }
+    Cell goal = {std::min(start.i + 8, graph.width - 1), std::min(start.j + 8, graph.height - 1)};
+    runSearch(state, graph, iterativeDeepeningSearch, start, goal);
+}
+static int reg_ids = registerDataMapBenchmarks("BM_IterativeDeepeningSearch", BM_IterativeDeepeningSearch,
+                                               configureSearch);
+
+/* Collision modes. */
+
+static const float kClutteredDensity = 0.15;
+
+/**
+ * Runs each search over cluttered synthetic maps in every collision mode.
+ * The C-space for precomputed mode is built before timing starts.
+ */
+static void collisionModeArgs(benchmark::internal::Benchmark* b)
+{
+    for (int size : {256, 512})
+    {
+        for (int mode : {COLLISION_EAGER, COLLISION_LAZY, COLLISION_PRECOMPUTED}) b->Args({size, mode});
+    }
+    b->ArgNames({"size", "mode"});
+    configureSearch(b);
+}
+
+#define COLLISION_MODE_BENCHMARKS(NAME, FN)                                         \
+    static void BM_##NAME##_CollisionModes(benchmark::State& state)                \
+    {                                                                              \
+        GridGraph graph;                                                           \
+        generateRandomObstacleMap(state.range(0), state.range(0), kClutteredDensity, 0, graph); \
+        graph.collision_mode = state.range(1);                                     \
+        if (graph.collision_mode == COLLISION_PRECOMPUTED) getCSpaceBits(graph);   \
+        runCornerSearch(state, graph, FN);                                         \
+    }                                                                              \
+    BENCHMARK(BM_##NAME##_CollisionModes)->Apply(collisionModeArgs);
+
+COLLISION_MODE_BENCHMARKS(BreadthFirstSearch, breadthFirstSearch)
+COLLISION_MODE_BENCHMARKS(DepthFirstSearch, depthFirstSearch)
+COLLISION_MODE_BENCHMARKS(AStarSearch, aStarSearch)
+
+BENCHMARK_MAIN();
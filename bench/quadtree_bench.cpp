@@ -0,0 +1,147 @@
+/**
+ * Benchmarks for quadtree search against aStarSearch() and a full resolution
+ * search of the C-space, over the same start and goal pairs.
+ */
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/map_pyramid.h>
+#include <path_planning/graph_search/quadtree.h>
+
+#include "bench_utils.h"
+
+static const int kNumRooms = 12;
+static const int kCorridorWidth = 16;
+static const int kNumQueries = 16;
+static const int kMaxQuadtreeSize = 2048;  // Computing the C-space of larger maps takes too long.
+
+/**
+ * Prepares a map with its C-space and random collision free start and goal
+ * pairs. Synthetic maps are rooms joined by corridors, which are mostly open.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph,
+                                                     const std::string& map = "")
+{
+    if (map.empty())
+    {
+        generateRoomsMap(state.range(0), state.range(0), kNumRooms, kCorridorWidth, 0, graph);
+    }
+    else
+    {
+        loadDataMap(map, graph);
+    }
+    computeCSpace(graph);
+    std::vector<std::pair<Cell, Cell>> queries;
+    if (std::count(graph.cspace.begin(), graph.cspace.end(), 0) == 0) return queries;
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+static void runQuadtreeQueries(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+    QuadtreeMap quadtree;
+    buildQuadtree(graph, quadtree);
+
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            QuadtreeSearchStats stats;
+            auto path = quadtreeSearch(graph, quadtree, query.first, query.second, &stats);
+            benchmark::DoNotOptimize(path.data());
+            expanded += stats.leaves_expanded;
+            graph.visited_cells.clear();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, queries.empty() ? 0 : expanded / queries.size());
+    state.counters["leaves"] = quadtree.leaves.size();
+    state.counters["build_ms"] = 1000 * quadtree.build_seconds;
+    state.counters["quadtree_bytes"] = quadtreeBytes(quadtree);
+}
+
+static void runFullResolutionQueries(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+    MapPyramid full_resolution;
+    buildMapPyramid(graph, full_resolution, 0);
+
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            PyramidSearchStats stats;
+            auto path = pyramidSearch(graph, full_resolution, query.first, query.second, &stats);
+            benchmark::DoNotOptimize(path.data());
+            expanded += stats.expanded;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, queries.empty() ? 0 : expanded / queries.size());
+}
+
+static void runAStarQueries(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            graph.visited_cells.clear();
+            auto path = aStarSearch(graph, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+            expanded += graph.visited_cells.size();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, queries.empty() ? 0 : expanded / queries.size());
+}
+
+static void BM_QuadtreeQuery_Synthetic(benchmark::State& state)
+{
+    runQuadtreeQueries(state, "");
+}
+BENCHMARK(BM_QuadtreeQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxQuadtreeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_QuadtreeFullResolutionQuery_Synthetic(benchmark::State& state)
+{
+    runFullResolutionQueries(state, "");
+}
+BENCHMARK(BM_QuadtreeFullResolutionQuery_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxQuadtreeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_QuadtreeAStarQuery_Synthetic(benchmark::State& state)
+{
+    runAStarQueries(state, "");
+}
+BENCHMARK(BM_QuadtreeAStarQuery_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxQuadtreeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static int reg_quadtree = registerDataMapBenchmarks("BM_QuadtreeQuery", runQuadtreeQueries);
+static int reg_full_resolution = registerDataMapBenchmarks("BM_QuadtreeFullResolutionQuery", runFullResolutionQueries);
+static int reg_astar = registerDataMapBenchmarks("BM_QuadtreeAStarQuery", runAStarQueries);
@@ -0,0 +1,235 @@
+/**
+ * Benchmarks for the graphs of planning_in_michigan: loading synthetic DIMACS
+ * road networks of up to a million intersections, loading named graph files
+ * against the linear name lookup createGraph() used to do, and the latency of
+ * single queries with each search.
+ */
+#include <queue>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <benchmark/benchmark.h>
+
+#include <planning.h>
+
+#include "bench_utils.h"
+#include "road_graph_utils.h"
+
+static const char* kNamedGraphFile = "bench_named.graph";
+
+/**
+ * Writes a named graph file of the given size: a path through every node plus
+ * three more edges per node to random nodes.
+ */
+static void writeNamedGraph(int num_nodes)
+{
+    std::ofstream out(kNamedGraphFile);
+    std::mt19937 gen(num_nodes);
+    std::uniform_int_distribution<int> node(0, num_nodes - 1);
+    std::uniform_int_distribution<int> cost(1, 100);
+    out << "NODES " << num_nodes << "\n";
+    for (int n = 0; n < num_nodes; ++n) out << "city_" << n << "\n";
+    out << "EDGES " << 4 * (num_nodes - 1) << "\n";
+    for (int n = 1; n < num_nodes; ++n)
+    {
+        out << "city_" << n - 1 << " city_" << n << " " << cost(gen) << "\n";
+        for (int k = 0; k < 3; ++k) out << "city_" << n << " city_" << node(gen) << " " << cost(gen) << "\n";
+    }
+}
+
+/**
+ * The linear name lookup the previous loader used for every edge.
+ */
+static int legacyNameToIdx(const std::string& name, const std::vector<std::string>& v)
+{
+    for (size_t i = 0; i < v.size(); i++)
+    {
+        if (v[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/**
+ * The previous named graph loader, kept as a baseline.
+ */
+static void loadLegacyGraph(std::vector<std::string>& data, std::vector<std::vector<int> >& edges,
+                            std::vector<std::vector<float> >& edge_costs)
+{
+    std::ifstream in(kNamedGraphFile);
+    std::string s = "";
+    int N = 0;
+    while (s != "NODES") in >> s >> N;
+    for (int i = 0; i < N; i++)
+    {
+        in >> s;
+        data.push_back(s);
+    }
+    edges = std::vector<std::vector<int> >(N, std::vector<int>());
+    edge_costs = std::vector<std::vector<float> >(N, std::vector<float>());
+    while (s != "EDGES") in >> s >> N;
+    std::string city1, city2;
+    float dist;
+    for (int i = 0; i < N; i++)
+    {
+        in >> city1 >> city2 >> dist;
+        int c1 = legacyNameToIdx(city1, data);
+        int c2 = legacyNameToIdx(city2, data);
+        edges[c1].push_back(c2);
+        edges[c2].push_back(c1);
+        edge_costs[c1].push_back(dist);
+        edge_costs[c2].push_back(dist);
+    }
+}
+
+static void BM_NamedGraphLoadLegacy(benchmark::State& state)
+{
+    writeNamedGraph(state.range(0));
+    for (auto _ : state)
+    {
+        std::vector<std::string> data;
+        std::vector<std::vector<int> > edges;
+        std::vector<std::vector<float> > edge_costs;
+        loadLegacyGraph(data, edges, edge_costs);
+        benchmark::DoNotOptimize(edges.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * (state.range(0) - 1));
+    std::remove(kNamedGraphFile);
+}
+BENCHMARK(BM_NamedGraphLoadLegacy)->RangeMultiplier(4)->Range(1024, 16384)->Unit(benchmark::kMillisecond);
+
+static void BM_NamedGraphLoad(benchmark::State& state)
+{
+    writeNamedGraph(state.range(0));
+    for (auto _ : state)
+    {
+        Graph g = createGraph(kNamedGraphFile);
+        benchmark::DoNotOptimize(g.arcs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * (state.range(0) - 1));
+    std::remove(kNamedGraphFile);
+}
+BENCHMARK(BM_NamedGraphLoad)->RangeMultiplier(4)->Range(1024, 16384)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loads a synthetic road network with, and optionally without, coordinates.
+ * Items are arcs.
+ */
+static void BM_RoadGraphLoad(benchmark::State& state)
+{
+    const RoadGraphFiles& files = roadGraphFiles(state.range(0));
+    bool coordinates = state.range(1);
+    size_t num_arcs = 0;
+    for (auto _ : state)
+    {
+        Graph g = createGraphFromDimacs(files.gr_path, coordinates ? files.co_path : "");
+        num_arcs = g.arcs.size();
+        benchmark::DoNotOptimize(g.arcs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_arcs);
+    state.counters["nodes"] = static_cast<double>(state.range(0)) * state.range(0);
+    state.counters["arcs"] = num_arcs;
+}
+BENCHMARK(BM_RoadGraphLoad)->Apply([](benchmark::internal::Benchmark* b)
+    {
+        for (int side = 256; side <= 1024; side *= 2)
+        {
+            for (int coordinates : {0, 1}) b->Args({side, coordinates});
+        }
+        b->ArgNames({"side", "coordinates"})->Unit(benchmark::kMillisecond);
+    });
+
+static const int kNumRoadQueries = 64;
+
+/**
+ * The previous bfs() loop, which copied the neighbors of a node for every
+ * neighbor it visited, kept as a baseline.
+ */
+static std::vector<int> bfsCopyingNeighbors(int start, int goal, Graph& g)
+{
+    initGraph(g);
+    std::queue<int> visit_queue;
+    g.nodes[start].cost = 0;
+    visit_queue.push(start);
+    while (!visit_queue.empty())
+    {
+        int current = visit_queue.front();
+        visit_queue.pop();
+        if (current == goal) return tracePath(goal, g);
+        for (size_t i = 0; i < getNeighbors(current, g).size(); i++)
+        {
+            int neighbor = getNeighbors(current, g)[i];
+            float new_cost = g.nodes[current].cost + getEdgeCosts(current, g)[i];
+            if (new_cost < g.nodes[neighbor].cost)
+            {
+                g.nodes[neighbor].cost = new_cost;
+                g.nodes[neighbor].parent = current;
+                visit_queue.push(neighbor);
+            }
+        }
+    }
+    return {};
+}
+
+/**
+ * Times single queries between random nodes of a road network, one query
+ * per iteration. The search returns the nodes it expanded, or zero if it
+ * does not count them.
+ */
+template <typename Search>
+static void runRoadGraphQueries(benchmark::State& state, Search search)
+{
+    Graph& g = loadRoadGraph(state.range(0));
+    auto queries = roadGraphQueries(g, kNumRoadQueries);
+    size_t k = 0;
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        const auto& query = queries[k++ % queries.size()];
+        expanded += search(query.first, query.second, g);
+    }
+    if (expanded > 0) setExpansions(state, expanded);
+}
+
+static void BM_RoadGraphBfsCopying(benchmark::State& state)
+{
+    runRoadGraphQueries(state, [](int start, int goal, Graph& g)
+    {
+        benchmark::DoNotOptimize(bfsCopyingNeighbors(start, goal, g).data());
+        return 0;
+    });
+}
+BENCHMARK(BM_RoadGraphBfsCopying)->Apply([](benchmark::internal::Benchmark* b) { roadGraphSizes(b, 256); });
+
+static void BM_RoadGraphBfs(benchmark::State& state)
+{
+    runRoadGraphQueries(state, [](int start, int goal, Graph& g)
+    {
+        benchmark::DoNotOptimize(bfs(start, goal, g).data());
+        return 0;
+    });
+}
+BENCHMARK(BM_RoadGraphBfs)->Apply([](benchmark::internal::Benchmark* b) { roadGraphSizes(b, 256); });
+
+static void BM_RoadGraphDijkstra(benchmark::State& state)
+{
+    GraphSearchState search;
+    runRoadGraphQueries(state, [&](int start, int goal, Graph& g)
+    {
+        benchmark::DoNotOptimize(dijkstra(start, goal, g, search).data());
+        return search.expanded;
+    });
+}
+BENCHMARK(BM_RoadGraphDijkstra)->Apply([](benchmark::internal::Benchmark* b) { roadGraphSizes(b); });
+
+static void BM_RoadGraphAStar(benchmark::State& state)
+{
+    GraphSearchState search;
+    runRoadGraphQueries(state, [&](int start, int goal, Graph& g)
+    {
+        benchmark::DoNotOptimize(aStar(start, goal, g, search).data());
+        return search.expanded;
+    });
+}
+BENCHMARK(BM_RoadGraphAStar)->Apply([](benchmark::internal::Benchmark* b) { roadGraphSizes(b); });
@@ -0,0 +1,56 @@
+#ifndef PATH_PLANNING_BENCH_ROAD_GRAPH_UTILS_H
+#define PATH_PLANNING_BENCH_ROAD_GRAPH_UTILS_H
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <planning.h>
+
+#include "bench_utils.h"
+
+/**
+ * Loads the synthetic road network of the given size with its coordinates,
+ * see roadGraphFiles(). Networks are loaded once and shared, so callers must
+ * not change the arcs.
+ * @param  side The number of intersections along each side.
+ * @param  hierarchy Whether the network has arterials and highways.
+ * @return  The network.
+ */
+static inline Graph& loadRoadGraph(int side, bool hierarchy = false)
+{
+    static std::map<std::pair<int, bool>, Graph> loaded;
+    auto key = std::make_pair(side, hierarchy);
+    auto it = loaded.find(key);
+    if (it == loaded.end())
+    {
+        const RoadGraphFiles& files = roadGraphFiles(side, hierarchy);
+        it = loaded.emplace(key, createGraphFromDimacs(files.gr_path, files.co_path)).first;
+    }
+    return it->second;
+}
+
+/**
+ * Picks random (start, goal) pairs of nodes, the same ones for every
+ * benchmark on a graph of that size.
+ */
+static inline std::vector<std::pair<int, int> > roadGraphQueries(const Graph& g, int num_queries)
+{
+    std::mt19937 gen(numNodes(g));
+    std::uniform_int_distribution<int> node(0, numNodes(g) - 1);
+    std::vector<std::pair<int, int> > queries;
+    for (int k = 0; k < num_queries; ++k) queries.push_back({node(gen), node(gen)});
+    return queries;
+}
+
+/**
+ * Sets the road network sizes, from 256x256 up to the given side.
+ */
+static inline void roadGraphSizes(benchmark::internal::Benchmark* b, int max_side = 1024)
+{
+    for (int side = 256; side <= max_side; side *= 2) b->Arg(side);
+    b->ArgName("side")->Unit(benchmark::kMillisecond);
+}
+
+#endif  // PATH_PLANNING_BENCH_ROAD_GRAPH_UTILS_H
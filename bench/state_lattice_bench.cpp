@@ -0,0 +1,166 @@
+/**
+ * Benchmarks for state lattice search, with and without the heuristic table
+ * and the grid heuristic, against aStarSearch() over the same start and goal
+ * pairs.
+ */
+#include <random>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/state_lattice.h>
+
+#include "bench_utils.h"
+
+static const int kNumRooms = 12;
+static const int kCorridorWidth = 16;
+static const int kNumQueries = 8;
+static const int kMaxLatticeSize = 512;
+
+/**
+ * Prepares a map with its C-space and random collision free start and goal
+ * pairs. Synthetic maps are rooms joined by corridors.
+ */
+static std::vector<std::pair<Cell, Cell>> prepareMap(benchmark::State& state, GridGraph& graph, const std::string& map)
+{
+    if (map.empty())
+    {
+        generateRoomsMap(state.range(0), state.range(0), kNumRooms, kCorridorWidth, 0, graph);
+    }
+    else
+    {
+        loadDataMap(map, graph);
+    }
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    getCSpaceBits(graph);
+    std::vector<std::pair<Cell, Cell>> queries;
+    if (std::count(graph.cspace.begin(), graph.cspace.end(), 0) == 0) return queries;
+
+    std::mt19937 gen(0);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    auto freeCell = [&]()
+    {
+        int idx = pos(gen);
+        while (graph.cspace[idx]) idx = pos(gen);
+        return idxToCell(idx, graph);
+    };
+    while (queries.size() < kNumQueries) queries.push_back({freeCell(), freeCell()});
+    return queries;
+}
+
+static void runLatticeQueries(benchmark::State& state, const std::string& map, int heuristic_radius,
+                              bool grid_heuristic)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+    StateLattice lattice;
+    buildStateLattice(lattice, heuristic_radius);
+    lattice.grid_heuristic = grid_heuristic;
+
+    double expanded = 0, swept = 0, poses = 0;
+    for (auto _ : state)
+    {
+        poses = 0;
+        for (const auto& query : queries)
+        {
+            graph.visited_cells.clear();
+            LatticeSearchStats stats;
+            auto path = latticeSearch(graph, lattice, query.first, 0, query.second, &stats);
+            benchmark::DoNotOptimize(path.data());
+            expanded += stats.expanded;
+            swept += stats.swept_cells_checked;
+            poses += path.size();
+        }
+    }
+    double num_queries = queries.empty() ? 1 : queries.size();
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, expanded / num_queries);
+    state.counters["swept_cells_checked"] = benchmark::Counter(swept / num_queries, benchmark::Counter::kAvgIterations);
+    state.counters["poses"] = poses / num_queries;
+}
+
+static void runAStarQueries(benchmark::State& state, const std::string& map)
+{
+    GridGraph graph;
+    auto queries = prepareMap(state, graph, map);
+    double expanded = 0;
+    for (auto _ : state)
+    {
+        for (const auto& query : queries)
+        {
+            graph.visited_cells.clear();
+            auto path = aStarSearch(graph, query.first, query.second);
+            benchmark::DoNotOptimize(path.data());
+            expanded += graph.visited_cells.size();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    setExpansions(state, queries.empty() ? 0 : expanded / queries.size());
+}
+
+static void runLattice(benchmark::State& state, const std::string& map)
+{
+    runLatticeQueries(state, map, LATTICE_HEURISTIC_RADIUS, true);
+}
+
+static void runLatticeNoGrid(benchmark::State& state, const std::string& map)
+{
+    runLatticeQueries(state, map, LATTICE_HEURISTIC_RADIUS, false);
+}
+
+static void runLatticeEuclidean(benchmark::State& state, const std::string& map)
+{
+    runLatticeQueries(state, map, 0, false);
+}
+
+static void BM_Lattice_Synthetic(benchmark::State& state)
+{
+    runLattice(state, "");
+}
+BENCHMARK(BM_Lattice_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxLatticeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LatticeNoGrid_Synthetic(benchmark::State& state)
+{
+    runLatticeNoGrid(state, "");
+}
+BENCHMARK(BM_LatticeNoGrid_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxLatticeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LatticeEuclidean_Synthetic(benchmark::State& state)
+{
+    runLatticeEuclidean(state, "");
+}
+BENCHMARK(BM_LatticeEuclidean_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxLatticeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LatticeAStar_Synthetic(benchmark::State& state)
+{
+    runAStarQueries(state, "");
+}
+BENCHMARK(BM_LatticeAStar_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxLatticeSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LatticeBuild(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        StateLattice lattice;
+        buildStateLattice(lattice, state.range(0));
+        benchmark::DoNotOptimize(lattice.heuristic.data());
+    }
+}
+BENCHMARK(BM_LatticeBuild)->Arg(0)->Arg(LATTICE_HEURISTIC_RADIUS)->Unit(benchmark::kMillisecond);
+
+static auto kMilliseconds = [](benchmark::internal::Benchmark* b) { b->Unit(benchmark::kMillisecond); };
+static int reg_lattice = registerDataMapBenchmarks("BM_Lattice", runLattice, kMilliseconds);
+static int reg_lattice_no_grid = registerDataMapBenchmarks("BM_LatticeNoGrid", runLatticeNoGrid, kMilliseconds);
+static int reg_lattice_euclidean = registerDataMapBenchmarks("BM_LatticeEuclidean", runLatticeEuclidean, kMilliseconds);
+static int reg_astar = registerDataMapBenchmarks("BM_LatticeAStar", runAStarQueries, kMilliseconds);
@@ -0,0 +1,97 @@
+/**
+ * Benchmarks for the tiled, out-of-core grid. Each runs with a tile cache
+ * much smaller than the map and reports the cache counters.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/utils/tiled_grid.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/distance_transform.h>
+
+#include "bench_utils.h"
+
+static const int kTileSize = 256;
+static const size_t kCacheBytes = 16 << 20;
+
+/**
+ * Writes a generated binary map with a distance layer to the working directory
+ * and removes it when the object goes out of scope.
+ */
+struct TempBinaryMap
+{
+    explicit TempBinaryMap(int size) : path("planner_bench_tiled_" + std::to_string(size) + ".bin")
+    {
+        GridGraph graph;
+        generateRandomObstacleMap(size, size, 0.1, 0, graph);
+        start = findFreeCell(graph);
+        goal = findFreeCell(graph, true);
+        saveToBinaryFile(path, graph, true);
+    }
+    ~TempBinaryMap() { std::remove(path.c_str()); }
+
+    std::string path;
+    Cell start, goal;
+};
+
+/**
+ * Adds counters for the tile cache of a tiled graph.
+ */
+static void setTileCacheCounters(benchmark::State& state, const TiledGridGraph& graph)
+{
+    const TileCacheStats& stats = graph.stats();
+    state.counters["tile_hits"] = stats.hits;
+    state.counters["tile_misses"] = stats.misses;
+    state.counters["tile_evictions"] = stats.evictions;
+    state.counters["hit_rate"] = stats.hits / std::max(1.0, static_cast<double>(stats.hits + stats.misses));
+    state.counters["resident_bytes"] = graph.residentBytes();
+}
+
+static void BM_TiledAStarSearch_Synthetic(benchmark::State& state)
+{
+    TempBinaryMap map(state.range(0));
+    TiledGridGraph graph;
+    if (!graph.open(map.path, kTileSize, kCacheBytes))
+    {
+        state.SkipWithError("Failed to open tiled map.");
+        return;
+    }
+
+    double expansions = 0;
+    for (auto _ : state)
+    {
+        int64_t num_expanded = 0;
+        auto path = aStarSearch(graph, map.start, map.goal, &num_expanded);
+        benchmark::DoNotOptimize(path.data());
+        expansions += num_expanded;
+    }
+    setExpansions(state, expansions);
+    setTileCacheCounters(state, graph);
+}
+BENCHMARK(BM_TiledAStarSearch_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_TiledDistanceTransform_Synthetic(benchmark::State& state)
+{
+    TempBinaryMap map(state.range(0));
+    TiledGridGraph graph;
+    if (!graph.open(map.path, kTileSize, kCacheBytes, true))
+    {
+        state.SkipWithError("Failed to open tiled map.");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        distanceTransformEuclidean2D(graph, 16);
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+    setTileCacheCounters(state, graph);
+}
+BENCHMARK(BM_TiledDistanceTransform_Synthetic)->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b); })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
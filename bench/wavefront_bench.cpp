@@ -0,0 +1,104 @@
+/**
+ * Benchmarks for the bit-parallel wavefront, against a queue based breadth
+ * first search over the same C-space. The C-space is computed before timing.
+ */
+#include <queue>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/wavefront.h>
+
+#include "bench_utils.h"
+
+static const float kDensity = 0.1;
+static const int kMaxWavefrontSize = 2048;  // Computing the C-space of larger maps takes too long.
+
+/**
+ * Computes 8-connected hop distances with a queue, reading the C-space bytes.
+ */
+static std::vector<int> queueHopDistances(const GridGraph& graph, const Cell& start)
+{
+    std::vector<int> hops(graph.width * graph.height, -1);
+    std::queue<int> visit_queue;
+    int start_idx = cellToIdx(start.i, start.j, graph);
+    hops[start_idx] = 0;
+    visit_queue.push(start_idx);
+    while (!visit_queue.empty())
+    {
+        int current = visit_queue.front();
+        visit_queue.pop();
+        int i = current % graph.width, j = current / graph.width;
+        for (int dj = -1; dj <= 1; ++dj)
+        {
+            for (int di = -1; di <= 1; ++di)
+            {
+                if (!isCellInBounds(i + di, j + dj, graph)) continue;
+                int neighbor = current + di + dj * graph.width;
+                if (hops[neighbor] < 0 && !graph.cspace[neighbor])
+                {
+                    hops[neighbor] = hops[current] + 1;
+                    visit_queue.push(neighbor);
+                }
+            }
+        }
+    }
+    return hops;
+}
+
+/**
+ * Generates a synthetic map and its C-space.
+ */
+static Cell prepareMap(benchmark::State& state, GridGraph& graph)
+{
+    generateRandomObstacleMap(state.range(0), state.range(0), kDensity, 0, graph);
+    computeCSpace(graph);
+    return findFreeCell(graph);
+}
+
+static void BM_QueueHopDistances_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    Cell start = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        auto hops = queueHopDistances(graph, start);
+        benchmark::DoNotOptimize(hops.data());
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+}
+BENCHMARK(BM_QueueHopDistances_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxWavefrontSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_WavefrontHopDistances_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    Cell start = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        auto hops = wavefrontHopDistances(graph, start);
+        benchmark::DoNotOptimize(hops.data());
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+}
+BENCHMARK(BM_WavefrontHopDistances_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxWavefrontSize); })
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_WavefrontReachable_Synthetic(benchmark::State& state)
+{
+    GridGraph graph;
+    Cell start = prepareMap(state, graph);
+    for (auto _ : state)
+    {
+        auto reached = wavefrontReachable(graph, start);
+        benchmark::DoNotOptimize(reached.words.data());
+    }
+    setTimePerCell(state, static_cast<double>(graph.width) * graph.height);
+}
+BENCHMARK(BM_WavefrontReachable_Synthetic)
+    ->Apply([](benchmark::internal::Benchmark* b) { syntheticSizes(b, kMaxWavefrontSize); })
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,71 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_ANY_ANGLE_H
+#define PATH_PLANNING_GRAPH_SEARCH_ANY_ANGLE_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+/**
+ * Counters from an any-angle search.
+ */
+struct AnyAngleStats
+{
+    int64_t expanded = 0;               // Cells taken off the open set.
+    int64_t line_of_sight_checks = 0;   // Calls to lineOfSight().
+};
+
+/**
+ * Searches for an any-angle path with Theta*. The search moves between
+ * 8-connected neighbors like A*, but a cell whose parent's parent is in line
+ * of sight takes that cell as its parent instead, so the path is a short
+ * list of waypoints joined by straight segments. Costs are Euclidean
+ * distances, and cells in collision and line of sight are taken from
+ * graph.cspace_bits, which are computed first if needed.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @return  The waypoints from the start to the goal. Each pair of waypoints
+ *          is either in line of sight or 8-connected neighbors. Empty if the
+ *          goal is in collision or there is no path.
+ */
+std::vector<Cell> thetaStarSearch(GridGraph& graph, const Cell& start, const Cell& goal,
+                                  AnyAngleStats* stats = nullptr);
+
+/**
+ * Searches for an any-angle path with Lazy Theta*. Like thetaStarSearch(),
+ * but each cell assumes it can see its parent's parent when it is generated,
+ * and checks line of sight only once, when it is expanded. If the check
+ * fails, the cell takes the best of its expanded neighbors as its parent.
+ * This does far fewer line of sight checks for paths of similar length.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @return  The waypoints from the start to the goal, as for thetaStarSearch().
+ */
+std::vector<Cell> lazyThetaStarSearch(GridGraph& graph, const Cell& start, const Cell& goal,
+                                      AnyAngleStats* stats = nullptr);
+
+/**
+ * Shortens a path of cells to the waypoints where it has to turn. From each
+ * waypoint, the path is followed to the last cell still in line of sight,
+ * which becomes the next waypoint. This works on the path from any planner.
+ * Line of sight is taken from graph.cspace_bits, which are computed first if
+ * needed.
+ * @param[in, out]  graph The graph the path is on.
+ * @param  path The path to shorten, from the start to the goal.
+ * @param[out]  stats If not null, line_of_sight_checks is set to the number
+ *                    of checks made.
+ * @return  The waypoints, including the first and last cells of the path.
+ */
+std::vector<Cell> shortcutPath(GridGraph& graph, const std::vector<Cell>& path, AnyAngleStats* stats = nullptr);
+
+/**
+ * Finds the Euclidean length of a path in cells, following straight segments
+ * between its waypoints.
+ */
+float anyAnglePathLength(const std::vector<Cell>& path);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_ANY_ANGLE_H
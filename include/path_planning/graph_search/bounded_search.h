@@ -0,0 +1,51 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_BOUNDED_SEARCH_H
+#define PATH_PLANNING_GRAPH_SEARCH_BOUNDED_SEARCH_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+/**
+ * The result of a bounded suboptimal search.
+ */
+struct BoundedSearchResult
+{
+    std::vector<Cell> path;     // The cells from the start to the goal, empty if there is no path.
+    float cost = 0;             // The octile cost of the path.
+    float bound = 1;            // The path costs at most bound times the shortest path. Never more than w.
+    int64_t expanded = 0;       // Cells expanded, counting re-expansions.
+};
+
+/**
+ * Searches for a path with weighted A*, expanding cells in order of
+ * g + w * h, where h is the octile distance to the goal. Steps have octile
+ * costs, and cells in collision are skipped following graph.collision_mode.
+ * Cells are re-expanded when a cheaper path to them is found, so the lowest
+ * g + h left in the open set when the goal is reached is a lower bound on the
+ * shortest path, which often proves a bound well below w.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param  w The suboptimality bound, at least 1. With 1 this is A*.
+ * @return  The path, its cost and the proven bound on its suboptimality.
+ */
+BoundedSearchResult weightedAStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, float w);
+
+/**
+ * Searches for a path with focal search (A*epsilon). The open set is ordered
+ * by f = g + h. Of the open cells with f within w times the lowest f, the
+ * focal list, the one closest to the goal is expanded next. Steps have
+ * octile costs, and cells in collision are skipped following
+ * graph.collision_mode. The lowest f when the goal is taken from the focal
+ * list is a lower bound on the shortest path, which gives the proven bound.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param  w The suboptimality bound, at least 1. With 1 this is A* with ties
+ *           broken towards the goal.
+ * @return  The path, its cost and the proven bound on its suboptimality.
+ */
+BoundedSearchResult focalSearch(GridGraph& graph, const Cell& start, const Cell& goal, float w);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_BOUNDED_SEARCH_H
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/tiled_grid.h>
 
 /**
  * Updates obstacle distances in the graph using iteration over the full graph.
@@ -30,4 +31,19 @@ std::vector<float> distanceTransformEuclidean1D(std::vector<float>& init_dt);
  */
 void distanceTransformEuclidean2D(GridGraph& graph);
 
+/**
+ * Updates obstacle distances in a tiled graph according to euclidean distance,
+ * one tile at a time. Distances are exact up to max_distance cells and capped
+ * there, which only needs a margin of max_distance cells around each tile, so
+ * memory use is bounded by the tile size rather than the map size. Pick
+ * max_distance above the collision radius in cells.
+ *
+ * The graph must be writable and its file must have a distance layer, see
+ * addBinaryMapDistanceLayer(). Results are flushed to the file.
+ * @param[out]  graph The tiled graph to update.
+ * @param  max_distance The distance in cells to cap the transform at.
+ * @return  True if the transform was written, false otherwise.
+ */
+bool distanceTransformEuclidean2D(TiledGridGraph& graph, int max_distance);
+
 #endif  // PATH_PLANNING_GRAPH_SEARCH_DISTANCE_TRANSFORM_H
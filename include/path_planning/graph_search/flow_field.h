@@ -0,0 +1,88 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_FLOW_FIELD_H
+#define PATH_PLANNING_GRAPH_SEARCH_FLOW_FIELD_H
+
+#include <list>
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define FLOW_FIELD_GOAL         8       // Direction stored at the goal cell.
+#define FLOW_FIELD_UNREACHABLE  255     // Direction stored at cells with no path to the goal.
+
+/**
+ * The next step towards one goal from every cell of a map. Each cell stores
+ * the index in kNeighborSteps of the neighbor to move to, so the path from
+ * any start is found by following the directions.
+ */
+struct FlowField
+{
+    Cell goal = {-1, -1};
+    uint64_t map_version = 0;           // The map version the field was computed for.
+    int width = 0, height = 0;
+    std::vector<uint8_t> directions;    // One direction per cell, indexed like the graph.
+};
+
+/**
+ * Computes a flow field with a single Dijkstra search outwards from the goal,
+ * with octile step costs, avoiding cells in collision like the A* searches.
+ * The goal itself may be in collision. Uses graph.cspace_bits, computing the
+ * C-space first if it has not been.
+ * @param[in, out]  graph The graph to search over.
+ * @param  goal The goal cell.
+ * @param[out]  field The flow field to fill.
+ */
+void computeFlowField(GridGraph& graph, const Cell& goal, FlowField& field);
+
+/**
+ * Follows a flow field from a start cell to its goal.
+ * @param  field The flow field to follow.
+ * @param  start The start cell.
+ * @return  A list of cells from the start to the goal, or an empty list if
+ *          the goal cannot be reached from the start.
+ */
+std::vector<Cell> flowFieldPath(const FlowField& field, const Cell& start);
+
+/**
+ * Keeps the flow fields of the most recently used goals of a graph, so that
+ * many starts heading to the same few goals only search once per goal. All
+ * fields are dropped when the map version of the graph changes.
+ */
+class FlowFieldCache
+{
+public:
+    /**
+     * @param  max_fields The number of goals to keep fields for.
+     */
+    explicit FlowFieldCache(size_t max_fields = 8);
+
+    /**
+     * Gets the flow field for a goal, computing it if it is not cached or the
+     * map has changed since it was computed.
+     * @param[in, out]  graph The graph to search over.
+     * @param  goal The goal cell.
+     * @return  The flow field, valid until the next call.
+     */
+    const FlowField& getField(GridGraph& graph, const Cell& goal);
+
+    /**
+     * Finds a path from a start to a goal using the cached flow field.
+     * @param[in, out]  graph The graph to search over.
+     * @param  start The start cell.
+     * @param  goal The goal cell.
+     * @return  A list of cells from the start to the goal.
+     */
+    std::vector<Cell> findPath(GridGraph& graph, const Cell& start, const Cell& goal);
+
+    void clear() { fields_.clear(); }
+    size_t size() const { return fields_.size(); }
+    int64_t hits() const { return hits_; }
+    int64_t misses() const { return misses_; }
+
+private:
+    size_t max_fields_;
+    std::list<FlowField> fields_;       // Most recently used first.
+    int64_t hits_, misses_;
+};
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_FLOW_FIELD_H
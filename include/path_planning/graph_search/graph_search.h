@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/tiled_grid.h>
 
 /**
  * Searches over a graph for a path between two nodes using depth first search. 
@@ -41,4 +42,18 @@ std::vector<Cell> iterativeDeepeningSearch(GridGraph& graph, const Cell& start,
  */
 std::vector<Cell> aStarSearch(GridGraph& graph, const Cell& start, const Cell& goal);
 
+/**
+ * Searches over a tiled graph for a path between two nodes using A* search
+ * with octile edge costs, avoiding cells in collision. Search state is kept
+ * only for the cells the search reaches, so memory use is bounded by the
+ * explored region and the tile cache rather than the size of the map.
+ * @param[in, out]  graph The tiled graph to search over.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  num_expanded If not null, set to the number of nodes expanded.
+ * @return  A list of cells representing the path.
+ */
+std::vector<Cell> aStarSearch(TiledGridGraph& graph, const Cell& start, const Cell& goal,
+                              int64_t* num_expanded = nullptr);
+
 #endif  // PATH_PLANNING_GRAPH_SEARCH_GRAPH_SEARCH_H
@@ -0,0 +1,83 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_HPA_STAR_H
+#define PATH_PLANNING_GRAPH_SEARCH_HPA_STAR_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define HPA_DEFAULT_CLUSTER_SIZE    32
+#define HPA_MAX_SINGLE_ENTRANCE     6   // Entrances at least this wide get a transition at each end.
+
+/**
+ * An edge of the abstract graph.
+ */
+struct HpaEdge
+{
+    int to;         // The abstract node the edge leads to.
+    float cost;     // The octile cost of the shortest path along the edge.
+};
+
+/**
+ * The abstract graph used by hierarchical path finding (HPA*). The map is cut
+ * into square clusters. Where the free cells on either side of a cluster
+ * border line up, the pair of cells becomes two abstract nodes joined by a
+ * single step. Abstract nodes in the same cluster are joined by the cost of
+ * the shortest path between them that stays inside the cluster.
+ */
+struct HierarchicalGraph
+{
+    int cluster_size = 0;
+    int clusters_x = 0, clusters_y = 0;     // Number of clusters along each axis.
+    uint64_t map_version = 0;               // The map version the graph was built for.
+    double build_seconds = 0;               // How long building the graph took.
+
+    std::vector<int> node_cells;                    // The graph index of each abstract node's cell.
+    std::vector<std::vector<HpaEdge>> edges;        // The edges leaving each abstract node.
+    std::vector<std::vector<int>> cluster_nodes;    // The abstract nodes in each cluster.
+};
+
+/**
+ * Counters from a hierarchical search.
+ */
+struct HpaSearchStats
+{
+    int64_t abstract_expanded = 0;  // Nodes expanded in the abstract graph.
+    int64_t cell_expanded = 0;      // Cells expanded connecting the start and goal and refining the path.
+    bool fallback = false;          // Whether the abstract graph found no path and the full grid was searched.
+};
+
+/**
+ * Builds the abstract graph of a map. Cells in collision are avoided, using
+ * graph.cspace_bits, which are computed first if needed.
+ * @param[in, out]  graph The graph to build the abstraction of.
+ * @param  cluster_size The width of each cluster in cells.
+ * @param[out]  hpa The abstract graph to fill.
+ */
+void buildHierarchicalGraph(GridGraph& graph, int cluster_size, HierarchicalGraph& hpa);
+
+/**
+ * Estimates the memory used by an abstract graph in bytes.
+ */
+size_t hierarchicalGraphBytes(const HierarchicalGraph& hpa);
+
+/**
+ * Searches for a path with HPA*. The start and goal are connected to the
+ * abstract nodes of their clusters, the abstract graph is searched with A*,
+ * and only the clusters along the abstract path are searched at full
+ * resolution to turn it into cells. Steps have octile costs. Paths stay within
+ * a few percent of the optimal cost. If the abstract graph has no path, which
+ * can happen when clusters only touch diagonally, the full grid is searched.
+ * An abstract graph built for an older map version is rejected with no path,
+ * since its edges may cross cells that are now blocked.
+ * @param[in, out]  graph The graph to search over.
+ * @param  hpa The abstract graph, built for the current map version.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @return  A list of cells from the start to the goal.
+ */
+std::vector<Cell> hierarchicalSearch(GridGraph& graph, const HierarchicalGraph& hpa, const Cell& start,
+                                     const Cell& goal, HpaSearchStats* stats = nullptr);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_HPA_STAR_H
@@ -0,0 +1,84 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_MAP_PYRAMID_H
+#define PATH_PLANNING_GRAPH_SEARCH_MAP_PYRAMID_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define PYRAMID_DEFAULT_LEVELS      4   // Coarse levels at 2x, 4x, 8x and 16x.
+#define PYRAMID_CORRIDOR_RADIUS     1   // Coarse cells added around a coarse path to make a corridor.
+
+/**
+ * A pyramid of ever coarser copies of the C-space. Level 0 is the C-space at
+ * full resolution, and each cell of level k + 1 covers a 2x2 block of level k.
+ * Coarse cells are blocked if any cell they cover is, so a path through clear
+ * coarse cells always has a path through the cells they cover.
+ *
+ * The pyramid also keeps the scratch memory its searches use, so it must not
+ * be searched from more than one thread at a time.
+ */
+struct MapPyramid
+{
+    uint64_t map_version = 0;               // The map version the pyramid was built for.
+    int num_levels = PYRAMID_DEFAULT_LEVELS;  // The number of coarse levels requested.
+    std::vector<OccupancyBits> levels;      // The blocked cells of each level, finest first.
+
+    // Search scratch, indexed by cell index within a level. Entries are only
+    // valid where visits or corridor equal the stamp of the current search.
+    std::vector<float> costs;
+    std::vector<int> parents;
+    std::vector<uint32_t> visits, corridor;
+    uint32_t stamp = 0;
+};
+
+/**
+ * Counters from a pyramid search.
+ */
+struct PyramidSearchStats
+{
+    int coarse_level = 0;       // The level the first path was found at, 0 after a fallback.
+    int64_t expanded = 0;       // Cells expanded over all levels.
+    bool fallback = false;      // Whether a corridor had no path and the full grid was searched.
+};
+
+/**
+ * Builds the pyramid for a map. Cells in collision are taken from
+ * graph.cspace_bits, which are computed first if needed. Levels stop early
+ * once they are a single cell.
+ * @param[in, out]  graph The graph to build the pyramid of.
+ * @param[out]  pyramid The pyramid to fill.
+ * @param  num_levels The number of coarse levels above the full resolution.
+ */
+void buildMapPyramid(GridGraph& graph, MapPyramid& pyramid, int num_levels = PYRAMID_DEFAULT_LEVELS);
+
+/**
+ * Estimates the memory used by a pyramid's levels in bytes, not counting its
+ * search scratch.
+ */
+size_t mapPyramidBytes(const MapPyramid& pyramid);
+
+/**
+ * Searches for a path coarse to fine. A* with octile costs runs at the
+ * coarsest level that has a path, then at each finer level only within a
+ * corridor of the cells covered by the coarser path, grown by
+ * corridor_radius coarse cells. The cells holding the start and goal may be
+ * used at coarse levels even if they are blocked. If a corridor has no path,
+ * the full grid is searched instead, so a path is found whenever one exists.
+ * The path is usually close to, but not always, the shortest one. As with
+ * hierarchicalSearch(), the start may be in collision but the goal may not.
+ *
+ * The pyramid is rebuilt first if it was built for another map version.
+ * @param[in, out]  graph The graph to search over.
+ * @param[in, out]  pyramid The pyramid of the graph.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @param  corridor_radius How far to grow each coarse path, in coarse cells.
+ * @return  A list of cells from the start to the goal.
+ */
+std::vector<Cell> pyramidSearch(GridGraph& graph, MapPyramid& pyramid, const Cell& start, const Cell& goal,
+                                PyramidSearchStats* stats = nullptr,
+                                int corridor_radius = PYRAMID_CORRIDOR_RADIUS);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_MAP_PYRAMID_H
@@ -0,0 +1,42 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_MULTI_GOAL_SEARCH_H
+#define PATH_PLANNING_GRAPH_SEARCH_MULTI_GOAL_SEARCH_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define MULTI_GOAL_EXACT_HEURISTIC_GOALS    32  // Up to this many goals, the heuristic checks each one.
+
+/**
+ * The result of a multi-goal search.
+ */
+struct MultiGoalResult
+{
+    std::vector<Cell> path;     // The cells from the start to the nearest goal, empty if none is reachable.
+    int goal_index = -1;        // The index of the goal reached, or -1.
+    float cost = 0;             // The octile cost of the path plus the bias of the goal reached.
+    int64_t expanded = 0;       // Cells expanded.
+};
+
+/**
+ * Searches for the nearest of many goals in a single A* pass. Each goal may
+ * have a bias that is added to the cost of reaching it, so the goal with the
+ * lowest path cost plus bias is found. Steps have octile costs, and cells in
+ * collision are skipped following graph.collision_mode.
+ *
+ * The heuristic is the lowest octile distance plus bias over the goals. With
+ * more than MULTI_GOAL_EXACT_HEURISTIC_GOALS goals, it is the octile distance
+ * to the bounding box of the goals plus the lowest bias instead, which is
+ * cheaper and still admissible. With every bias at zero and a single goal
+ * this is A*.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goals The goal cells. Goals out of bounds are ignored.
+ * @param  biases The bias of each goal, at least zero. If empty, every bias is zero.
+ * @return  The path to the nearest goal, which goal it is, and its cost.
+ */
+MultiGoalResult multiGoalSearch(GridGraph& graph, const Cell& start, const std::vector<Cell>& goals,
+                                const std::vector<float>& biases = {});
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_MULTI_GOAL_SEARCH_H
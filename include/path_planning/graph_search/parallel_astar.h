@@ -0,0 +1,49 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_PARALLEL_ASTAR_H
+#define PATH_PLANNING_GRAPH_SEARCH_PARALLEL_ASTAR_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define PARALLEL_ASTAR_BLOCK_SIZE   8   // Cells in the same block of this many cells across belong to the same thread.
+#define PARALLEL_ASTAR_BATCH_SIZE   64  // Nodes a thread holds for another thread before sending them.
+
+/**
+ * The result of a parallel A* search.
+ */
+struct ParallelAStarResult
+{
+    std::vector<Cell> path;     // The cells from the start to the goal, empty if there is no path.
+    float cost = 0;             // The octile cost of the path.
+    int64_t expanded = 0;       // Cells expanded by all threads, counting cells expanded again.
+    int64_t reexpanded = 0;     // Expansions of cells that had been expanded before with a higher cost.
+    int64_t messages = 0;       // Nodes sent from one thread to another.
+    int num_threads = 0;        // The number of threads used.
+};
+
+/**
+ * Searches for a shortest path with hash distributed A* (HDA*). Every cell is
+ * owned by one thread, chosen by hashing the block of
+ * PARALLEL_ASTAR_BLOCK_SIZE cells across it is in, so neighbors mostly share
+ * an owner. Each thread keeps its own open list and is the only one to touch
+ * the costs and parents of its cells. Nodes generated for a cell owned by
+ * another thread are sent to it in batches through a lock-free queue.
+ *
+ * Threads do not expand in a global f order, so a cell may be expanded again
+ * when a cheaper path to it arrives. The cost of the best path to the goal
+ * found so far prunes every node that cannot improve on it, and the search
+ * ends once every thread has nothing left to expand and no node is in
+ * flight, at which point that path is optimal.
+ *
+ * Steps have octile costs, corners may be cut, and cells in collision in
+ * graph.cspace_bits are skipped, computing the C-space first if needed.
+ * @param[in, out]  graph The graph to search over. Expanded cells are added to graph.visited_cells.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param  num_threads The number of threads to use, or 0 for one per core.
+ * @return  The path, its cost, and counters from the search.
+ */
+ParallelAStarResult parallelAStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, int num_threads = 0);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_PARALLEL_ASTAR_H
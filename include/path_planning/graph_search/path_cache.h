@@ -0,0 +1,143 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_PATH_CACHE_H
+#define PATH_PLANNING_GRAPH_SEARCH_PATH_CACHE_H
+
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define PATH_CACHE_DEFAULT_BYTES    (16 << 20)  // The default memory cap of a path cache.
+
+/**
+ * A path kept by a PathCache.
+ */
+struct PathCacheEntry
+{
+    uint64_t id;                    // Unique within the cache.
+    Cell start, goal;
+    float collision_radius;         // The collision radius the path was planned with.
+    uint64_t map_version;           // The map version the path was last checked against.
+    int width, height;              // The size of the map the path was planned on.
+    std::vector<Cell> path;
+    double plan_seconds;            // How long planning the path took.
+    size_t bytes;                   // The memory counted against the cap for the path.
+};
+
+/**
+ * The key of an exact path cache lookup.
+ */
+struct PathCacheKey
+{
+    float collision_radius;
+    int start_i, start_j, goal_i, goal_j;
+
+    bool operator==(const PathCacheKey& other) const
+    {
+        return collision_radius == other.collision_radius && start_i == other.start_i &&
+               start_j == other.start_j && goal_i == other.goal_i && goal_j == other.goal_j;
+    }
+};
+
+struct PathCacheKeyHash
+{
+    size_t operator()(const PathCacheKey& key) const;
+};
+
+/**
+ * Keeps the shortest paths planned on a map for repeated and overlapping
+ * queries. Paths are looked up by collision radius, start and goal. A query
+ * whose start and goal both lie on a cached path is served the part of that
+ * path between them, reversed if needed, since every part of a shortest path
+ * is itself a shortest path.
+ *
+ * Paths are not dropped when the map version changes. Instead, a path
+ * planned against an older version is checked cell by cell against
+ * graph.cspace_bits the next time it is used, and dropped only if a cell is
+ * now in collision. A path that passes is still collision free but may no
+ * longer be the shortest if the edits freed cells. A cache serves one map:
+ * paths are only dropped for another map if its size differs.
+ *
+ * The least recently used paths are dropped to keep the memory used under a
+ * cap. Paths that are empty are never cached.
+ */
+class PathCache
+{
+public:
+    /**
+     * Plans a path on a miss. It should return a shortest path for subpaths
+     * to be shortest paths too.
+     */
+    using Planner = std::function<std::vector<Cell>(GridGraph&, const Cell&, const Cell&)>;
+
+    /**
+     * @param  max_bytes The memory cap for the cached paths, including their index.
+     * @param  planner The planner to use on a miss, or null for weightedAStarSearch() with w = 1.
+     */
+    explicit PathCache(size_t max_bytes = PATH_CACHE_DEFAULT_BYTES, Planner planner = nullptr);
+
+    /**
+     * Finds a path from a start to a goal, from the cache if possible.
+     * @param[in, out]  graph The graph to search over.
+     * @param  start The start cell.
+     * @param  goal The goal cell.
+     * @return  A list of cells from the start to the goal, or an empty list if
+     *          there is no path.
+     */
+    std::vector<Cell> findPath(GridGraph& graph, const Cell& start, const Cell& goal);
+
+    void clear();
+    size_t size() const { return entries_.size(); }
+    size_t bytes() const { return bytes_; }
+    int64_t hits() const { return hits_; }                      // Queries served a whole cached path.
+    int64_t subpathHits() const { return subpath_hits_; }       // Queries served part of a cached path.
+    int64_t misses() const { return misses_; }                  // Queries that were planned.
+    int64_t revalidated() const { return revalidated_; }        // Paths kept after a map change.
+    int64_t invalidated() const { return invalidated_; }        // Paths dropped after a map change.
+    int64_t evicted() const { return evicted_; }                // Paths dropped for the memory cap.
+
+    /**
+     * The share of queries served from the cache.
+     */
+    double hitRate() const;
+
+    /**
+     * The planning time saved by hits in seconds, less the time spent on
+     * lookups. Each hit saves the time its path took to plan.
+     */
+    double savedSeconds() const { return saved_seconds_; }
+
+private:
+    using EntryList = std::list<PathCacheEntry>;
+
+    /**
+     * Where a cell lies on a cached path.
+     */
+    struct Occurrence
+    {
+        uint64_t id;
+        int position;
+    };
+
+    bool validate(GridGraph& graph, EntryList::iterator entry);
+    void touch(EntryList::iterator entry);
+    void erase(EntryList::iterator entry);
+    void insert(GridGraph& graph, const Cell& start, const Cell& goal, const std::vector<Cell>& path,
+                double plan_seconds);
+
+    size_t max_bytes_;
+    Planner planner_;
+    EntryList entries_;                                                     // Most recently used first.
+    std::unordered_map<uint64_t, EntryList::iterator> by_id_;
+    std::unordered_map<PathCacheKey, uint64_t, PathCacheKeyHash> by_key_;
+    std::unordered_map<uint64_t, std::vector<Occurrence>> by_cell_;         // Keyed by (i << 32) | j.
+    uint64_t next_id_ = 0;
+    size_t bytes_ = 0;
+    int64_t hits_ = 0, subpath_hits_ = 0, misses_ = 0;
+    int64_t revalidated_ = 0, invalidated_ = 0, evicted_ = 0;
+    double saved_seconds_ = 0;
+};
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_PATH_CACHE_H
@@ -0,0 +1,95 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_PATH_DATABASE_H
+#define PATH_PLANNING_GRAPH_SEARCH_PATH_DATABASE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_layer.h>
+
+#define PATH_DATABASE_NO_MOVE   8   // The move stored for targets that cannot be reached.
+
+/**
+ * A compressed path database: the first move of a shortest path from every
+ * collision free cell to every other one. Free cells are ranked along a
+ * Z-order curve, which keeps nearby cells close together, so the targets
+ * reached through the same first move form long runs of ranks. Each source
+ * stores only the runs, as (first rank << 4) | move, so a lookup is a binary
+ * search. Moves index kNeighborSteps.
+ */
+struct PathDatabase
+{
+    int width = 0, height = 0;
+    float collision_radius = 0;         // The radius the database was built with.
+    int threshold = 0;                  // The occupancy threshold the database was built with.
+    uint64_t odds_checksum = 0;         // Checksum of the cell odds the database was built from.
+
+    MapLayer<int32_t> ranks;            // The rank of each cell, indexed like the graph, or -1 if in collision.
+    MapLayer<uint32_t> rank_cells;      // The graph index of the cell with each rank.
+    MapLayer<uint64_t> run_offsets;     // Where the runs of each source start, by rank, plus the total.
+    MapLayer<uint32_t> runs;            // The runs of every source.
+};
+
+/**
+ * Builds a path database by running a Dijkstra search with octile costs from
+ * every collision free cell, spread across threads. This takes time and
+ * memory quadratic in the number of free cells, so it is meant for fixed,
+ * moderately sized maps. Uses graph.cspace_bits, computing the C-space first
+ * if needed.
+ * @param[in, out]  graph The graph to build the database for.
+ * @param[out]  db The database to fill.
+ * @param  num_threads The number of threads to use, or 0 for one per core.
+ */
+void buildPathDatabase(GridGraph& graph, PathDatabase& db, int num_threads = 0);
+
+/**
+ * Looks up the first move of a shortest path between two cells.
+ * @param  db The path database.
+ * @param  source The graph index of the source cell.
+ * @param  target The graph index of the target cell.
+ * @return  The index of the move in kNeighborSteps, or PATH_DATABASE_NO_MOVE
+ *          if there is no path or either cell is in collision.
+ */
+int pathDatabaseMove(const PathDatabase& db, int source, int target);
+
+/**
+ * Extracts a path from a path database with one lookup per step, without any
+ * search.
+ * @param  db The path database.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @return  A list of cells from the start to the goal, or an empty list if
+ *          there is no path.
+ */
+std::vector<Cell> pathDatabasePath(const PathDatabase& db, const Cell& start, const Cell& goal);
+
+/**
+ * Computes the memory used by a path database in bytes.
+ */
+size_t pathDatabaseBytes(const PathDatabase& db);
+
+/**
+ * Checks whether a path database was built for the map in a graph.
+ */
+bool isPathDatabaseFor(const PathDatabase& db, const GridGraph& graph);
+
+/**
+ * Stores a path database in a binary map file, see saveBinaryMapDatabase().
+ * @param  file_path The binary map file the database was built for.
+ * @param  db The database to store.
+ * @return  True if the database was stored, false otherwise.
+ */
+bool savePathDatabase(const std::string& file_path, const PathDatabase& db);
+
+/**
+ * Loads the path database stored in a binary map file. The database is used
+ * in place from the memory mapped file.
+ * @param  file_path The binary map file to read.
+ * @param[out]  db The database to fill.
+ * @param  verify_checksum Whether to verify the checksum of the whole database.
+ * @return  True if the file has a valid database, false otherwise.
+ */
+bool loadPathDatabase(const std::string& file_path, PathDatabase& db, bool verify_checksum = false);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_PATH_DATABASE_H
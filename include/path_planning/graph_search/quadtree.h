@@ -0,0 +1,78 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_QUADTREE_H
+#define PATH_PLANNING_GRAPH_SEARCH_QUADTREE_H
+
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+/**
+ * A free leaf of a quadtree, the cells [x0, x1) x [y0, y1).
+ */
+struct QuadLeaf
+{
+    int x0, y0, x1, y1;
+};
+
+/**
+ * A quadtree decomposition of the free space of a map. The map is split into
+ * squares, and squares that have both free cells and cells in collision are
+ * split again into four, down to single cells. Squares that are entirely
+ * free become the leaves of the search graph. Leaves are adjacent when any
+ * of their cells are 8-connected neighbors.
+ */
+struct QuadtreeMap
+{
+    int width = 0, height = 0;              // Size of the map in cells.
+    uint64_t map_version = 0;               // The map version the quadtree was built for.
+    double build_seconds = 0;               // How long building the quadtree took.
+
+    std::vector<QuadLeaf> leaves;           // The free leaves.
+    std::vector<int> leaf_of_cell;          // The leaf holding each cell, or -1 for cells in collision.
+    std::vector<int> neighbor_offsets;      // Leaf k's neighbors are neighbors[neighbor_offsets[k]..[k + 1]).
+    std::vector<int> neighbors;
+};
+
+/**
+ * Counters from a quadtree search.
+ */
+struct QuadtreeSearchStats
+{
+    int64_t leaves_expanded = 0;    // Leaves taken off the open set.
+};
+
+/**
+ * Builds the quadtree of a map. Cells in collision are taken from
+ * graph.cspace_bits, which are computed first if needed.
+ * @param[in, out]  graph The graph to decompose.
+ * @param[out]  quadtree The quadtree to fill.
+ */
+void buildQuadtree(GridGraph& graph, QuadtreeMap& quadtree);
+
+/**
+ * Estimates the memory used by a quadtree in bytes.
+ */
+size_t quadtreeBytes(const QuadtreeMap& quadtree);
+
+/**
+ * Searches for a path with A* over the leaves of a quadtree. Each leaf is
+ * entered at one cell. Moving to a neighboring leaf crosses at the pair of
+ * border cells that gives the lowest estimate, costing the octile distance
+ * from the entry cell to the border plus the step across, which is the exact
+ * cost of the cells walked. Within a leaf, any octile path stays inside it,
+ * so the path is always collision free, though it may be slightly longer
+ * than the shortest one.
+ *
+ * The entry cell of each expanded leaf is added to graph.visited_cells.
+ * @param[in, out]  graph The graph to search over.
+ * @param  quadtree The quadtree, built for the current map version.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @return  A list of cells from the start to the goal, or an empty list if
+ *          either is in collision or there is no path.
+ */
+std::vector<Cell> quadtreeSearch(GridGraph& graph, const QuadtreeMap& quadtree, const Cell& start, const Cell& goal,
+                                 QuadtreeSearchStats* stats = nullptr);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_QUADTREE_H
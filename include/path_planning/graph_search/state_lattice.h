@@ -0,0 +1,116 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_STATE_LATTICE_H
+#define PATH_PLANNING_GRAPH_SEARCH_STATE_LATTICE_H
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define LATTICE_NUM_HEADINGS        16      // Headings along (1, 0), (2, 1), (1, 1), (1, 2), (0, 1), ...
+#define LATTICE_MIN_TURN_RADIUS     2.0f    // The tightest curve of a turning primitive, in cells.
+#define LATTICE_MAX_TURN_REACH      6       // Turning primitives end within this many cells of their start.
+#define LATTICE_LONG_STRAIGHT       3       // Long straight primitives cover this many short ones.
+#define LATTICE_TURN_IN_PLACE_COST  1.0f    // Cost of turning in place to the next heading, in cells.
+#define LATTICE_HEURISTIC_RADIUS    24      // The heuristic table covers offsets up to this many cells.
+
+/**
+ * A motion from a lattice state to another, starting at the center of a
+ * cell. Offsets and poses are relative to the start cell, in cells.
+ */
+struct MotionPrimitive
+{
+    int start_heading, end_heading;
+    int di, dj;                                 // Where the motion ends.
+    float cost;                                 // The length of the motion in cells, or the cost of turning in place.
+    std::vector<Cell> swept;                    // Every cell the motion passes through, except the start cell.
+    std::vector<std::array<float, 3>> poses;    // (x, y, theta) along the motion, about a cell apart, ending at (di, dj).
+};
+
+/**
+ * A state lattice over (i, j, heading). The primitives and the heuristic
+ * table do not depend on the map, so one lattice serves any number of
+ * searches.
+ */
+struct StateLattice
+{
+    std::vector<std::vector<MotionPrimitive>> primitives;   // The primitives leaving each heading.
+    int heuristic_radius = 0;                               // 0 if the heuristic table is not used.
+    std::vector<float> heuristic;                           // Cost to reach the origin in free space, see latticeHeuristic().
+    bool grid_heuristic = true;                             // Whether searches also use grid distances around obstacles.
+};
+
+/**
+ * Counters from a lattice search.
+ */
+struct LatticeSearchStats
+{
+    int64_t expanded = 0;               // States taken off the open set.
+    int64_t swept_cells_checked = 0;    // Swept cells tested against the C-space.
+};
+
+/**
+ * The angle of a lattice heading in radians, in (-pi, pi].
+ */
+float latticeHeadingAngle(int heading);
+
+/**
+ * The lattice heading closest to an angle in radians.
+ */
+int latticeHeadingIndex(float theta);
+
+/**
+ * Builds the motion primitives of a lattice and, unless heuristic_radius is
+ * 0, the heuristic table.
+ *
+ * Each heading has a short and a long straight primitive, turns to both
+ * neighboring headings in place, and smooth turns to both neighboring
+ * headings. A smooth turn is the shortest cubic Hermite curve to a cell
+ * within LATTICE_MAX_TURN_REACH whose curvature stays within
+ * 1 / LATTICE_MIN_TURN_RADIUS. The swept cells of each primitive are found
+ * by sampling it every fortieth of a cell, so the cells of a primitive are
+ * always 8-connected.
+ *
+ * The heuristic table holds the cost of the cheapest motion from each offset
+ * and heading to the origin in free space, at any heading. It is found with
+ * Dijkstra's algorithm backwards from the origin, over a window twice as
+ * wide as the table so that paths leaving the table are counted.
+ * @param[out]  lattice The lattice to fill.
+ * @param  heuristic_radius The radius of the heuristic table in cells, or 0 for none.
+ */
+void buildStateLattice(StateLattice& lattice, int heuristic_radius = LATTICE_HEURISTIC_RADIUS);
+
+/**
+ * Estimates the cost from a cell and heading to a goal cell. This is the
+ * heuristic table entry for the offset if it is in the table, and never less
+ * than the Euclidean distance.
+ */
+float latticeHeuristic(const StateLattice& lattice, int di, int dj, int heading);
+
+/**
+ * Searches for a kinematically feasible path with A* over a state lattice.
+ * A primitive can be taken if every cell it sweeps is in bounds and free in
+ * graph.cspace_bits, which are computed first if needed. The search ends at
+ * the goal cell at any heading.
+ *
+ * The heuristic table only knows about free space. When
+ * lattice.grid_heuristic is set, the search first runs Dijkstra's algorithm
+ * over the 8-connected grid from the goal. The heuristic is then never less
+ * than the grid distance times cos(pi / 8), which is how much shorter than
+ * an 8-connected path an any-angle path can be. States the grid cannot reach
+ * the goal from are never generated.
+ * @param[in, out]  graph The graph to search over. The cell of each expanded state is added to graph.visited_cells.
+ * @param  lattice The lattice.
+ * @param  start The start cell.
+ * @param  start_theta The heading at the start in radians. It is rounded to the nearest lattice heading.
+ * @param  goal The goal cell.
+ * @param[out]  stats If not null, filled with counters from the search.
+ * @param[out]  cells If not null, set to the cells the path sweeps, from the start to the goal.
+ * @return  The (x, y, theta) poses of the path in meters and radians, about
+ *          a cell apart, ready for drivePath(). Empty if there is no path.
+ */
+std::vector<std::array<float, 3>> latticeSearch(GridGraph& graph, const StateLattice& lattice, const Cell& start,
+                                                float start_theta, const Cell& goal,
+                                                LatticeSearchStats* stats = nullptr, std::vector<Cell>* cells = nullptr);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_STATE_LATTICE_H
@@ -0,0 +1,54 @@
+#ifndef PATH_PLANNING_GRAPH_SEARCH_WAVEFRONT_H
+#define PATH_PLANNING_GRAPH_SEARCH_WAVEFRONT_H
+
+#include <vector>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/occupancy_bits.h>
+
+/**
+ * Expands an 8-connected breadth first wavefront from a start cell over the
+ * clear cells of a bit grid. Each step grows the frontier by one hop for 64
+ * cells at a time using shifts, ORs and AND-NOTs against the blocked bits.
+ * Only the words next to the current frontier are touched each step, so the
+ * work is proportional to the frontier rather than the whole map.
+ *
+ * The start cell is always reached, even if it is blocked, like
+ * breadthFirstSearch().
+ * @param  blocked The blocked cells, such as GridGraph::cspace_bits.
+ * @param  start The start cell.
+ * @param  max_hops The number of steps to expand, or -1 to expand until no
+ *                  new cells are reached.
+ * @param[out]  reached Set for every cell reached. Bits past the end of each
+ *                      row are clear.
+ * @param[out]  hops If not null, set to the hop distance of each cell, indexed
+ *                   like the graph, or -1 for cells that were not reached.
+ * @return  The number of steps expanded.
+ */
+int expandWavefront(const OccupancyBits& blocked, const Cell& start, int max_hops,
+                    OccupancyBits& reached, std::vector<int>* hops = nullptr);
+
+/**
+ * Computes the number of 8-connected steps from the start cell to every cell
+ * that can be reached without collision, using expandWavefront() over
+ * graph.cspace_bits. The C-space is computed first if it has not been.
+ * @param[in, out]  graph The graph to search over.
+ * @param  start The start cell.
+ * @param  max_hops The largest hop distance to compute, or -1 for no limit.
+ * @return  The hop distance of each cell, indexed like the graph, or -1 for
+ *          cells that were not reached.
+ */
+std::vector<int> wavefrontHopDistances(GridGraph& graph, const Cell& start, int max_hops = -1);
+
+/**
+ * Computes the set of cells that can be reached from the start cell without
+ * collision, using expandWavefront() over graph.cspace_bits. The C-space is
+ * computed first if it has not been.
+ * @param[in, out]  graph The graph to search over.
+ * @param  start The start cell.
+ * @param  max_hops The largest hop distance to expand to, or -1 for no limit.
+ * @return  A bit grid where the reachable cells are set.
+ */
+OccupancyBits wavefrontReachable(GridGraph& graph, const Cell& start, int max_hops = -1);
+
+#endif  // PATH_PLANNING_GRAPH_SEARCH_WAVEFRONT_H
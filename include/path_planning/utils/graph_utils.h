@@ -1,13 +1,24 @@
 #ifndef PATH_PLANNING_GRAPH_SEARCH_GRAPH_UTILS_H
 #define PATH_PLANNING_GRAPH_SEARCH_GRAPH_UTILS_H
 
+#include <cmath>
 #include <array>
 #include <vector>
 #include <string>
+#include <cstdint>
+#include <algorithm>
+
+#include <path_planning/utils/map_layer.h>
+#include <path_planning/utils/occupancy_bits.h>
 
 #define HIGH 1e6
 #define ROBOT_RADIUS 0.137
 
+// How searches check cells for collisions, see GridGraph::collision_mode.
+#define COLLISION_EAGER         0   // Check each neighbor with checkCollision() as it is generated.
+#define COLLISION_LAZY          1   // Check each cell once with checkCollision(), when it is expanded.
+#define COLLISION_PRECOMPUTED   2   // Look each neighbor up in graph.cspace_bits.
+
 /**
  * Cell struct to represent a location in the grid.
  */
@@ -27,6 +38,7 @@ struct CellNode
     bool visited = false;  
     int cost = HIGH; 
     int threshold= -100;     
+    int8_t collision = -1;  // Cached result of checkCollision() in lazy mode, -1 if not checked yet.
     
     CellNode() = default;
 };
@@ -52,9 +64,15 @@ struct GridGraph
     float meters_per_cell;                  // Width of a cell in meters.
     float collision_radius;                 // The radius to use to check collisions.
     int8_t threshold;                       // Threshold to check if a cell is occupied or not.
+    uint64_t map_version = 0;               // Changes whenever the map changes, see markMapChanged().
+    int collision_mode = COLLISION_EAGER;   // How searches check for collisions, one of COLLISION_*.
+    int64_t collision_checks = 0;           // Calls to checkCollision() made by searches. Never reset by them.
 
-    std::vector<int8_t> cell_odds;          // The odds that a cell is occupied.
-    std::vector<float> obstacle_distances;  // The distance from each cell to the nearest obstacle.
+    MapLayer<int8_t> cell_odds;             // The odds that a cell is occupied.
+    MapLayer<float> obstacle_distances;     // The distance from each cell to the nearest obstacle.
+    MapLayer<uint8_t> cspace;               // 1 if a cell is in collision, see computeCSpace(). May be empty.
+    OccupancyBits occupancy_bits;           // Set for occupied cells, see updateOccupancyBits().
+    OccupancyBits cspace_bits;              // Set for cells in collision, see computeCSpace(). May be empty.
     std::vector<Cell> visited_cells;        // A list of visited cells for visualization/debugging.
     std::vector<CellNode> nodes;            // Vector of CellNodes for each cell in the grid.
 };
@@ -68,13 +86,23 @@ struct GridGraph
 bool isLoaded(const GridGraph& graph);
 
 /**
- * Loads graph data from a file.
+ * Loads graph data from a file. Both text maps and binary maps written by
+ * saveToBinaryFile() are supported, see map_binary.h.
  * @param  file_path  The map file to read.
  * @param  graph      The graph to populate with data from the file.
  * @return  True if the load succeeded, false otherwise.
  */
 bool loadFromFile(const std::string& file_path, GridGraph& graph);
 
+/**
+ * Saves the map data to a file in the same format read by loadFromFile(): a
+ * header line followed by one line of cell odds per row.
+ * @param  file_path  The map file to write.
+ * @param  graph      The graph to save.
+ * @return  True if the save succeeded, false otherwise.
+ */
+bool saveToFile(const std::string& file_path, const GridGraph& graph);
+
 /**
  * Converts all map data to a string. This is helpful for saving to a file.
  * @param  graph  The graph to convert to a string.
@@ -82,7 +110,16 @@ bool loadFromFile(const std::string& file_path, GridGraph& graph);
 std::string mapAsString(GridGraph& graph);
 
 /**
- * Initializes the graph data.
+ * Formats the map header the same way as writing the fields to a std::ostream,
+ * as used by mapAsString().
+ * @param  graph      The graph whose header to format.
+ * @param  separator  The character written after the header fields.
+ */
+std::string formatHeader(const GridGraph& graph, char separator);
+
+/**
+ * Initializes the graph data. In COLLISION_PRECOMPUTED mode, this also builds
+ * graph.cspace_bits if needed.
  * @param  graph  The graph to initialize.
  */
 void initGraph(GridGraph& graph);
@@ -153,6 +190,28 @@ bool isCellOccupied(int i, int j, const GridGraph& graph);
  */
 std::vector<int> findNeighbors(int idx, const GridGraph& graph);
 
+/**
+ * The offsets {di, dj} from a cell to each of its eight neighbors, for
+ * searches that step to neighbors directly instead of calling findNeighbors().
+ * Flow fields and the path database store moves as indices into this table
+ * and rely on the opposite of step k being step 7 - k, so keep the order.
+ */
+extern const int kNeighborSteps[8][2];
+
+/**
+ * Gets the octile distance between two cells, the cost of the shortest
+ * 8-connected path with unit straight and sqrt(2) diagonal steps on an
+ * empty grid.
+ * @param  a      The first cell.
+ * @param  b      The second cell.
+ * @return  The distance in cells.
+ */
+inline float octileDistance(const Cell& a, const Cell& b)
+{
+    int di = std::abs(a.i - b.i), dj = std::abs(a.j - b.j);
+    return std::max(di, dj) + (M_SQRT2 - 1) * std::min(di, dj);
+}
+
 /**
  * Checks whether the provided index in the graph is within the defined
  * collision radius of an obstacle using the distance transform.
@@ -173,6 +232,83 @@ bool checkCollisionFast(int idx, const GridGraph& graph);
  */
 bool checkCollision(int idx, const GridGraph& graph);
 
+/**
+ * Computes the configuration space of the graph, storing 1 in graph.cspace
+ * for every cell where checkCollision() is true and 0 otherwise. The same
+ * cells are set in graph.cspace_bits.
+ * @param[out]  graph The graph to update.
+ */
+void computeCSpace(GridGraph& graph);
+
+/**
+ * Rebuilds graph.occupancy_bits from the cell odds and threshold. The loaders
+ * and map generators do this already, so it is only needed after modifying
+ * graph.cell_odds directly.
+ * @param[out]  graph The graph to update.
+ */
+void updateOccupancyBits(GridGraph& graph);
+
+/**
+ * Packs graph.cspace into graph.cspace_bits, computing the C-space first if
+ * graph.cspace is empty.
+ * @param[out]  graph The graph to update.
+ */
+void updateCSpaceBits(GridGraph& graph);
+
+/**
+ * Gives the graph a new map version, so that anything computed from the map,
+ * such as cached flow fields, is rebuilt. The loaders, map generators and
+ * setCellOdds() do this already, so it is only needed after modifying the map
+ * or collision parameters directly. Versions are unique across all graphs.
+ * @param[out]  graph The graph that changed.
+ */
+void markMapChanged(GridGraph& graph);
+
+/**
+ * Sets the odds of a cell, updating the occupancy bits and any computed
+ * C-space around the cell, and marks the map as changed.
+ * @param  idx    The index of the cell in the graph data.
+ * @param  odds   The new odds that the cell is occupied.
+ * @param[out]  graph The graph the cell belongs to.
+ */
+void setCellOdds(int idx, int8_t odds, GridGraph& graph);
+
+/**
+ * Gets graph.cspace_bits, building them first with updateCSpaceBits() if they
+ * have not been built for a map of this size.
+ * @param[in, out]  graph The graph to get the C-space of.
+ */
+const OccupancyBits& getCSpaceBits(GridGraph& graph);
+
+/**
+ * Checks whether the provided index in the graph is in collision using
+ * graph.cspace_bits, falling back to checkCollision() if they are not built.
+ * @param  idx    The index of the cell in the graph data.
+ * @param  graph  The graph the cell belongs to.
+ */
+bool checkCollisionBits(int idx, const GridGraph& graph);
+
+/**
+ * Checks whether a search should skip a neighbor it generated because it is
+ * in collision, following graph.collision_mode. In eager mode this always
+ * calls checkCollision(). In lazy mode it only reports cells that were
+ * already found in collision when expanded, see checkExpandedCollision().
+ * @param  idx    The index of the neighbor in the graph data.
+ * @param[in, out]  graph The graph the cell belongs to.
+ */
+bool checkNeighborCollision(int idx, GridGraph& graph);
+
+/**
+ * Checks whether a search should skip expanding a cell it took off its open
+ * set because it is in collision. Only lazy mode checks here, calling
+ * checkCollision() the first time a cell is expanded and caching the result
+ * in graph.nodes until the next initGraph(). Since cells in collision are
+ * never expanded in any mode, every mode finds the same path.
+ * @param  idx    The index of the cell in the graph data.
+ * @param[in, out]  graph The graph the cell belongs to.
+ */
+bool checkExpandedCollision(int idx, GridGraph& graph);
+
 /**
  * Returns the parent of the node at the given index in the graph.
  * @param  idx    The index of the node in the graph data.
@@ -205,6 +341,8 @@ std::vector<Cell> tracePath(int goal, const GridGraph& graph);
 
 /**
  * Converts a path of Cells to a path of associated poses on a given graph.
+ * Each pose faces the next cell of the path, and the last pose keeps the
+ * heading it arrived with.
  * @param  path A vector of cells forming a path.
  * @param  graph The graph associated with the path.
  * @return  A vector of (x, y, theta) poses associated with the path.
@@ -213,13 +351,19 @@ static std::vector<std::array<float, 3>> cellsToPoses(std::vector<Cell>& path, G
 {
     std::vector<std::array<float, 3>> pose_path;
 
-    for (Cell& cell : path)
+    float theta = 0;
+    for (size_t k = 0; k < path.size(); ++k)
     {
         std::array<float, 3> pose;
-        auto position = cellToPos(cell.i, cell.j, graph);
+        auto position = cellToPos(path[k].i, path[k].j, graph);
+        if (k + 1 < path.size())
+        {
+            theta = std::atan2(static_cast<float>(path[k + 1].j - path[k].j),
+                               static_cast<float>(path[k + 1].i - path[k].i));
+        }
         pose[0] = position[0];
         pose[1] = position[1];
-        pose[2] = 0;
+        pose[2] = theta;
         pose_path.push_back(pose);
     }
 
@@ -0,0 +1,138 @@
+#ifndef PATH_PLANNING_UTILS_MAP_BINARY_H
+#define PATH_PLANNING_UTILS_MAP_BINARY_H
+
+#include <memory>
+#include <string>
+#include <cstdint>
+
+#include <path_planning/utils/graph_utils.h>
+
+/**
+ * Binary map file layout, version 1. All fields are written in the byte order
+ * of the machine that wrote the file, recorded in endian_tag.
+ *
+ *   BinaryMapHeader                     (128 bytes)
+ *   int8_t cell_odds[width * height]    at odds_offset
+ *   float obstacle_distances[...]       at dt_offset, if BINARY_MAP_HAS_DT
+ *   uint8_t cspace[...]                 at cspace_offset, if BINARY_MAP_HAS_CSPACE
+ *   uint64_t occupancy_bits[...]        at bits_offset, if BINARY_MAP_HAS_OCCUPANCY_BITS,
+ *                                       laid out as OccupancyBits::words
+ *   uint64_t size, checksum; data[size] at database_offset, if BINARY_MAP_HAS_PATH_DATABASE,
+ *                                       see path_database.h
+ *
+ * Sections start on 64 byte boundaries so they can be used in place once the
+ * file is memory mapped. Each section has an FNV-1a checksum, and the header
+ * has its own checksum computed with header_checksum set to zero.
+ */
+#define BINARY_MAP_MAGIC        "P3MAPBIN"
+#define BINARY_MAP_VERSION      1
+#define BINARY_MAP_ENDIAN_TAG   0x01020304u
+#define BINARY_MAP_HAS_DT       0x1u
+#define BINARY_MAP_HAS_CSPACE   0x2u
+#define BINARY_MAP_HAS_OCCUPANCY_BITS 0x4u
+#define BINARY_MAP_HAS_PATH_DATABASE  0x8u
+
+struct BinaryMapHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_tag;
+    uint32_t width, height;
+    float origin_x, origin_y;
+    float meters_per_cell;
+    float collision_radius;     // The radius the C-space layer was computed with.
+    int32_t threshold;
+    uint32_t flags;             // Which optional sections are present.
+    uint64_t odds_offset, dt_offset, cspace_offset;
+    uint64_t odds_checksum, dt_checksum, cspace_checksum;
+    uint64_t header_checksum;
+    uint64_t bits_offset, bits_checksum;
+    uint64_t database_offset;
+};
+static_assert(sizeof(BinaryMapHeader) == 128, "BinaryMapHeader must be 128 bytes.");
+
+/**
+ * Checks whether a file is a binary map by reading its magic number.
+ * @param  file_path The file to check.
+ * @return  True if the file starts with the binary map magic number.
+ */
+bool isBinaryMapFile(const std::string& file_path);
+
+/**
+ * Saves a graph to a binary map file. The occupancy bits are stored too when
+ * graph.occupancy_bits is built, so loading does not have to derive them.
+ * @param  file_path The file to write.
+ * @param  graph The graph to save.
+ * @param  include_dt Whether to store graph.obstacle_distances.
+ * @param  include_cspace Whether to store graph.cspace. Ignored if it is empty.
+ * @return  True if the save succeeded, false otherwise.
+ */
+bool saveToBinaryFile(const std::string& file_path, const GridGraph& graph,
+                      bool include_dt = false, bool include_cspace = false);
+
+/**
+ * Loads a binary map file. The file is memory mapped and, when it was written
+ * with the same byte order, the cell odds and any stored distance transform
+ * and C-space layers are used in place without being copied or read up front.
+ * Layers are mapped copy-on-write, so modifying them never changes the file.
+ * Files with the other byte order are read and converted. Occupancy bits are
+ * derived from the cell odds if the file does not store them.
+ *
+ * The search state in graph.nodes is left empty until the first search calls
+ * initGraph(), so loading does not touch any per-cell memory.
+ * @param  file_path The file to read.
+ * @param[out]  graph The graph to populate.
+ * @param  verify_checksums Whether to verify the checksum of every section,
+ *                          which reads the whole file. The header checksum is
+ *                          always verified.
+ * @return  True if the load succeeded, false otherwise.
+ */
+bool loadFromBinaryFile(const std::string& file_path, GridGraph& graph, bool verify_checksums = false);
+
+/**
+ * Adds a zero filled distance transform layer to the end of a binary map file
+ * that does not have one, without loading the map. The new space is sparse,
+ * so this is cheap even for maps larger than memory.
+ * @param  file_path The binary map file to modify.
+ * @return  True if the layer was added or already existed, false otherwise.
+ */
+bool addBinaryMapDistanceLayer(const std::string& file_path);
+
+/**
+ * Appends a path database section to the end of a binary map file, replacing
+ * any database it already has. The space of a replaced database is not
+ * reclaimed.
+ * @param  file_path The binary map file to modify.
+ * @param  data The serialized database.
+ * @param  size The size of the data in bytes.
+ * @return  True if the section was written, false otherwise.
+ */
+bool saveBinaryMapDatabase(const std::string& file_path, const void* data, uint64_t size);
+
+/**
+ * Memory maps the path database section of a binary map file.
+ * @param  file_path The binary map file to read.
+ * @param[out]  data Set to the start of the serialized database.
+ * @param[out]  size Set to the size of the data in bytes.
+ * @param[out]  mapping Keeps the file mapped while it is held.
+ * @param  verify_checksum Whether to verify the checksum of the data.
+ * @return  True if the file has a valid database section, false otherwise.
+ */
+bool loadBinaryMapDatabase(const std::string& file_path, const char*& data, uint64_t& size,
+                           std::shared_ptr<const void>& mapping, bool verify_checksum = false);
+
+/**
+ * Recomputes the checksums of every section of a binary map file, streaming
+ * through the file with a fixed size buffer. Used after modifying a file in
+ * place, see TiledGridGraph.
+ * @param  file_path The binary map file to update.
+ * @return  True if the checksums were updated, false otherwise.
+ */
+bool updateBinaryMapChecksums(const std::string& file_path);
+
+/**
+ * Computes the 64 bit FNV-1a checksum of a block of memory.
+ */
+uint64_t fnv1aChecksum(const void* data, size_t size, uint64_t seed = 14695981039346656037ull);
+
+#endif  // PATH_PLANNING_UTILS_MAP_BINARY_H
@@ -0,0 +1,84 @@
+#ifndef PATH_PLANNING_UTILS_MAP_GENERATOR_H
+#define PATH_PLANNING_UTILS_MAP_GENERATOR_H
+
+#include <string>
+
+#include <path_planning/utils/graph_utils.h>
+
+#define FREE_CELL_ODDS      -128
+#define OCCUPIED_CELL_ODDS  127
+#define GENERATED_MAP_MPC   0.05
+
+/**
+ * Initializes an empty map with a one cell thick wall around its border. The
+ * origin is placed so that the map is centered on (0, 0).
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param[out]  graph The graph to populate.
+ */
+void generateEmptyMap(int width, int height, GridGraph& graph);
+
+/**
+ * Generates a map with randomly placed rectangular obstacles.
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param  density The fraction of cells to cover with obstacles, in [0, 1].
+ * @param  seed The random seed. The same seed always gives the same map.
+ * @param[out]  graph The graph to populate.
+ */
+void generateRandomObstacleMap(int width, int height, float density, unsigned int seed, GridGraph& graph);
+
+/**
+ * Generates a maze using recursive division. Walls are one cell thick and
+ * every corridor is corridor_width cells wide, so the maze is passable as long
+ * as the corridors are wider than the robot.
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param  corridor_width The width of the corridors in cells.
+ * @param  seed The random seed.
+ * @param[out]  graph The graph to populate.
+ */
+void generateMazeMap(int width, int height, int corridor_width, unsigned int seed, GridGraph& graph);
+
+/**
+ * Generates rectangular rooms joined by L-shaped corridors. All rooms are
+ * connected. Everything outside the rooms and corridors is occupied.
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param  num_rooms The number of rooms to try to place.
+ * @param  corridor_width The width of the corridors in cells.
+ * @param  seed The random seed.
+ * @param[out]  graph The graph to populate.
+ */
+void generateRoomsMap(int width, int height, int num_rooms, int corridor_width, unsigned int seed,
+                      GridGraph& graph);
+
+/**
+ * Generates horizontal walls spanning the map, each with a single narrow gap
+ * at a random position, similar to data/narrow.map.
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param  num_walls The number of walls.
+ * @param  gap_width The width of the gap in each wall in cells.
+ * @param  seed The random seed.
+ * @param[out]  graph The graph to populate.
+ */
+void generateNarrowPassageMap(int width, int height, int num_walls, int gap_width, unsigned int seed,
+                              GridGraph& graph);
+
+/**
+ * Generates a map by type name, one of "random", "maze", "rooms" or "narrow".
+ * The param argument is the density for "random", the corridor width for
+ * "maze", the number of rooms for "rooms" and the gap width for "narrow".
+ * @param  type The type of map to generate.
+ * @param  width The width of the map in cells.
+ * @param  height The height of the map in cells.
+ * @param  param The type specific parameter described above.
+ * @param  seed The random seed.
+ * @param[out]  graph The graph to populate.
+ * @return  True if the type was valid, false otherwise.
+ */
+bool generateMap(const std::string& type, int width, int height, float param, unsigned int seed,
+                 GridGraph& graph);
+
+#endif  // PATH_PLANNING_UTILS_MAP_GENERATOR_H
@@ -0,0 +1,145 @@
+#ifndef PATH_PLANNING_UTILS_MAP_LAYER_H
+#define PATH_PLANNING_UTILS_MAP_LAYER_H
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+/**
+ * A per-cell array of map data. The data is either owned, like a std::vector,
+ * or lives in memory owned by someone else, such as a memory mapped map file,
+ * which lets a map be used in place without copying it.
+ *
+ * Writing to external data writes to that memory directly. Resizing external
+ * data, or copying the layer, makes an owned copy first.
+ */
+template <class T>
+class MapLayer
+{
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    MapLayer() : data_(nullptr), size_(0) {}
+    MapLayer(const std::vector<T>& values) : owned_(values) { syncOwned(); }
+    MapLayer(const MapLayer& other) : owned_(other.begin(), other.end()) { syncOwned(); }
+    MapLayer(MapLayer&& other) : data_(nullptr), size_(0) { *this = std::move(other); }
+
+    MapLayer& operator=(const MapLayer& other)
+    {
+        if (this != &other)
+        {
+            owned_.assign(other.begin(), other.end());
+            keep_alive_.reset();
+            syncOwned();
+        }
+        return *this;
+    }
+
+    MapLayer& operator=(MapLayer&& other)
+    {
+        if (this != &other)
+        {
+            bool external = other.isExternal();
+            owned_ = std::move(other.owned_);
+            keep_alive_ = std::move(other.keep_alive_);
+            data_ = external ? other.data_ : owned_.data();
+            size_ = external ? other.size_ : owned_.size();
+            other.clear();
+        }
+        return *this;
+    }
+
+    MapLayer& operator=(const std::vector<T>& values)
+    {
+        owned_ = values;
+        keep_alive_.reset();
+        syncOwned();
+        return *this;
+    }
+
+    /**
+     * Points the layer at external data. The keep_alive handle is held for as
+     * long as the layer uses the data.
+     * @param  data The first element.
+     * @param  size The number of elements.
+     * @param  keep_alive Keeps the memory holding the data valid.
+     */
+    void setExternal(T* data, size_t size, std::shared_ptr<const void> keep_alive)
+    {
+        owned_.clear();
+        owned_.shrink_to_fit();
+        keep_alive_ = std::move(keep_alive);
+        data_ = data;
+        size_ = size;
+    }
+
+    /**
+     * Whether the data is external rather than owned by the layer.
+     */
+    bool isExternal() const { return keep_alive_ != nullptr; }
+
+    void assign(size_t size, const T& value)
+    {
+        owned_.assign(size, value);
+        keep_alive_.reset();
+        syncOwned();
+    }
+
+    void resize(size_t size, const T& value = T())
+    {
+        makeOwned();
+        owned_.resize(size, value);
+        syncOwned();
+    }
+
+    void clear()
+    {
+        owned_.clear();
+        keep_alive_.reset();
+        syncOwned();
+    }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+
+    T& operator[](size_t idx) { return data_[idx]; }
+    const T& operator[](size_t idx) const { return data_[idx]; }
+
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    bool operator==(const MapLayer& other) const
+    {
+        return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+    }
+    bool operator!=(const MapLayer& other) const { return !(*this == other); }
+
+private:
+    void makeOwned()
+    {
+        if (!isExternal()) return;
+        owned_.assign(begin(), end());
+        keep_alive_.reset();
+    }
+
+    void syncOwned()
+    {
+        data_ = owned_.data();
+        size_ = owned_.size();
+    }
+
+    std::vector<T> owned_;
+    std::shared_ptr<const void> keep_alive_;
+    T* data_;
+    size_t size_;
+};
+
+#endif  // PATH_PLANNING_UTILS_MAP_LAYER_H
@@ -0,0 +1,96 @@
+#ifndef PATH_PLANNING_UTILS_OCCUPANCY_BITS_H
+#define PATH_PLANNING_UTILS_OCCUPANCY_BITS_H
+
+#include <cstdint>
+
+#include <path_planning/utils/map_layer.h>
+
+/**
+ * A grid of one bit per cell, packed into 64 bit words. Each row starts on a
+ * new word. Bit (i % 64) of word (i / 64) of row j is cell (i, j). Set bits are
+ * blocked cells. The unused bits past the end of each row are also set, so
+ * word-at-a-time scans treat the outside of the map as blocked.
+ */
+struct OccupancyBits
+{
+    int width = 0, height = 0;  // Size of the grid in cells.
+    int words_per_row = 0;      // Number of 64 bit words per row.
+    MapLayer<uint64_t> words;   // The packed bits, row by row.
+};
+
+/**
+ * Initializes a bit grid of the given size with every cell clear.
+ * @param  width The width of the grid in cells.
+ * @param  height The height of the grid in cells.
+ * @param[out]  bits The bit grid to initialize.
+ */
+void initOccupancyBits(int width, int height, OccupancyBits& bits);
+
+/**
+ * Checks whether the bit for a cell is set. Cells outside the grid are set.
+ */
+static inline bool testBit(const OccupancyBits& bits, int i, int j)
+{
+    if (i < 0 || j < 0 || i >= bits.width || j >= bits.height) return true;
+    return (bits.words[j * static_cast<size_t>(bits.words_per_row) + (i >> 6)] >> (i & 63)) & 1;
+}
+
+/**
+ * Sets or clears the bit for a cell inside the grid.
+ */
+static inline void setBit(OccupancyBits& bits, int i, int j, bool value)
+{
+    uint64_t& word = bits.words[j * static_cast<size_t>(bits.words_per_row) + (i >> 6)];
+    uint64_t mask = uint64_t(1) << (i & 63);
+    word = value ? (word | mask) : (word & ~mask);
+}
+
+/**
+ * Gets the 64 cells of row j starting at column i, which need not be word
+ * aligned. Bit k of the result is cell (i + k, j). Cells outside the grid are set.
+ */
+uint64_t rowWord(const OccupancyBits& bits, int i, int j);
+
+/**
+ * Checks whether every cell of row j in the columns [i0, i1] is clear, a word
+ * at a time. Spans that leave the grid are never clear.
+ */
+bool isRowSpanClear(const OccupancyBits& bits, int j, int i0, int i1);
+
+/**
+ * Checks whether every cell in the rectangle [i0, i1] x [j0, j1] is clear.
+ */
+bool isRectClear(const OccupancyBits& bits, int i0, int j0, int i1, int j1);
+
+/**
+ * Counts the set cells in the rectangle [i0, i1] x [j0, j1], clipped to the
+ * grid, using popcount a word at a time.
+ */
+int64_t countSetBits(const OccupancyBits& bits, int i0, int j0, int i1, int j1);
+
+/**
+ * Checks whether the straight segment between the centers of two cells only
+ * passes through clear cells. Each row the segment crosses is tested as one
+ * span of cells, a word at a time. The test is conservative: every cell the
+ * segment touches, including ones it only clips at a corner, must be clear.
+ */
+bool lineOfSight(const OccupancyBits& bits, int i0, int j0, int i1, int j1);
+
+/**
+ * Checks whether every cell whose center is within the given radius of the
+ * center of cell (i, j) is clear, one row span at a time.
+ * @param  radius The radius of the disc in cells.
+ */
+bool isDiscClear(const OccupancyBits& bits, int i, int j, float radius);
+
+/**
+ * Halves the resolution of a bit grid. Each coarse cell covers a 2x2 block of
+ * fine cells and is set if any of them is set, so a clear coarse cell means
+ * every fine cell it covers is clear. Blocks on the right and bottom edges of
+ * grids with odd sizes only cover the fine cells that exist.
+ * @param  fine The bit grid to downsample.
+ * @param[out]  coarse The bit grid to fill, (width + 1) / 2 by (height + 1) / 2.
+ */
+void downsampleOccupancyBits(const OccupancyBits& fine, OccupancyBits& coarse);
+
+#endif  // PATH_PLANNING_UTILS_OCCUPANCY_BITS_H
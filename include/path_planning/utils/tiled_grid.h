@@ -0,0 +1,129 @@
+#ifndef PATH_PLANNING_UTILS_TILED_GRID_H
+#define PATH_PLANNING_UTILS_TILED_GRID_H
+
+#include <list>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <path_planning/utils/graph_utils.h>
+
+/**
+ * Counters for the tile cache of a TiledGridGraph.
+ */
+struct TileCacheStats
+{
+    uint64_t hits = 0;        // Cell accesses served by a resident tile.
+    uint64_t misses = 0;      // Cell accesses that had to read a tile from the file.
+    uint64_t evictions = 0;   // Tiles dropped to stay under the memory cap.
+    uint64_t writebacks = 0;  // Modified tiles written back to the file.
+};
+
+/**
+ * A grid backed by a binary map file (see map_binary.h) that is read in fixed
+ * size square tiles on demand, so maps larger than memory can be used. Tiles
+ * are kept in a least recently used cache capped at a number of bytes. Cell
+ * indices are 64 bit, so maps may have more than 2^31 cells.
+ *
+ * The cell odds, distance transform and C-space layers of the file are each
+ * tiled separately. Only the distance layer can be written to, and only when
+ * the graph was opened as writable.
+ */
+class TiledGridGraph
+{
+public:
+    TiledGridGraph();
+    ~TiledGridGraph();
+
+    TiledGridGraph(const TiledGridGraph&) = delete;
+    TiledGridGraph& operator=(const TiledGridGraph&) = delete;
+
+    /**
+     * Opens a binary map file. Files written with another byte order must be
+     * converted first.
+     * @param  file_path The binary map file.
+     * @param  tile_size The width and height of a tile in cells.
+     * @param  max_resident_bytes The maximum memory used by resident tiles.
+     * @param  writable Whether to allow writing to the distance layer.
+     * @return  True if the file was opened, false otherwise.
+     */
+    bool open(const std::string& file_path, int tile_size = 256, size_t max_resident_bytes = 64 << 20,
+              bool writable = false);
+
+    /**
+     * Writes back any modified tiles and closes the file.
+     */
+    void close();
+
+    /**
+     * Writes back any modified tiles and updates the file checksums.
+     * @return  True if the writes succeeded, false otherwise.
+     */
+    bool flush();
+
+    int width, height;                      // Width and height of the map in cells.
+    float origin_x, origin_y;               // The (x, y) coordinate corresponding to cell (0, 0) in meters.
+    float meters_per_cell;                  // Width of a cell in meters.
+    float collision_radius;                 // The radius to use to check collisions.
+    int8_t threshold;                       // Threshold to check if a cell is occupied or not.
+
+    int64_t cellToIdx(int i, int j) const { return i + static_cast<int64_t>(j) * width; }
+    Cell idxToCell(int64_t idx) const { return {static_cast<int>(idx % width), static_cast<int>(idx / width)}; }
+    bool isCellInBounds(int i, int j) const { return i >= 0 && j >= 0 && i < width && j < height; }
+
+    bool hasDistances() const { return offsets_[kDistanceLayer] != 0; }
+    bool hasCSpace() const { return offsets_[kCSpaceLayer] != 0; }
+
+    int8_t cellOdds(int i, int j);
+    bool isCellOccupied(int i, int j);
+    float obstacleDistance(int i, int j);
+    void setObstacleDistance(int i, int j, float distance);
+
+    /**
+     * Checks whether a cell is in collision. Uses the C-space layer when the
+     * file has one, otherwise checks the same circle of cells as checkCollision().
+     */
+    bool checkCollision(int i, int j);
+
+    const TileCacheStats& stats() const { return stats_; }
+    void resetStats() { stats_ = TileCacheStats(); }
+    size_t residentBytes() const { return resident_bytes_; }
+    size_t maxResidentBytes() const { return max_resident_bytes_; }
+    int tileSize() const { return tile_size_; }
+
+private:
+    enum Layer { kOddsLayer = 0, kDistanceLayer = 1, kCSpaceLayer = 2, kNumLayers = 3 };
+
+    struct Tile
+    {
+        int layer;
+        int tx, ty;
+        int cols, rows;
+        bool dirty;
+        std::vector<char> data;
+    };
+    using TileList = std::list<Tile>;
+
+    char* cell(int layer, int i, int j, bool write);
+    TileList::iterator loadTile(int layer, int tx, int ty);
+    bool writeTile(Tile& tile);
+    void evictUntil(size_t max_bytes);
+
+    int fd_;
+    bool writable_;
+    std::string file_path_;
+    int tile_size_;
+    size_t max_resident_bytes_;
+    size_t resident_bytes_;
+    uint64_t offsets_[kNumLayers];
+    size_t elem_size_[kNumLayers];
+
+    TileList tiles_;  // Most recently used first.
+    std::unordered_map<uint64_t, TileList::iterator> index_;
+    TileList::iterator last_[kNumLayers];  // The last tile used for each layer.
+    bool has_last_[kNumLayers];
+    TileCacheStats stats_;
+};
+
+#endif  // PATH_PLANNING_UTILS_TILED_GRID_H
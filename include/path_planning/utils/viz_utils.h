@@ -3,71 +3,70 @@
 
 #include <vector>
 #include <string>
-#include <fstream>
+#include <future>
 
 #include "graph_utils.h"
 
+// How a large section of a plan file is written, see PlanFileOptions.
+#define PLAN_SECTION_OMIT       0   // Leave the section out.
+#define PLAN_SECTION_TEXT       1   // Write "dt" as an array of numbers and "map" as the text map file.
+#define PLAN_SECTION_BASE64     2   // Write the raw little-endian values in base64 to "dt_base64" or "map_base64".
+#define PLAN_SECTION_HASH       3   // Write only the FNV-1a checksum of the values to "dt_hash" or "map_hash".
+
+/**
+ * Selects what goes in a plan file. The defaults write the same file as
+ * always, which the navigation web app reads.
+ *
+ * The distance transform is encoded as float32 values and the map as int8
+ * odds, both row by row. With PLAN_SECTION_BASE64, the map also gets a
+ * "map_header" holding the header line of the text map. The checksums are
+ * written as 16 hex digits and match the dt_checksum and odds_checksum of
+ * a binary map file, see map_binary.h, so a viewer that already has the map
+ * can tell whether it is the right one.
+ */
+struct PlanFileOptions
+{
+    bool visited_cells = true;      // Whether to write "visited_cells".
+    int dt = PLAN_SECTION_TEXT;     // How to write the distance transform, one of PLAN_SECTION_*.
+    int map = PLAN_SECTION_TEXT;    // How to write the map, one of PLAN_SECTION_*.
+};
+
 /**
  * Generates a plan file designed for compatability with the navigation web app.
+ * The file is streamed through a buffer, so no section is ever built as a
+ * whole in memory.
  * @param  start The start cell.
  * @param  goal The goal cell.
- * @param  path The path of cells from start to goal. 
+ * @param  path The path of cells from start to goal.
  * @param  graph The associated graph.
  * @param  algo The name of the planning algorithm used to generate the path.
  * @param  out_name The name of the file to generate.
+ * @param  options The sections to write and how.
+ * @return  True if the file was written, false otherwise.
  */
-static inline void generatePlanFile(const Cell& start, const Cell& goal,
-                                    const std::vector<Cell>& path, GridGraph& graph,
-                                    const std::string& algo = "",
-                                    const std::string& out_name = "out.planner")
-{
-    std::cout << "Saving planning data to file: " << out_name << std::endl;
-
-    std::ofstream outfile;
-    outfile.open(out_name);
-
-    outfile << "{ \"path\" : [";
-
-    for (int k = 0; k < path.size(); ++k)
-    {
-        outfile << "[" + std::to_string(path[k].i) + "," + std::to_string(path[k].j) + "]";
-        if (k != path.size() - 1)
-            outfile << ",";
-    }
+bool generatePlanFile(const Cell& start, const Cell& goal, const std::vector<Cell>& path, const GridGraph& graph,
+                      const std::string& algo = "", const std::string& out_name = "out.planner",
+                      const PlanFileOptions& options = PlanFileOptions());
 
-    outfile << "], \"visited_cells\":[";
-    for (int k = 0; k < graph.visited_cells.size(); ++k)
-    {
-        outfile << "[" + std::to_string(graph.visited_cells[k].i) + "," + std::to_string(graph.visited_cells[k].j) + "]";
-        if (k != graph.visited_cells.size() - 1)
-            outfile << ",";
-    }
-    outfile << "]";
-
-    outfile << ", \"dt\":[";
-    for (int k = 0; k < graph.obstacle_distances.size(); ++k)
-    {
-        outfile << std::to_string(graph.obstacle_distances[k]);
-        if (k != graph.obstacle_distances.size() - 1)
-            outfile << ",";
-    }
-    outfile << "]";
-
-    // Now add the entire map file as a string
-    outfile << ", \"map\": \"";
-    outfile << mapAsString(graph);
-    outfile << "\""; // Add closing quote for map file
-
-    // Add start and goal elements to the dict
-    outfile << ", \"start\": [" + std::to_string(start.i) + "," + std::to_string(start.j) + "]";
-    outfile << ", \"goal\": [" + std::to_string(goal.i) + "," + std::to_string(goal.j) + "]";
-
-    // Save the planning algo used
-    outfile << ", \"planning_algo\": \"" + algo + "\"";
-
-    outfile << "}";
+/**
+ * Generates a plan file like generatePlanFile() on another thread. Only the
+ * parts of the graph the options need are copied first, so the graph may be
+ * changed or planned on again as soon as this returns.
+ * @return  A future holding whether the file was written.
+ */
+std::future<bool> generatePlanFileAsync(const Cell& start, const Cell& goal, const std::vector<Cell>& path,
+                                        const GridGraph& graph, const std::string& algo = "",
+                                        const std::string& out_name = "out.planner",
+                                        const PlanFileOptions& options = PlanFileOptions());
 
-    outfile.close();
-}
+/**
+ * Parses the name of a plan file output mode: "full" for the defaults,
+ * "compact" for base64 sections, "hash" for checksums only, or "path" to
+ * leave out the distance transform and the map.
+ * @param  name The name of the mode.
+ * @param[out]  options The options for the mode.
+ * @return  True if the name is known, false otherwise.
+ */
+bool parsePlanFileMode(const std::string& name, PlanFileOptions& options);
 
 #endif // PATH_PLANNING_UTILS_VIZ_UTILS_H
@@ -0,0 +1,53 @@
+from __future__ import print_function
+
+import sys
+import json
+
+# Counters worth comparing, in addition to the benchmark time.
+COUNTERS = ["time_per_cell", "expansions", "expansions_per_sec"]
+
+
+def load_results(json_file):
+    with open(json_file, 'r') as f:
+        data = json.load(f)
+
+    results = {}
+    for bench in data["benchmarks"]:
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "mean":
+            continue
+        results[bench["name"]] = bench
+    return results
+
+
+def format_change(old, new):
+    if old == 0:
+        return "n/a"
+    return "{:+.1f}%".format(100.0 * (new - old) / old)
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 3:
+        print("Please provide two benchmark output files. Usage:")
+        print("\n\t python compare_bench.py [OLD_JSON] [NEW_JSON]")
+        exit()
+
+    old_results = load_results(sys.argv[1])
+    new_results = load_results(sys.argv[2])
+
+    print("{:<60} {:>14} {:>14} {:>9}".format("Benchmark", "Old", "New", "Change"))
+    for name, new in new_results.items():
+        if name not in old_results:
+            print("{:<60} {:>14} {:>14.4g} {:>9}".format(name, "-", new["real_time"], "new"))
+            continue
+
+        old = old_results[name]
+        print("{:<60} {:>14.4g} {:>14.4g} {:>9}".format(name, old["real_time"], new["real_time"],
+                                                        format_change(old["real_time"], new["real_time"])))
+        for counter in COUNTERS:
+            if counter in old and counter in new:
+                print("{:<60} {:>14.4g} {:>14.4g} {:>9}".format("  " + counter, old[counter], new[counter],
+                                                                format_change(old[counter], new[counter])))
+
+    for name in old_results:
+        if name not in new_results:
+            print("{:<60} {:>14.4g} {:>14} {:>9}".format(name, old_results[name]["real_time"], "-", "removed"))
@@ -0,0 +1,72 @@
+from __future__ import print_function
+
+import sys
+import json
+from collections import defaultdict
+
+import matplotlib.pyplot as plt
+
+# The benchmark families to plot, and their labels.
+ALGORITHMS = {"BM_WeightedAStar": "Weighted A*", "BM_FocalSearch": "Focal search"}
+
+
+def load_curves(json_file):
+    """Returns {map: {algorithm: [(w, expansions, bound)]}} from the bounded search benchmarks."""
+    with open(json_file, 'r') as f:
+        data = json.load(f)
+
+    curves = defaultdict(lambda: defaultdict(list))
+    for bench in data["benchmarks"]:
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "mean":
+            continue
+        parts = bench["name"].split("/")
+        family = parts[0].replace("_Synthetic", "")
+        if family not in ALGORITHMS or "w" not in bench:
+            continue
+        if parts[0].endswith("_Synthetic"):
+            map_name = "random " + parts[1].split(":")[-1]
+        else:
+            map_name = parts[1]
+        curves[map_name][family].append((bench["w"], bench["expansions"], bench["bound"]))
+    return curves
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        print("Please provide the JSON output of the bounded search benchmarks. Usage:")
+        print("\n\t python plot_bounded_search.py [BENCH_JSON] [OUTPUT_IMAGE]")
+        print("\nThe JSON comes from:")
+        print("\n\t ./planner_bench --benchmark_filter='WeightedAStar|FocalSearch' "
+              "--benchmark_out=bounded.json --benchmark_out_format=json")
+        exit()
+
+    curves = load_curves(sys.argv[1])
+    if not curves:
+        print("No bounded search benchmarks found in", sys.argv[1])
+        exit()
+
+    maps = sorted(curves.keys())
+    cols = min(len(maps), 4)
+    rows = (len(maps) + cols - 1) // cols
+    fig, axes = plt.subplots(rows, cols, figsize=(4 * cols, 3.5 * rows), squeeze=False)
+    for ax, map_name in zip(axes.flat, maps):
+        for family, label in sorted(ALGORITHMS.items()):
+            points = sorted(curves[map_name].get(family, []))
+            if not points:
+                continue
+            print("{:<16} {:<14} ".format(map_name, label) +
+                  " ".join("w={:.2f}: {:.0f} (bound {:.3f})".format(*p) for p in points))
+            ax.plot([p[0] for p in points], [p[1] for p in points], marker='o', label=label)
+        ax.set_title(map_name)
+        ax.set_xlabel("w")
+        ax.set_ylabel("Expansions")
+        ax.set_yscale("log")
+        ax.legend()
+    for ax in list(axes.flat)[len(maps):]:
+        ax.axis("off")
+
+    fig.tight_layout()
+    if len(sys.argv) > 2:
+        fig.savefig(sys.argv[2])
+    else:
+        plt.show()
@@ -0,0 +1,353 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "alt_landmarks.h"
+
+static const float kInfinity = std::numeric_limits<float>::infinity();
+
+/**
+ * Checks whether every arc of a graph has a reverse arc of the same cost.
+ */
+static bool isSymmetric(const Graph& g)
+{
+    for (int u = 0; u < numNodes(g); ++u)
+    {
+        for (const GraphArc& arc : arcsOf(u, g))
+        {
+            bool found = false;
+            for (const GraphArc& reverse : arcsOf(arc.neighbor, g))
+            {
+                if (reverse.neighbor == u && reverse.cost == arc.cost) found = true;
+            }
+            if (!found) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Runs Dijkstra from a landmark and stores its costs in column k.
+ */
+static void storeLandmarkCosts(int landmark, int k, const Graph& g, int num_landmarks, GraphSearchState& state,
+                               std::vector<float>& costs)
+{
+    dijkstraAll(landmark, g, state);
+    for (int n = 0; n < numNodes(g); ++n)
+    {
+        bool reached = state.stamp[n] == state.round && !std::isinf(state.cost[n]);
+        costs[static_cast<size_t>(n) * num_landmarks + k] = reached ? state.cost[n] : kInfinity;
+    }
+}
+
+/**
+ * The lower bound of altLowerBound() using only the first count landmarks.
+ */
+static float lowerBound(int from, int to, int count, const AltLandmarks& alt)
+{
+    size_t stride = alt.num_landmarks;
+    const float* from_a = &alt.from_landmark[from * stride];
+    const float* from_b = &alt.from_landmark[to * stride];
+    const std::vector<float>& to_costs = alt.symmetric ? alt.from_landmark : alt.to_landmark;
+    const float* to_a = &to_costs[from * stride];
+    const float* to_b = &to_costs[to * stride];
+
+    // Terms where both costs are infinite are NaN, which std::max() drops
+    // since every comparison with NaN is false.
+    float bound = 0;
+    for (int k = 0; k < count; ++k)
+    {
+        bound = std::max(bound, from_b[k] - from_a[k]);   // d(L, to) <= d(L, from) + d(from, to)
+        bound = std::max(bound, to_a[k] - to_b[k]);       // d(from, L) <= d(from, to) + d(to, L)
+    }
+    return bound;
+}
+
+float altLowerBound(int from, int to, const AltLandmarks& alt)
+{
+    return lowerBound(from, to, alt.num_landmarks, alt);
+}
+
+/**
+ * Finds the reachable node farthest from a node, or from the nearest of the
+ * landmarks selected so far.
+ */
+static int farthestNode(const AltLandmarks& alt, int count, int num_nodes)
+{
+    int farthest = -1;
+    float farthest_cost = -1;
+    for (int n = 0; n < num_nodes; ++n)
+    {
+        float nearest = kInfinity;
+        for (int k = 0; k < count; ++k)
+        {
+            nearest = std::min(nearest, alt.from_landmark[static_cast<size_t>(n) * alt.num_landmarks + k]);
+        }
+        if (!std::isinf(nearest) && nearest > farthest_cost)
+        {
+            farthest = n;
+            farthest_cost = nearest;
+        }
+    }
+    return farthest;
+}
+
+/**
+ * Selects a landmark by avoid: grows a shortest path tree from a random root
+ * and weighs each node by how much the current landmarks underestimate its
+ * cost from the root. The landmark is the leaf reached by following the
+ * heaviest subtrees down from the root, skipping subtrees that already hold
+ * a landmark.
+ * @return  The landmark, or -1 if every subtree holds a landmark.
+ */
+static int avoidNode(int root, const Graph& g, const AltLandmarks& alt, int count, GraphSearchState& state)
+{
+    int num_nodes = numNodes(g);
+    dijkstraAll(root, g, state);
+    auto reached = [&](int n) { return state.stamp[n] == state.round && !std::isinf(state.cost[n]); };
+
+    // The children of each node in the tree.
+    std::vector<int> offsets(num_nodes + 1, 0), children;
+    for (int n = 0; n < num_nodes; ++n)
+    {
+        if (reached(n) && state.parent[n] >= 0) offsets[state.parent[n] + 1]++;
+    }
+    for (int n = 0; n < num_nodes; ++n) offsets[n + 1] += offsets[n];
+    children.resize(offsets[num_nodes]);
+    std::vector<int> next(offsets.begin(), offsets.end() - 1);
+    for (int n = 0; n < num_nodes; ++n)
+    {
+        if (reached(n) && state.parent[n] >= 0) children[next[state.parent[n]]++] = n;
+    }
+
+    std::vector<uint8_t> is_landmark(num_nodes, 0);
+    for (int k = 0; k < count; ++k) is_landmark[alt.landmarks[k]] = 1;
+
+    // Sum the weights of the subtrees, children before parents.
+    std::vector<int> order = {root};
+    for (size_t k = 0; k < order.size(); ++k)
+    {
+        for (int c = offsets[order[k]]; c < offsets[order[k] + 1]; ++c) order.push_back(children[c]);
+    }
+    std::vector<double> size(num_nodes, 0);
+    std::vector<uint8_t> holds_landmark(num_nodes, 0);
+    for (size_t k = order.size(); k-- > 0;)
+    {
+        int n = order[k];
+        holds_landmark[n] = is_landmark[n];
+        double weight = state.cost[n] - lowerBound(root, n, count, alt);
+        for (int c = offsets[n]; c < offsets[n + 1]; ++c)
+        {
+            holds_landmark[n] |= holds_landmark[children[c]];
+            weight += size[children[c]];
+        }
+        size[n] = holds_landmark[n] ? 0 : weight;
+    }
+
+    int n = root;
+    while (true)
+    {
+        int heaviest = -1;
+        for (int c = offsets[n]; c < offsets[n + 1]; ++c)
+        {
+            if (size[children[c]] > 0 && (heaviest < 0 || size[children[c]] > size[heaviest])) heaviest = children[c];
+        }
+        if (heaviest < 0) break;
+        n = heaviest;
+    }
+    return n == root && holds_landmark[root] ? -1 : n;
+}
+
+AltLandmarks selectLandmarks(const Graph& g, int num_landmarks, int method, int seed)
+{
+    AltLandmarks alt;
+    int num_nodes = numNodes(g);
+    num_landmarks = std::max(0, std::min(num_landmarks, num_nodes));
+    alt.num_landmarks = num_landmarks;
+    alt.symmetric = isSymmetric(g);
+    if (num_landmarks == 0) return alt;
+
+    Graph reverse;
+    if (!alt.symmetric)
+    {
+        std::vector<int> sources;
+        std::vector<GraphArc> arcs;
+        sources.reserve(g.arcs.size());
+        arcs.reserve(g.arcs.size());
+        for (int u = 0; u < num_nodes; ++u)
+        {
+            for (const GraphArc& arc : arcsOf(u, g))
+            {
+                sources.push_back(arc.neighbor);
+                arcs.push_back({u, arc.cost});
+            }
+        }
+        buildGraphArcs(num_nodes, sources, arcs, reverse);
+        alt.to_landmark.assign(static_cast<size_t>(num_nodes) * num_landmarks, kInfinity);
+    }
+    alt.from_landmark.assign(static_cast<size_t>(num_nodes) * num_landmarks, kInfinity);
+
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> random_node(0, num_nodes - 1);
+    GraphSearchState state;
+    std::vector<uint8_t> is_landmark(num_nodes, 0);
+    for (int k = 0; k < num_landmarks; ++k)
+    {
+        int landmark = -1;
+        if (k == 0)
+        {
+            // The node farthest from a random one.
+            dijkstraAll(random_node(gen), g, state);
+            double farthest_cost = -1;
+            for (int n = 0; n < num_nodes; ++n)
+            {
+                if (state.stamp[n] == state.round && !std::isinf(state.cost[n]) && state.cost[n] > farthest_cost)
+                {
+                    landmark = n;
+                    farthest_cost = state.cost[n];
+                }
+            }
+        }
+        else if (method == ALT_SELECT_AVOID)
+        {
+            landmark = avoidNode(random_node(gen), g, alt, k, state);
+        }
+        if (landmark < 0 || is_landmark[landmark]) landmark = farthestNode(alt, k, num_nodes);
+        if (landmark < 0 || is_landmark[landmark])
+        {
+            // Every node is a landmark or unreachable from them.
+            landmark = 0;
+            while (is_landmark[landmark]) landmark++;
+        }
+
+        is_landmark[landmark] = 1;
+        alt.landmarks.push_back(landmark);
+        storeLandmarkCosts(landmark, k, g, num_landmarks, state, alt.from_landmark);
+        if (!alt.symmetric) storeLandmarkCosts(landmark, k, reverse, num_landmarks, state, alt.to_landmark);
+    }
+
+    alt.reverse_offsets.swap(reverse.offsets);
+    alt.reverse_arcs.swap(reverse.arcs);
+    return alt;
+}
+
+std::vector<int> altAStar(int start, int goal, const Graph& g, const AltLandmarks& alt, GraphSearchState& state)
+{
+    if (goal < 0 || goal >= numNodes(g) || alt.num_landmarks == 0) return dijkstra(start, goal, g, state);
+    return heuristicSearch(start, goal, g, state, [&](int n) { return altLowerBound(n, goal, alt); });
+}
+
+std::vector<int> altBidirectionalAStar(int start, int goal, const Graph& g, const AltLandmarks& alt,
+                                       AltQueryState& state)
+{
+    int num_nodes = numNodes(g);
+    if (state.stamp[0].size() != static_cast<size_t>(num_nodes))
+    {
+        for (int d = 0; d < 2; ++d)
+        {
+            state.cost[d].assign(num_nodes, 0);
+            state.parent[d].assign(num_nodes, -1);
+            state.stamp[d].assign(num_nodes, 0);
+        }
+        state.potential.assign(num_nodes, 0);
+        state.potential_stamp.assign(num_nodes, 0);
+        state.round = 0;
+    }
+    if (++state.round == 0)
+    {
+        for (int d = 0; d < 2; ++d) std::fill(state.stamp[d].begin(), state.stamp[d].end(), 0);
+        std::fill(state.potential_stamp.begin(), state.potential_stamp.end(), 0);
+        state.round = 1;
+    }
+    state.expanded = 0;
+    state.path_cost = std::numeric_limits<double>::infinity();
+    if (start < 0 || start >= num_nodes || goal < 0 || goal >= num_nodes) return {};
+
+    // The forward search is A* on the potential, the backward search on its
+    // negation, so the reduced cost of an arc is the same in both.
+    auto potential = [&](int n)
+    {
+        if (state.potential_stamp[n] != state.round)
+        {
+            state.potential_stamp[n] = state.round;
+            if (alt.num_landmarks == 0)
+            {
+                state.potential[n] = 0;
+            }
+            else
+            {
+                float to_goal = altLowerBound(n, goal, alt), from_start = altLowerBound(start, n, alt);
+                state.potential[n] = std::isinf(to_goal) || std::isinf(from_start) ? kInfinity
+                                                                                   : (to_goal - from_start) / 2;
+            }
+        }
+        return state.potential[n];
+    };
+    if (std::isinf(potential(start)) || std::isinf(potential(goal))) return {};
+
+    for (int d = 0; d < 2; ++d)
+    {
+        int source = d == 0 ? start : goal;
+        state.heap[d].clear();
+        state.heap[d].push_back({d == 0 ? potential(source) : -potential(source), source});
+        state.stamp[d][source] = state.round;
+        state.cost[d][source] = 0;
+        state.parent[d][source] = -1;
+    }
+
+    const std::vector<int64_t>& reverse_offsets = alt.symmetric ? g.offsets : alt.reverse_offsets;
+    const std::vector<GraphArc>& reverse_arcs = alt.symmetric ? g.arcs : alt.reverse_arcs;
+    double best = std::numeric_limits<double>::infinity();
+    int meet = -1;
+    while (!state.heap[0].empty() && !state.heap[1].empty())
+    {
+        if (state.heap[0][0].first + state.heap[1][0].first >= best) break;
+        int d = state.heap[0][0].first <= state.heap[1][0].first ? 0 : 1;
+        std::vector<std::pair<double, int> >& heap = state.heap[d];
+        std::pop_heap(heap.begin(), heap.end(), LaterEntry());
+        double key = heap.back().first;
+        int u = heap.back().second;
+        heap.pop_back();
+        float sign = d == 0 ? 1 : -1;
+        if (key > state.cost[d][u] + sign * potential(u)) continue;
+        state.expanded++;
+
+        const std::vector<int64_t>& offsets = d == 0 ? g.offsets : reverse_offsets;
+        const std::vector<GraphArc>& arcs = d == 0 ? g.arcs : reverse_arcs;
+        for (int64_t k = offsets[u]; k < offsets[u + 1]; ++k)
+        {
+            int x = arcs[k].neighbor;
+            double new_cost = state.cost[d][u] + arcs[k].cost;
+            if (state.stamp[d][x] == state.round && new_cost >= state.cost[d][x]) continue;
+            double p = potential(x);
+            if (std::isinf(p)) continue;
+            state.stamp[d][x] = state.round;
+            state.cost[d][x] = new_cost;
+            state.parent[d][x] = u;
+            heap.push_back({new_cost + sign * p, x});
+            std::push_heap(heap.begin(), heap.end(), LaterEntry());
+
+            if (state.stamp[1 - d][x] == state.round && new_cost + state.cost[1 - d][x] < best)
+            {
+                best = new_cost + state.cost[1 - d][x];
+                meet = x;
+            }
+        }
+    }
+    if (start == goal)
+    {
+        best = 0;
+        meet = start;
+    }
+    if (meet < 0) return {};
+
+    std::vector<int> path;
+    for (int n = meet; n != -1; n = state.parent[0][n]) path.push_back(n);
+    std::reverse(path.begin(), path.end());
+    for (int n = state.parent[1][meet]; n != -1; n = state.parent[1][n]) path.push_back(n);
+    state.path_cost = best;
+    return path;
+}
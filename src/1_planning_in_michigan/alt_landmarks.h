@@ -0,0 +1,106 @@
+#ifndef ALT_LANDMARKS_H
+#define ALT_LANDMARKS_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "planning.h"
+
+// How landmarks are selected, see selectLandmarks().
+#define ALT_SELECT_FARTHEST     0   // Each landmark is the node farthest from those selected so far.
+#define ALT_SELECT_AVOID        1   // Each landmark covers the part of the graph the others bound worst.
+
+/**
+ * Landmarks of a graph and the shortest path costs between them and every
+ * node, giving lower bounds on the cost between any two nodes by the
+ * triangle inequality (A*, Landmarks and Triangle inequality).
+ *
+ * The costs are stored node by node, so the bound for a node reads one
+ * contiguous block: from_landmark[n * num_landmarks + k] is the cost from
+ * landmark k to node n, and to_landmark the cost from node n to landmark k.
+ * When every arc has a reverse arc of the same cost the two are equal and
+ * to_landmark is left empty. Unreachable nodes have infinite costs.
+ */
+struct AltLandmarks
+{
+    int num_landmarks = 0;
+    std::vector<int> landmarks;
+    std::vector<float> from_landmark;
+    std::vector<float> to_landmark;
+    bool symmetric = false;
+    std::vector<int64_t> reverse_offsets;   // The reversed arcs of the graph, empty if it is symmetric.
+    std::vector<GraphArc> reverse_arcs;
+
+    /**
+     * The bytes taken by the landmark costs.
+     */
+    size_t bytes() const { return (from_landmark.size() + to_landmark.size()) * sizeof(float); }
+};
+
+/**
+ * The state of a bidirectional search, reused across queries like
+ * GraphSearchState. Index 0 is the forward search and 1 the backward search.
+ */
+struct AltQueryState
+{
+    std::vector<double> cost[2];
+    std::vector<double> potential;      // The forward potential of each node, computed once per query.
+    std::vector<int> parent[2];
+    std::vector<uint32_t> stamp[2];
+    std::vector<uint32_t> potential_stamp;
+    std::vector<std::pair<double, int> > heap[2];
+    uint32_t round = 0;
+    int expanded = 0;                   // The nodes expanded by the last query, in both directions.
+    double path_cost = std::numeric_limits<double>::infinity();    // The cost of the path found by the last query.
+};
+
+/**
+ * Selects landmarks of a graph and computes their costs to and from every
+ * node. Both selection methods start from a random node.
+ * @param  g The graph.
+ * @param  num_landmarks The number of landmarks, at most the number of nodes.
+ * @param  method How to select them, one of ALT_SELECT_*.
+ * @param  seed The seed of the random nodes the selection starts from.
+ * @return  The landmarks.
+ */
+AltLandmarks selectLandmarks(const Graph& g, int num_landmarks, int method = ALT_SELECT_AVOID, int seed = 0);
+
+/**
+ * Gets a lower bound on the cost of the lowest cost path between two nodes.
+ * @param  from The index of the node the path starts at.
+ * @param  to The index of the node the path ends at.
+ * @param  alt The landmarks of the graph.
+ * @return  The bound, infinite if there is no path.
+ */
+float altLowerBound(int from, int to, const AltLandmarks& alt);
+
+/**
+ * Finds the lowest cost path from a starting node to a goal node with A*,
+ * using the landmark lower bounds as the heuristic.
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node.
+ * @param  g The associated graph.
+ * @param  alt The landmarks of the graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+std::vector<int> altAStar(int start, int goal, const Graph& g, const AltLandmarks& alt, GraphSearchState& state);
+
+/**
+ * Finds the lowest cost path from a starting node to a goal node with
+ * bidirectional A* on the landmark lower bounds. Both searches use the
+ * average of the bounds to the goal and from the start as their potential,
+ * so they can stop as soon as their two nearest nodes are no closer than the
+ * best path found.
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node.
+ * @param  g The associated graph.
+ * @param  alt The landmarks of the graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+std::vector<int> altBidirectionalAStar(int start, int goal, const Graph& g, const AltLandmarks& alt,
+                                       AltQueryState& state);
+
+#endif  // ALT_LANDMARKS_H
@@ -0,0 +1,474 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "contraction_hierarchy.h"
+#include "parallel_for.h"
+
+/**
+ * Nodes are handed to threads this many at a time.
+ */
+static const int kParallelChunk = 64;
+
+static const float kInfinity = std::numeric_limits<float>::infinity();
+
+/**
+ * A shortcut to add when a node is contracted.
+ */
+struct ChShortcut
+{
+    int from, to;
+    float cost;
+    int middle;
+};
+
+/**
+ * Contracts the nodes of a graph into a hierarchy. The graph of the nodes
+ * not contracted yet is kept as lists of arcs in and out of each node, with
+ * at most one arc between two nodes.
+ */
+class ChContractor
+{
+public:
+    ChContractor(const Graph& g, int num_threads);
+
+    ContractionHierarchy build();
+
+private:
+    /**
+     * The state of a witness search, one per thread.
+     */
+    struct Witness
+    {
+        std::vector<float> cost;
+        std::vector<uint32_t> stamp;
+        std::vector<std::pair<float, int> > heap;
+        uint32_t round = 0;
+        std::vector<uint32_t> target;   // The nodes whose distance is wanted have the round of their search.
+        int targets_left = 0;
+    };
+
+    void addArc(int from, int to, float cost, int middle);
+    void removeArc(std::vector<ChArc>& arcs, int neighbor);
+    void witnessSearch(int source, int skip, float max_cost, int settle_limit, Witness& w) const;
+    int findShortcuts(int v, int settle_limit, Witness& w, std::vector<ChShortcut>* shortcuts) const;
+    int priority(int v, Witness& w) const;
+    bool isLocalMinimum(int v) const;
+
+    int num_nodes_;
+    int num_threads_;
+    std::vector<std::vector<ChArc> > out_;
+    std::vector<std::vector<ChArc> > in_;    // The arcs u -> v into v, stored with neighbor u.
+    std::vector<uint8_t> in_batch_;           // Whether a node is being contracted this round.
+    std::vector<int> priority_;
+    std::vector<int> deleted_;                // The neighbors of each node contracted so far.
+    std::vector<int> level_;                  // One more than the highest level of a contracted neighbor.
+    std::vector<Witness> witnesses_;
+};
+
+ChContractor::ChContractor(const Graph& g, int num_threads) :
+    num_nodes_(numNodes(g)),
+    num_threads_(num_threads),
+    out_(num_nodes_),
+    in_(num_nodes_),
+    in_batch_(num_nodes_, 0),
+    priority_(num_nodes_, 0),
+    deleted_(num_nodes_, 0),
+    level_(num_nodes_, 0),
+    witnesses_(num_threads)
+{
+    for (int u = 0; u < num_nodes_; ++u)
+    {
+        for (const GraphArc& arc : arcsOf(u, g))
+        {
+            if (arc.neighbor != u) addArc(u, arc.neighbor, arc.cost, -1);
+        }
+    }
+    for (Witness& w : witnesses_)
+    {
+        w.cost.assign(num_nodes_, 0);
+        w.stamp.assign(num_nodes_, 0);
+        w.target.assign(num_nodes_, 0);
+    }
+}
+
+void ChContractor::addArc(int from, int to, float cost, int middle)
+{
+    for (ChArc& arc : out_[from])
+    {
+        if (arc.neighbor != to) continue;
+        if (cost >= arc.cost) return;
+        arc.cost = cost;
+        arc.middle = middle;
+        for (ChArc& reverse : in_[to])
+        {
+            if (reverse.neighbor == from) reverse = {from, cost, middle};
+        }
+        return;
+    }
+    out_[from].push_back({to, cost, middle});
+    in_[to].push_back({from, cost, middle});
+}
+
+void ChContractor::removeArc(std::vector<ChArc>& arcs, int neighbor)
+{
+    for (size_t k = 0; k < arcs.size(); ++k)
+    {
+        if (arcs[k].neighbor != neighbor) continue;
+        arcs[k] = arcs.back();
+        arcs.pop_back();
+        return;
+    }
+}
+
+/**
+ * Searches from a node for paths no longer than max_cost that avoid skip
+ * and the nodes being contracted. The search stops early once every target
+ * is settled, so the caller must have started a round and marked them.
+ */
+void ChContractor::witnessSearch(int source, int skip, float max_cost, int settle_limit, Witness& w) const
+{
+    w.heap.clear();
+    w.stamp[source] = w.round;
+    w.cost[source] = 0;
+    w.heap.push_back({0, source});
+
+    int settled = 0;
+    while (!w.heap.empty())
+    {
+        std::pop_heap(w.heap.begin(), w.heap.end(), LaterEntry());
+        float cost = w.heap.back().first;
+        int u = w.heap.back().second;
+        w.heap.pop_back();
+        if (cost > w.cost[u]) continue;
+        if (cost > max_cost || ++settled > settle_limit) return;
+        if (w.target[u] == w.round && --w.targets_left == 0) return;
+
+        for (const ChArc& arc : out_[u])
+        {
+            int x = arc.neighbor;
+            float new_cost = cost + arc.cost;
+            if (x == skip || in_batch_[x] || new_cost > max_cost) continue;
+            if (w.stamp[x] == w.round && new_cost >= w.cost[x]) continue;
+            w.stamp[x] = w.round;
+            w.cost[x] = new_cost;
+            w.heap.push_back({new_cost, x});
+            std::push_heap(w.heap.begin(), w.heap.end(), LaterEntry());
+        }
+    }
+}
+
+/**
+ * Finds the shortcuts needed to contract a node: one for each pair of
+ * neighbors u -> v -> x without a witness, another path from u to x that is
+ * no longer. A witness search that gives up early only adds shortcuts.
+ * @return  The number of shortcuts.
+ */
+int ChContractor::findShortcuts(int v, int settle_limit, Witness& w, std::vector<ChShortcut>* shortcuts) const
+{
+    float max_out = 0;
+    for (const ChArc& arc : out_[v]) max_out = std::max(max_out, arc.cost);
+
+    int count = 0;
+    for (const ChArc& in_arc : in_[v])
+    {
+        int u = in_arc.neighbor;
+        if (++w.round == 0)
+        {
+            std::fill(w.stamp.begin(), w.stamp.end(), 0);
+            std::fill(w.target.begin(), w.target.end(), 0);
+            w.round = 1;
+        }
+        w.targets_left = 0;
+        for (const ChArc& out_arc : out_[v])
+        {
+            if (out_arc.neighbor == u) continue;
+            w.target[out_arc.neighbor] = w.round;
+            w.targets_left++;
+        }
+        if (w.targets_left == 0) continue;
+        witnessSearch(u, v, in_arc.cost + max_out, settle_limit, w);
+
+        for (const ChArc& out_arc : out_[v])
+        {
+            int x = out_arc.neighbor;
+            if (x == u) continue;
+            float via = in_arc.cost + out_arc.cost;
+            if (w.stamp[x] == w.round && w.cost[x] <= via) continue;
+            ++count;
+            if (shortcuts) shortcuts->push_back({u, x, via, v});
+        }
+    }
+    return count;
+}
+
+/**
+ * The priority of contracting a node, lowest first. Mostly its edge
+ * difference, the shortcuts it needs less the arcs it removes, plus terms
+ * for how many of its neighbors are contracted and how high they are in the
+ * hierarchy, so that contraction spreads evenly over the graph.
+ */
+int ChContractor::priority(int v, Witness& w) const
+{
+    int removed = out_[v].size() + in_[v].size();
+    int added = findShortcuts(v, CH_PRIORITY_SETTLE_LIMIT, w, nullptr);
+    return 4 * (added - removed) + deleted_[v] + 2 * level_[v];
+}
+
+bool ChContractor::isLocalMinimum(int v) const
+{
+    auto before = [&](int x) { return priority_[x] < priority_[v] || (priority_[x] == priority_[v] && x < v); };
+    auto beforeAround = [&](int x)
+    {
+        if (before(x)) return true;
+        for (const ChArc& arc : out_[x])
+        {
+            if (arc.neighbor != v && before(arc.neighbor)) return true;
+        }
+        for (const ChArc& arc : in_[x])
+        {
+            if (arc.neighbor != v && before(arc.neighbor)) return true;
+        }
+        return false;
+    };
+    for (const ChArc& arc : out_[v])
+    {
+        if (beforeAround(arc.neighbor)) return false;
+    }
+    for (const ChArc& arc : in_[v])
+    {
+        if (beforeAround(arc.neighbor)) return false;
+    }
+    return true;
+}
+
+ContractionHierarchy ChContractor::build()
+{
+    ContractionHierarchy ch;
+    ch.rank.assign(num_nodes_, -1);
+    std::vector<std::vector<ChArc> > up(num_nodes_), down(num_nodes_);
+
+    parallelFor(num_nodes_, num_threads_, kParallelChunk, [&](int v, int thread)
+    {
+        priority_[v] = priority(v, witnesses_[thread]);
+    });
+
+    std::vector<int> remaining(num_nodes_);
+    for (int v = 0; v < num_nodes_; ++v) remaining[v] = v;
+    std::vector<uint8_t> selected(num_nodes_, 0), touched(num_nodes_, 0);
+    int next_rank = 0;
+    while (!remaining.empty())
+    {
+        // Pick the nodes to contract this round. No two of them are neighbors.
+        parallelFor(remaining.size(), num_threads_, kParallelChunk, [&](int k, int)
+        {
+            selected[k] = isLocalMinimum(remaining[k]);
+        });
+        std::vector<int> batch, rest;
+        for (size_t k = 0; k < remaining.size(); ++k) (selected[k] ? batch : rest).push_back(remaining[k]);
+        for (int v : batch) in_batch_[v] = 1;
+
+        std::vector<std::vector<ChShortcut> > shortcuts(batch.size());
+        parallelFor(batch.size(), num_threads_, kParallelChunk, [&](int k, int thread)
+        {
+            findShortcuts(batch[k], CH_WITNESS_SETTLE_LIMIT, witnesses_[thread], &shortcuts[k]);
+        });
+
+        std::vector<int> neighbors;
+        for (size_t k = 0; k < batch.size(); ++k)
+        {
+            int v = batch[k];
+            ch.rank[v] = next_rank++;
+            for (const ChArc& arc : out_[v]) level_[arc.neighbor] = std::max(level_[arc.neighbor], level_[v] + 1);
+            for (const ChArc& arc : in_[v]) level_[arc.neighbor] = std::max(level_[arc.neighbor], level_[v] + 1);
+            for (const ChArc& arc : out_[v])
+            {
+                removeArc(in_[arc.neighbor], v);
+                neighbors.push_back(arc.neighbor);
+            }
+            for (const ChArc& arc : in_[v])
+            {
+                removeArc(out_[arc.neighbor], v);
+                neighbors.push_back(arc.neighbor);
+            }
+            up[v].swap(out_[v]);
+            down[v].swap(in_[v]);
+            in_batch_[v] = 0;
+        }
+        for (const auto& node_shortcuts : shortcuts)
+        {
+            for (const ChShortcut& s : node_shortcuts) addArc(s.from, s.to, s.cost, s.middle);
+            ch.num_shortcuts += node_shortcuts.size();
+        }
+
+        // Only the neighbors of contracted nodes change priority.
+        std::vector<int> changed;
+        for (int x : neighbors)
+        {
+            deleted_[x]++;
+            if (!touched[x]) changed.push_back(x);
+            touched[x] = 1;
+        }
+        parallelFor(changed.size(), num_threads_, kParallelChunk, [&](int k, int thread)
+        {
+            priority_[changed[k]] = priority(changed[k], witnesses_[thread]);
+        });
+        for (int x : changed) touched[x] = 0;
+
+        remaining.swap(rest);
+        ch.num_levels++;
+    }
+
+    auto compress = [&](std::vector<std::vector<ChArc> >& lists, std::vector<int64_t>& offsets,
+                        std::vector<ChArc>& arcs)
+    {
+        offsets.assign(num_nodes_ + 1, 0);
+        for (int v = 0; v < num_nodes_; ++v) offsets[v + 1] = offsets[v] + lists[v].size();
+        arcs.reserve(offsets.back());
+        for (int v = 0; v < num_nodes_; ++v)
+        {
+            arcs.insert(arcs.end(), lists[v].begin(), lists[v].end());
+            std::vector<ChArc>().swap(lists[v]);
+        }
+    };
+    compress(up, ch.up_offsets, ch.up_arcs);
+    compress(down, ch.down_offsets, ch.down_arcs);
+    return ch;
+}
+
+ContractionHierarchy buildContractionHierarchy(const Graph& g, int num_threads)
+{
+    return ChContractor(g, threadCount(num_threads)).build();
+}
+
+/**
+ * Finds the arc of a hierarchy from a to b, which is an up arc of a if b was
+ * contracted later and a down arc of b otherwise.
+ */
+static const ChArc* findChArc(int a, int b, const ContractionHierarchy& ch)
+{
+    if (ch.rank[b] > ch.rank[a])
+    {
+        for (int64_t k = ch.up_offsets[a]; k < ch.up_offsets[a + 1]; ++k)
+        {
+            if (ch.up_arcs[k].neighbor == b) return &ch.up_arcs[k];
+        }
+    }
+    else
+    {
+        for (int64_t k = ch.down_offsets[b]; k < ch.down_offsets[b + 1]; ++k)
+        {
+            if (ch.down_arcs[k].neighbor == a) return &ch.down_arcs[k];
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Appends the nodes after a on the path of the arc from a to b, replacing
+ * shortcuts by the arcs they skip.
+ */
+static void unpackChArc(int a, int b, const ContractionHierarchy& ch, std::vector<int>& path)
+{
+    std::vector<std::pair<int, int> > stack = {{a, b}};
+    while (!stack.empty())
+    {
+        int from = stack.back().first, to = stack.back().second;
+        stack.pop_back();
+        const ChArc* arc = findChArc(from, to, ch);
+        if (arc->middle < 0)
+        {
+            path.push_back(to);
+            continue;
+        }
+        stack.push_back({arc->middle, to});
+        stack.push_back({from, arc->middle});
+    }
+}
+
+std::vector<int> chQuery(int start, int goal, const ContractionHierarchy& ch, ChQueryState& state)
+{
+    int num_nodes = ch.rank.size();
+    if (state.stamp[0].size() != static_cast<size_t>(num_nodes))
+    {
+        for (int d = 0; d < 2; ++d)
+        {
+            state.cost[d].assign(num_nodes, 0);
+            state.parent[d].assign(num_nodes, -1);
+            state.stamp[d].assign(num_nodes, 0);
+        }
+        state.round = 0;
+    }
+    if (++state.round == 0)
+    {
+        for (int d = 0; d < 2; ++d) std::fill(state.stamp[d].begin(), state.stamp[d].end(), 0);
+        state.round = 1;
+    }
+    state.settled = 0;
+    state.path_cost = std::numeric_limits<double>::infinity();
+    if (start < 0 || start >= num_nodes || goal < 0 || goal >= num_nodes) return {};
+
+    for (int d = 0; d < 2; ++d)
+    {
+        int source = d == 0 ? start : goal;
+        state.heap[d].clear();
+        state.heap[d].push_back({0, source});
+        state.stamp[d][source] = state.round;
+        state.cost[d][source] = 0;
+        state.parent[d][source] = -1;
+    }
+
+    // Both searches only go up the hierarchy, so they can stop once the
+    // nearest node left is no closer than the best path through a node both
+    // have reached.
+    double best = std::numeric_limits<double>::infinity();
+    int meet = -1;
+    while (!state.heap[0].empty() || !state.heap[1].empty())
+    {
+        int d = state.heap[1].empty() || (!state.heap[0].empty() && state.heap[0][0].first <= state.heap[1][0].first)
+                    ? 0 : 1;
+        if (state.heap[d][0].first >= best) break;
+        std::vector<std::pair<double, int> >& heap = state.heap[d];
+        std::pop_heap(heap.begin(), heap.end(), LaterEntry());
+        double cost = heap.back().first;
+        int u = heap.back().second;
+        heap.pop_back();
+        if (cost > state.cost[d][u]) continue;
+        state.settled++;
+
+        if (state.stamp[1 - d][u] == state.round && cost + state.cost[1 - d][u] < best)
+        {
+            best = cost + state.cost[1 - d][u];
+            meet = u;
+        }
+
+        const std::vector<int64_t>& offsets = d == 0 ? ch.up_offsets : ch.down_offsets;
+        const std::vector<ChArc>& arcs = d == 0 ? ch.up_arcs : ch.down_arcs;
+        for (int64_t k = offsets[u]; k < offsets[u + 1]; ++k)
+        {
+            int x = arcs[k].neighbor;
+            double new_cost = cost + arcs[k].cost;
+            if (new_cost >= best) continue;
+            if (state.stamp[d][x] == state.round && new_cost >= state.cost[d][x]) continue;
+            state.stamp[d][x] = state.round;
+            state.cost[d][x] = new_cost;
+            state.parent[d][x] = u;
+            heap.push_back({new_cost, x});
+            std::push_heap(heap.begin(), heap.end(), LaterEntry());
+        }
+    }
+    if (meet < 0) return {};
+
+    // The nodes of the hierarchy path, then the arcs between them unpacked.
+    std::vector<int> nodes;
+    for (int n = meet; n != -1; n = state.parent[0][n]) nodes.push_back(n);
+    std::reverse(nodes.begin(), nodes.end());
+    for (int n = state.parent[1][meet]; n != -1; n = state.parent[1][n]) nodes.push_back(n);
+
+    std::vector<int> path = {start};
+    for (size_t k = 0; k + 1 < nodes.size(); ++k) unpackChArc(nodes[k], nodes[k + 1], ch, path);
+    state.path_cost = best;
+    return path;
+}
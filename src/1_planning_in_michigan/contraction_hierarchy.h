@@ -0,0 +1,84 @@
+#ifndef CONTRACTION_HIERARCHY_H
+#define CONTRACTION_HIERARCHY_H
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "planning.h"
+
+#define CH_WITNESS_SETTLE_LIMIT 500     // The most nodes a witness search settles before giving up.
+#define CH_PRIORITY_SETTLE_LIMIT 50     // The same when only estimating the shortcuts of a node.
+
+/**
+ * An arc of a contraction hierarchy. Shortcuts replace the two arcs through
+ * the node they skip, u -> middle -> neighbor.
+ */
+struct ChArc
+{
+    int neighbor;
+    float cost;
+    int middle;     // The node the shortcut skips, or -1 for an arc of the graph.
+};
+
+/**
+ * A contraction hierarchy of a graph. Nodes are contracted one level at a
+ * time in order of edge difference, adding shortcuts between their neighbors
+ * where no other path is as short. A query then only needs to follow arcs
+ * to nodes contracted later, from both ends.
+ *
+ * Both sets of arcs are stored in compressed sparse row form, like Graph. The
+ * up arcs of u are the arcs u -> v with rank[v] > rank[u]. The down arcs of u
+ * are the arcs v -> u with rank[v] > rank[u], stored with neighbor v.
+ */
+struct ContractionHierarchy
+{
+    std::vector<int> rank;              // The order each node was contracted in.
+    std::vector<int64_t> up_offsets;
+    std::vector<ChArc> up_arcs;
+    std::vector<int64_t> down_offsets;
+    std::vector<ChArc> down_arcs;
+    int64_t num_shortcuts = 0;
+    int num_levels = 0;                 // The number of rounds of contraction.
+};
+
+/**
+ * The state of a contraction hierarchy query, reused across queries like
+ * GraphSearchState. Index 0 is the forward search and 1 the backward search.
+ */
+struct ChQueryState
+{
+    std::vector<double> cost[2];
+    std::vector<int> parent[2];
+    std::vector<uint32_t> stamp[2];
+    std::vector<std::pair<double, int> > heap[2];
+    uint32_t round = 0;
+    int settled = 0;            // The nodes settled by the last query, in both directions.
+    double path_cost = std::numeric_limits<double>::infinity();    // The cost of the path found by the last query.
+};
+
+/**
+ * Builds a contraction hierarchy of a graph. Each round contracts a set of
+ * nodes with no arcs between them, those with lower edge difference than all
+ * of their neighbors. The witness searches of a round and the updates of the
+ * edge differences after it run in parallel. The hierarchy is the same for
+ * any number of threads.
+ * @param  g The graph.
+ * @param  num_threads The number of threads to use, or 0 for one per core.
+ * @return  The hierarchy.
+ */
+ContractionHierarchy buildContractionHierarchy(const Graph& g, int num_threads = 0);
+
+/**
+ * Finds the lowest cost path from a starting node to a goal node with a
+ * bidirectional search of a contraction hierarchy. Shortcuts are unpacked,
+ * so the path only uses arcs of the graph and can be passed to printPath().
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node.
+ * @param  ch The hierarchy of the graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+std::vector<int> chQuery(int start, int goal, const ContractionHierarchy& ch, ChQueryState& state);
+
+#endif  // CONTRACTION_HIERARCHY_H
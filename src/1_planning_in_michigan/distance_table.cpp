@@ -0,0 +1,98 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "distance_table.h"
+#include "parallel_for.h"
+
+/**
+ * Sources are handed to threads one at a time, since each is a whole search.
+ */
+static const int kSourceChunk = 1;
+
+DistanceTable distanceTable(const std::vector<int>& sources, const std::vector<int>& targets, const Graph& g,
+                            bool with_paths, int num_threads)
+{
+    DistanceTable table;
+    table.sources = sources;
+    table.targets = targets;
+    size_t num_targets = targets.size();
+    table.cost.assign(sources.size() * num_targets, std::numeric_limits<double>::infinity());
+
+    int num_nodes = numNodes(g);
+    std::vector<uint8_t> is_target(num_nodes, 0);
+    int num_distinct = 0;
+    for (int t : targets)
+    {
+        if (t < 0 || t >= num_nodes || is_target[t]) continue;
+        is_target[t] = 1;
+        num_distinct++;
+    }
+
+    // The paths of each row are built by the thread that searched from its
+    // source, then joined in order.
+    std::vector<std::vector<int> > row_nodes(with_paths ? sources.size() : 0);
+    std::vector<std::vector<int64_t> > row_lengths(with_paths ? sources.size() : 0);
+
+    num_threads = threadCount(num_threads);
+    std::vector<GraphSearchState> states(num_threads);
+    parallelFor(sources.size(), num_threads, kSourceChunk, [&](int i, int thread)
+    {
+        GraphSearchState& state = states[thread];
+        bool searched = num_distinct > 0 && sources[i] >= 0 && sources[i] < num_nodes;
+        if (searched)
+        {
+            // Dijkstra from the source, stopped once every target is settled.
+            int reached = 0;
+            heuristicSearch(sources[i], -1, g, state, [](int) { return 0.0; },
+                            [&](int n) { return is_target[n] && ++reached == num_distinct; });
+        }
+        double* row = &table.cost[i * num_targets];
+        for (size_t j = 0; j < num_targets; ++j)
+        {
+            int t = targets[j];
+            bool reached = searched && t >= 0 && t < num_nodes && state.stamp[t] == state.round;
+            if (reached) row[j] = state.cost[t];
+            if (!with_paths) continue;
+
+            std::vector<int>& nodes = row_nodes[i];
+            size_t begin = nodes.size();
+            if (reached)
+            {
+                for (int n = t; n != -1; n = state.parent[n]) nodes.push_back(n);
+                std::reverse(nodes.begin() + begin, nodes.end());
+            }
+            row_lengths[i].push_back(nodes.size() - begin);
+        }
+    });
+
+    if (with_paths)
+    {
+        table.path_offsets.reserve(table.cost.size() + 1);
+        table.path_offsets.push_back(0);
+        size_t total = 0;
+        for (const std::vector<int>& nodes : row_nodes) total += nodes.size();
+        table.path_nodes.reserve(total);
+        for (size_t i = 0; i < sources.size(); ++i)
+        {
+            for (int64_t length : row_lengths[i]) table.path_offsets.push_back(table.path_offsets.back() + length);
+            table.path_nodes.insert(table.path_nodes.end(), row_nodes[i].begin(), row_nodes[i].end());
+            std::vector<int>().swap(row_nodes[i]);
+        }
+    }
+    return table;
+}
+
+std::vector<int> tablePath(int i, int j, const DistanceTable& table)
+{
+    if (table.path_offsets.empty() || i < 0 || static_cast<size_t>(i) >= table.sources.size() || j < 0 ||
+        static_cast<size_t>(j) >= table.targets.size())
+    {
+        return {};
+    }
+    size_t k = static_cast<size_t>(i) * table.targets.size() + j;
+    return std::vector<int>(table.path_nodes.begin() + table.path_offsets[k],
+                            table.path_nodes.begin() + table.path_offsets[k + 1]);
+}
@@ -0,0 +1,61 @@
+#ifndef DISTANCE_TABLE_H
+#define DISTANCE_TABLE_H
+
+#include <vector>
+#include <cstdint>
+
+#include "planning.h"
+
+/**
+ * The lowest path costs from a set of source nodes to a set of target nodes,
+ * with the paths themselves if they were asked for.
+ *
+ * Costs are stored row by row in one block, so the costs from a source are
+ * contiguous: cost[i * targets.size() + j] is the cost from sources[i] to
+ * targets[j], or infinity if there is no path. Paths are stored in compressed
+ * sparse row form in the same order, the path of (i, j) being the nodes
+ * path_nodes[path_offsets[k]] to path_nodes[path_offsets[k + 1] - 1] with
+ * k = i * targets.size() + j. A missing path is empty.
+ */
+struct DistanceTable
+{
+    std::vector<int> sources;
+    std::vector<int> targets;
+    std::vector<double> cost;
+    std::vector<int64_t> path_offsets;  // Empty if the paths were not asked for.
+    std::vector<int> path_nodes;
+
+    /**
+     * Gets the cost from a source to a target.
+     * @param  i The row of the source in sources.
+     * @param  j The column of the target in targets.
+     * @return  The lowest path cost, or infinity if there is no path.
+     */
+    double at(int i, int j) const { return cost[static_cast<size_t>(i) * targets.size() + j]; }
+};
+
+/**
+ * Finds the lowest path costs from every source to every target. Runs one
+ * Dijkstra search per source, stopping once it has reached every target, on
+ * a pool of threads that each reuse one search state. Sources or targets
+ * that are not nodes of the graph have no paths.
+ * @param  sources The indices of the source nodes.
+ * @param  targets The indices of the target nodes.
+ * @param  g The associated graph.
+ * @param  with_paths Whether to also store the paths.
+ * @param  num_threads The number of threads to use, or 0 for one per core.
+ * @return  The table of costs.
+ */
+DistanceTable distanceTable(const std::vector<int>& sources, const std::vector<int>& targets, const Graph& g,
+                            bool with_paths = false, int num_threads = 0);
+
+/**
+ * Gets a path stored in a distance table.
+ * @param  i The row of the source in sources.
+ * @param  j The column of the target in targets.
+ * @param  table A table built with paths.
+ * @return  A list of indicies of nodes that form a path from the source to the target.
+ */
+std::vector<int> tablePath(int i, int j, const DistanceTable& table);
+
+#endif  // DISTANCE_TABLE_H
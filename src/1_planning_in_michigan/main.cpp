@@ -5,6 +5,9 @@
 #include <iostream>
 
 #include "planning.h"
+#include "contraction_hierarchy.h"
+#include "alt_landmarks.h"
+#include "distance_table.h"
 
 int main(int argc, char **argv) {
     // Load the graph from a file.
@@ -12,11 +15,11 @@ int main(int argc, char **argv) {
     // Alternate graph file option:
     // Graph g = createGraph("data/planning_in_michigan/bereaf23_graph.txt");
 
-    int start = nameToIdx("ann_arbor", g.data);
-    int goal = nameToIdx("flint", g.data);
+    int start = nameToIdx("ann_arbor", g);
+    int goal = nameToIdx("flint", g);
     // Alternate start and goal options:
-    // int start = nameToIdx("roseville", g.data);
-    // int goal = nameToIdx("saipan", g.data);
+    // int start = nameToIdx("roseville", g);
+    // int goal = nameToIdx("saipan", g);
     std::vector<int> path;
 
     // Display neighbors of the start node.
@@ -50,5 +53,40 @@ int main(int argc, char **argv) {
     path = dfs(start, goal, g);
     printPath(path, g);
 
+    // Dijkstra Pathfinding
+    std::cout << "Dijkstra:\n";
+    GraphSearchState state;
+    path = dijkstra(start, goal, g, state);
+    printPath(path, g);
+    std::cout << "Cost: " << pathCost(goal, state) << "\n";
+
+    // Contraction Hierarchy Pathfinding
+    std::cout << "Contraction hierarchy:\n";
+    ContractionHierarchy ch = buildContractionHierarchy(g);
+    ChQueryState query;
+    path = chQuery(start, goal, ch, query);
+    printPath(path, g);
+    std::cout << "Cost: " << query.path_cost << "\n";
+
+    // ALT Pathfinding, A* on landmark lower bounds since the graph has no coordinates.
+    std::cout << "ALT A*:\n";
+    AltLandmarks alt = selectLandmarks(g, 4);
+    path = altAStar(start, goal, g, alt, state);
+    printPath(path, g);
+    std::cout << "Cost: " << pathCost(goal, state) << " (" << state.expanded << " nodes expanded)\n";
+
+    // Distance table between a few cities, one search per row.
+    std::vector<int> cities;
+    for (const char* name : {"ann_arbor", "flint", "detroit", "lansing"}) {
+        if (nameToIdx(name, g) >= 0) cities.push_back(nameToIdx(name, g));
+    }
+    std::cout << "Distance table:\n";
+    DistanceTable table = distanceTable(cities, cities, g);
+    for (size_t i = 0; i < cities.size(); ++i) {
+        std::cout << g.data[cities[i]] << ":";
+        for (size_t j = 0; j < cities.size(); ++j) std::cout << " " << table.at(i, j);
+        std::cout << "\n";
+    }
+
     return 0;
 }
@@ -0,0 +1,55 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+/**
+ * Calls fn(k, thread) for k from 0 to count - 1, on up to num_threads
+ * threads. Each thread takes the next chunk of indices when it is done, so
+ * uneven work is balanced, and thread is the index of the calling thread
+ * from 0 to num_threads - 1 for per thread scratch space.
+ * @param  count The number of indices.
+ * @param  num_threads The number of threads to use.
+ * @param  chunk The number of indices a thread takes at a time.
+ * @param  fn The function to call.
+ */
+template <typename Fn>
+void parallelFor(int count, int num_threads, int chunk, Fn fn)
+{
+    if (num_threads <= 1 || count <= chunk)
+    {
+        for (int k = 0; k < count; ++k) fn(k, 0);
+        return;
+    }
+    std::atomic<int> next(0);
+    auto work = [&](int thread)
+    {
+        while (true)
+        {
+            int begin = next.fetch_add(chunk);
+            if (begin >= count) return;
+            int end = std::min(count, begin + chunk);
+            for (int k = begin; k < end; ++k) fn(k, thread);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; ++t) threads.emplace_back(work, t);
+    work(0);
+    for (std::thread& t : threads) t.join();
+}
+
+/**
+ * Gets the number of threads to use for a requested number.
+ * @param  num_threads The requested number, or 0 or less for one per core.
+ * @return  The number of threads, at least 1.
+ */
+inline int threadCount(int num_threads)
+{
+    if (num_threads <= 0) num_threads = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, num_threads);
+}
+
+#endif  // PARALLEL_FOR_H
@@ -1,7 +1,13 @@
+#include <cmath>
 #include <queue>
 #include <stack>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
 #include <vector>
 #include <string>
+#include <limits>
 #include <fstream>
 #include <iostream>
 #include <algorithm>
@@ -19,9 +25,271 @@ void printPath(std::vector<int>& path, Graph& g) {
 
    std::cout << "Path: ";
    for (int i = 0; i < path.size() - 1; i++) {
-       std::cout << g.data[path[i]] << " -> ";
+       std::cout << nodeName(path[i], g) << " -> ";
    }
-   std::cout << g.data[path.back()] << "\n";
+   std::cout << nodeName(path.back(), g) << "\n";
+}
+
+
+int nameToIdx(const std::string& name, const Graph& g) {
+   if (g.data.empty()) {
+       // DIMACS nodes are named by their 1-based id.
+       char* end = nullptr;
+       long id = std::strtol(name.c_str(), &end, 10);
+       if (name.empty() || *end != '\0' || id < 1 || id > numNodes(g)) return -1;
+       return static_cast<int>(id - 1);
+   }
+   auto found = g.name_to_idx.find(name);
+   return found == g.name_to_idx.end() ? -1 : found->second;
+}
+
+
+std::string nodeName(int n, const Graph& g) {
+   if (n < static_cast<int>(g.data.size())) return g.data[n];
+   return std::to_string(n + 1);
+}
+
+
+void buildGraphArcs(int num_nodes, const std::vector<int>& sources, const std::vector<GraphArc>& arcs, Graph& g) {
+   // A counting sort by source, which keeps arcs from the same node in order.
+   g.offsets.assign(num_nodes + 1, 0);
+   for (int source : sources) g.offsets[source + 1]++;
+   for (int n = 0; n < num_nodes; n++) g.offsets[n + 1] += g.offsets[n];
+
+   std::vector<int64_t> next(g.offsets.begin(), g.offsets.end() - 1);
+   g.arcs.resize(arcs.size());
+   for (size_t k = 0; k < arcs.size(); k++) {
+       g.arcs[next[sources[k]]++] = arcs[k];
+   }
+}
+
+
+Graph createGraph(std::string file_path) {
+   Graph g;
+   std::ifstream in(file_path);
+   if (!in.is_open()) {
+       std::cerr << "ERROR: Failed to load graph from " << file_path << std::endl;
+       return g;
+   }
+
+   std::string s = "";
+   int N = 0;
+   while (in && s != "NODES") in >> s >> N;
+
+   g.data.reserve(N);
+   g.name_to_idx.reserve(N);
+   for (int i = 0; i < N && in >> s; i++) {
+       g.name_to_idx.emplace(s, i);
+       g.data.push_back(s);
+   }
+
+   while (in && s != "EDGES") in >> s >> N;
+   if (!in) {
+       std::cerr << "ERROR: No EDGES in graph file " << file_path << std::endl;
+       return Graph();
+   }
+
+   std::vector<int> sources;
+   std::vector<GraphArc> arcs;
+   sources.reserve(2 * N);
+   arcs.reserve(2 * N);
+   std::string city1, city2;
+   float dist;
+   for (int i = 0; i < N && in >> city1 >> city2 >> dist; i++) {
+       int c1 = nameToIdx(city1, g);
+       int c2 = nameToIdx(city2, g);
+       if (c1 < 0 || c2 < 0) {
+           std::cerr << "ERROR: Unknown node in edge " << city1 << " " << city2 << " of " << file_path << std::endl;
+           return Graph();
+       }
+       sources.push_back(c1);
+       arcs.push_back({c2, dist});
+       sources.push_back(c2);
+       arcs.push_back({c1, dist});
+   }
+
+   buildGraphArcs(g.data.size(), sources, arcs, g);
+   return g;
+}
+
+
+/**
+ * Reads whole lines from a file in large blocks, for the DIMACS files, which
+ * can have tens of millions of lines.
+ */
+class LineReader {
+public:
+   explicit LineReader(FILE* file) : file_(file), buffer_(1 << 20), begin_(0), end_(0) {}
+
+   /**
+    * Gets the next line, without its newline. The line stays valid until the
+    * next call. Returns nullptr at the end of the file.
+    */
+   const char* next() {
+       while (true) {
+           char* newline = static_cast<char*>(std::memchr(buffer_.data() + begin_, '\n', end_ - begin_));
+           if (newline != nullptr) {
+               *newline = '\0';
+               const char* line = buffer_.data() + begin_;
+               begin_ = newline + 1 - buffer_.data();
+               return line;
+           }
+           if (!fill()) {
+               if (begin_ == end_) return nullptr;
+               // The last line has no newline.
+               buffer_[end_] = '\0';
+               const char* line = buffer_.data() + begin_;
+               begin_ = end_;
+               return line;
+           }
+       }
+   }
+
+private:
+   bool fill() {
+       std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+       end_ -= begin_;
+       begin_ = 0;
+       if (end_ + 1 >= buffer_.size()) buffer_.resize(2 * buffer_.size());
+       size_t read = std::fread(buffer_.data() + end_, 1, buffer_.size() - end_ - 1, file_);
+       end_ += read;
+       return read > 0;
+   }
+
+   FILE* file_;
+   std::vector<char> buffer_;
+   size_t begin_, end_;
+};
+
+
+/**
+ * Reads a DIMACS coordinate file into the coordinates of a graph.
+ */
+static bool readDimacsCoordinates(const std::string& co_path, Graph& g) {
+   FILE* file = std::fopen(co_path.c_str(), "rb");
+   if (file == nullptr) {
+       std::cerr << "ERROR: Failed to load coordinates from " << co_path << std::endl;
+       return false;
+   }
+   std::unique_ptr<FILE, int (*)(FILE*)> closer(file, std::fclose);
+
+   int num_nodes = numNodes(g);
+   g.x.assign(num_nodes, 0);
+   g.y.assign(num_nodes, 0);
+   LineReader reader(file);
+   while (const char* line = reader.next()) {
+       if (line[0] != 'v') continue;
+       char* end = nullptr;
+       long id = std::strtol(line + 1, &end, 10);
+       double x = std::strtod(end, &end);
+       double y = std::strtod(end, &end);
+       if (id < 1 || id > num_nodes) {
+           std::cerr << "ERROR: Bad node " << id << " in " << co_path << std::endl;
+           return false;
+       }
+       g.x[id - 1] = x;
+       g.y[id - 1] = y;
+   }
+   return true;
+}
+
+
+Graph createGraphFromDimacs(const std::string& gr_path, const std::string& co_path) {
+   Graph g;
+   FILE* file = std::fopen(gr_path.c_str(), "rb");
+   if (file == nullptr) {
+       std::cerr << "ERROR: Failed to load graph from " << gr_path << std::endl;
+       return g;
+   }
+   std::unique_ptr<FILE, int (*)(FILE*)> closer(file, std::fclose);
+
+   long num_nodes = -1;
+   std::vector<int> sources;
+   std::vector<GraphArc> arcs;
+   LineReader reader(file);
+   while (const char* line = reader.next()) {
+       char* end = nullptr;
+       if (line[0] == 'p') {
+           // "p sp <nodes> <arcs>"
+           const char* counts = line + 1;
+           while (*counts == ' ' || *counts == '\t') counts++;
+           if (counts[0] == 's' && counts[1] == 'p') counts += 2;
+           num_nodes = std::strtol(counts, &end, 10);
+           long num_arcs = std::strtol(end, &end, 10);
+           if (num_nodes < 0 || num_arcs < 0) break;
+           sources.reserve(num_arcs);
+           arcs.reserve(num_arcs);
+       } else if (line[0] == 'a') {
+           long from = std::strtol(line + 1, &end, 10);
+           long to = std::strtol(end, &end, 10);
+           float cost = std::strtod(end, &end);
+           if (num_nodes < 0 || from < 1 || from > num_nodes || to < 1 || to > num_nodes) {
+               std::cerr << "ERROR: Bad arc " << from << " " << to << " in " << gr_path << std::endl;
+               return Graph();
+           }
+           sources.push_back(from - 1);
+           arcs.push_back({static_cast<int>(to - 1), cost});
+       }
+   }
+   if (num_nodes < 0) {
+       std::cerr << "ERROR: No problem line in " << gr_path << std::endl;
+       return Graph();
+   }
+
+   buildGraphArcs(num_nodes, sources, arcs, g);
+   if (!co_path.empty()) {
+       if (!readDimacsCoordinates(co_path, g)) return Graph();
+       setHeuristicScale(g);
+   }
+   return g;
+}
+
+
+void setHeuristicScale(Graph& g) {
+   g.heuristic_scale = 0;
+   if (g.x.size() != static_cast<size_t>(numNodes(g))) return;
+
+   double scale = HUGE_VAL;
+   for (int n = 0; n < numNodes(g); n++) {
+       for (const GraphArc& arc : arcsOf(n, g)) {
+           double distance = std::hypot(g.x[arc.neighbor] - g.x[n], g.y[arc.neighbor] - g.y[n]);
+           if (distance > 0) scale = std::min(scale, arc.cost / distance);
+       }
+   }
+   // Leave a little room for the rounding of the float costs.
+   if (scale != HUGE_VAL) g.heuristic_scale = std::max(0.0, scale * (1 - 1e-6));
+}
+
+
+std::vector<int> dijkstra(int start, int goal, const Graph& g, GraphSearchState& state) {
+   // A goal of -1 would make heuristicSearch() search every node, see dijkstraAll().
+   if (goal < 0) return {};
+   return heuristicSearch(start, goal, g, state, [](int) { return 0.0; });
+}
+
+
+void dijkstraAll(int start, const Graph& g, GraphSearchState& state) {
+   heuristicSearch(start, -1, g, state, [](int) { return 0.0; });
+}
+
+
+std::vector<int> aStar(int start, int goal, const Graph& g, GraphSearchState& state) {
+   int num_nodes = numNodes(g);
+   if (g.heuristic_scale <= 0 || g.x.size() != static_cast<size_t>(num_nodes) || goal < 0 || goal >= num_nodes) {
+       return dijkstra(start, goal, g, state);
+   }
+   double goal_x = g.x[goal], goal_y = g.y[goal];
+   return heuristicSearch(start, goal, g, state, [&](int n) {
+       return g.heuristic_scale * std::hypot(goal_x - g.x[n], goal_y - g.y[n]);
+   });
+}
+
+
+double pathCost(int goal, const GraphSearchState& state) {
+   if (goal < 0 || goal >= static_cast<int>(state.stamp.size()) || state.stamp[goal] != state.round) {
+       return std::numeric_limits<double>::infinity();
+   }
+   return state.cost[goal];
 }
 
 
@@ -40,12 +308,18 @@ std::vector<int> tracePath(int n, Graph& g) {
 
 
 std::vector<int> getNeighbors(int n, Graph& g) {
-   return g.edges[n];
+   std::vector<int> neighbors;
+   neighbors.reserve(arcsOf(n, g).size());
+   for (const GraphArc& arc : arcsOf(n, g)) neighbors.push_back(arc.neighbor);
+   return neighbors;
 }
 
 
 std::vector<float> getEdgeCosts(int n, Graph& g) {
-   return g.edge_costs[n];
+   std::vector<float> costs;
+   costs.reserve(arcsOf(n, g).size());
+   for (const GraphArc& arc : arcsOf(n, g)) costs.push_back(arc.cost);
+   return costs;
 }
 
 
@@ -55,13 +329,23 @@ int getParent(int n, Graph& g) {
 
 
 void initGraph(Graph& g) {
+   if (g.nodes.size() == static_cast<size_t>(numNodes(g))) {
+       for (Node& n : g.nodes) {
+           n.parent = -1;
+           n.visited = false;
+           n.cost = std::numeric_limits<double>::infinity();
+       }
+       return;
+   }
+
    g.nodes.clear();
-   for (int i = 0; i < g.data.size(); i++) {
+   g.nodes.reserve(numNodes(g));
+   for (int i = 0; i < numNodes(g); i++) {
        Node n;
-       n.city = g.data[i];
+       if (i < static_cast<int>(g.data.size())) n.city = g.data[i];
        n.parent = -1;
        n.visited = false;
-       n.cost = HIGH;
+       n.cost = std::numeric_limits<double>::infinity();
        g.nodes.push_back(n);
    }
 }
@@ -91,10 +375,10 @@ std::vector<int> bfs(int start, int goal, Graph& g) {
        }
 
 
-       for (size_t i = 0; i < getNeighbors(current, g).size(); i++) {
-           int neighbor = g.edges[current][i];
-           float edge_cost = g.edge_costs[current][i];
-           float new_cost = g.nodes[current].cost + edge_cost;
+       for (const GraphArc& arc : arcsOf(current, g)) {
+           int neighbor = arc.neighbor;
+           float edge_cost = arc.cost;
+           double new_cost = g.nodes[current].cost + edge_cost;
 
 
            if (new_cost < g.nodes[neighbor].cost) {
@@ -117,6 +401,7 @@ std::vector<int> dfs(int start, int goal, Graph& g) {
    std::stack<int> visit_stack;
    visit_stack.push(start);
    g.nodes[start].cost = 0;
+   g.nodes[start].visited = true;
 
 
    while (!visit_stack.empty()) {
@@ -129,10 +414,10 @@ std::vector<int> dfs(int start, int goal, Graph& g) {
        }
 
 
-       for (size_t i = 0; i < getNeighbors(current, g).size(); i++) {
-           int neighbor = g.edges[current][i];
-           float edge_cost = g.edge_costs[current][i];
-           float new_cost = g.nodes[current].cost + edge_cost;
+       for (const GraphArc& arc : arcsOf(current, g)) {
+           int neighbor = arc.neighbor;
+           float edge_cost = arc.cost;
+           double new_cost = g.nodes[current].cost + edge_cost;
 
 
            if (!g.nodes[neighbor].visited || new_cost < g.nodes[neighbor].cost) {
@@ -7,7 +7,12 @@
 #include <string>
 #include <fstream>
 #include <iostream>
+#include <cmath>
+#include <limits>
+#include <cstdint>
 #include <algorithm>
+#include <utility>
+#include <unordered_map>
 
 #define HIGH 1e6
 
@@ -19,7 +24,7 @@ struct Node
     std::string city;
     int parent = -1;       
     bool visited = false;
-    float cost = HIGH; 
+    double cost = std::numeric_limits<double>::infinity();
     
     // *** Task: Add variables necessary for running your search algorithms *** //
 
@@ -27,33 +32,113 @@ struct Node
 };
 
 /**
- * Graph to store Nodes and their connectivity. 
+ * An edge leaving a node, stored next to its cost so that walking the
+ * neighbors of a node reads one contiguous block of memory.
+ */
+struct GraphArc
+{
+    int neighbor;
+    float cost;
+};
+
+/**
+ * Graph to store Nodes and their connectivity. The edges are stored in
+ * compressed sparse row form: the arcs leaving node n are
+ * arcs[offsets[n]] to arcs[offsets[n + 1] - 1].
  */
 struct Graph
 {
     std::vector<Node> nodes;
-    std::vector<std::string> data;
-    std::vector<std::vector<int> > edges;
-    std::vector<std::vector<float> > edge_costs;
+    std::vector<std::string> data;                      // The name of each node. Empty for DIMACS graphs.
+    std::unordered_map<std::string, int> name_to_idx;   // The index of each name in data.
+    std::vector<int64_t> offsets;                       // Where the arcs of each node start, plus the total.
+    std::vector<GraphArc> arcs;
+    std::vector<double> x, y;                           // Coordinates of each node, if the graph has them.
+    double heuristic_scale = 0;                         // The least cost per unit of straight line distance of any arc.
 };
 
 /**
- * Converts a nodes name to its associated index.
- * @param  name The name of the node.
- * @param  v A vector of all the names of the nodes in a graph in order.
- * @return  The index of the name in v. 
+ * The arcs leaving a node, viewed in place in a graph. Valid until the graph
+ * changes.
  */
-static int nameToIdx(std::string name, std::vector<std::string>& v)
+struct GraphArcs
 {
-    for (int i = 0; i < v.size(); i++)
+    const GraphArc* first;
+    const GraphArc* last;
+
+    const GraphArc* begin() const { return first; }
+    const GraphArc* end() const { return last; }
+    size_t size() const { return last - first; }
+    bool empty() const { return first == last; }
+    const GraphArc& operator[](size_t k) const { return first[k]; }
+};
+
+/**
+ * Gets the arcs leaving a node without copying them.
+ * @param  n The index of the node.
+ * @param  g The associated graph.
+ * @return  The arcs, in the order getNeighbors() lists them.
+ */
+static inline GraphArcs arcsOf(int n, const Graph& g)
+{
+    return {g.arcs.data() + g.offsets[n], g.arcs.data() + g.offsets[n + 1]};
+}
+
+/**
+ * The state of a search on a graph, kept apart from the graph so that a
+ * const graph can be searched by several queries, one state each. A state is
+ * reused across queries without clearing its arrays: each entry is only valid
+ * if its stamp matches the round of the current query.
+ */
+struct GraphSearchState
+{
+    std::vector<double> cost;                   // Summed in double, as road network paths exceed float precision.
+    std::vector<double> estimate;               // The heuristic of each node, computed once per query.
+    std::vector<int> parent;
+    std::vector<uint32_t> stamp;
+    std::vector<std::pair<double, int> > heap;  // (priority, node), a min heap.
+    uint32_t round = 0;
+    int expanded = 0;                           // The nodes expanded by the last query.
+};
+
+/**
+ * Orders (priority, node) heap entries for the std heap functions, so that
+ * the lowest priority is on top.
+ */
+struct LaterEntry
+{
+    template <typename Entry>
+    bool operator()(const Entry& a, const Entry& b) const
     {
-        if (v[i] == name) return i;
+        return a.first > b.first;
     }
-    return -1;
 };
 
 /**
- * Creates a graph form a serialized graph file in the format below. 
+ * Gets the number of nodes in a graph.
+ */
+static inline int numNodes(const Graph& g)
+{
+    return g.offsets.empty() ? 0 : static_cast<int>(g.offsets.size()) - 1;
+}
+
+/**
+ * Converts a nodes name to its associated index with the graph's hash map.
+ * Nodes of DIMACS graphs are named by their 1-based DIMACS id.
+ * @param  name The name of the node.
+ * @param  g The graph the node is in.
+ * @return  The index of the node, or -1 if there is no node with that name.
+ */
+int nameToIdx(const std::string& name, const Graph& g);
+
+/**
+ * Gets the name of a node, its 1-based id for DIMACS graphs.
+ */
+std::string nodeName(int n, const Graph& g);
+
+/**
+ * Creates a graph form a serialized graph file in the format below. Edges
+ * are undirected, so each one is stored as an arc in both directions.
  * 
  *  NODES
  *  node1
@@ -66,48 +151,32 @@ static int nameToIdx(std::string name, std::vector<std::string>& v)
  *  ...
  * 
  * @param  file_path The relative path to the graph file.
- * @return  A graph with the structure described in the file.
+ * @return  A graph with the structure described in the file, empty if the
+ *          file cannot be read or names an unknown node.
  */
-static Graph createGraph(std::string file_path)
-{
-    Graph g;
-    std::ifstream in(file_path);
-    if (!in.is_open())
-    {
-        std::cerr << "ERROR: Failed to load graph from " << file_path << std::endl;
-        return g;
-    }
+Graph createGraph(std::string file_path);
 
-    std::string s = "";
-    int N = 0;
-    while (s != "NODES") in >> s >> N;
-
-    for (int i = 0; i < N; i++)
-    {
-        in >> s;
-        g.data.push_back(s);
-    }
-
-    g.edges = std::vector<std::vector<int> >(N, std::vector<int>());
-    g.edge_costs = std::vector<std::vector<float> >(N, std::vector<float>());
-
-    while (s != "EDGES") in >> s >> N;
-
-    std::string city1, city2;
-    float dist;
-    for (int i = 0; i < N; i++)
-    {
-        in >> city1 >> city2 >> dist;
-        int c1 = nameToIdx(city1, g.data);
-        int c2 = nameToIdx(city2, g.data);
-        g.edges[c1].push_back(c2);
-        g.edges[c2].push_back(c1);
-        g.edge_costs[c1].push_back(dist);
-        g.edge_costs[c2].push_back(dist);
-    }
+/**
+ * Creates a graph from a road network in the DIMACS shortest path challenge
+ * format. The .gr file has a "p sp <nodes> <arcs>" line and one
+ * "a <from> <to> <cost>" line per directed arc, with 1-based node ids. The
+ * optional .co file has a "v <id> <x> <y>" line per node. Lines starting
+ * with "c" are comments.
+ * @param  gr_path The path to the .gr file.
+ * @param  co_path The path to the .co file, or empty for none.
+ * @return  The graph, empty if either file cannot be read or is malformed.
+ */
+Graph createGraphFromDimacs(const std::string& gr_path, const std::string& co_path = "");
 
-    return g;
-};
+/**
+ * Builds the compressed sparse row arcs of a graph from a list of arcs. Arcs
+ * leaving the same node keep their order.
+ * @param  num_nodes The number of nodes.
+ * @param  sources The node each arc leaves.
+ * @param  arcs The arcs, parallel to sources.
+ * @param[out]  g The graph to fill the offsets and arcs of.
+ */
+void buildGraphArcs(int num_nodes, const std::vector<int>& sources, const std::vector<GraphArc>& arcs, Graph& g);
 
 /**
  * Print the names of the nodes in a path in order.
@@ -154,6 +223,7 @@ int getParent(int n, Graph& g);
 
 /**
  * Initializes node data in a graph. Intended to be called after createGraph().
+ * Nodes are only rebuilt the first time, later calls just reset them.
  * @param[out]  g The graph to initialize.
  */
 void initGraph(Graph& g);
@@ -176,4 +246,146 @@ std::vector<int> bfs(int start, int goal, Graph& g);
  */
 std::vector<int> dfs(int start, int goal, Graph& g);
 
+/**
+ * Finds the lowest cost path from a starting node to a goal node on a graph
+ * with Dijkstra's algorithm. The search stops once the goal is expanded.
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node.
+ * @param  g The associated graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+std::vector<int> dijkstra(int start, int goal, const Graph& g, GraphSearchState& state);
+
+/**
+ * Finds the lowest cost path from a starting node to a goal node on a graph
+ * with A*. The heuristic is the straight line distance to the goal times
+ * heuristic_scale, so it never overestimates. Graphs without coordinates are
+ * searched as by dijkstra().
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node.
+ * @param  g The associated graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+std::vector<int> aStar(int start, int goal, const Graph& g, GraphSearchState& state);
+
+/**
+ * Finds the lowest cost path from a starting node to every node it can reach
+ * with Dijkstra's algorithm. The costs are then read with pathCost().
+ * @param  start The index of the starting node.
+ * @param  g The associated graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ */
+void dijkstraAll(int start, const Graph& g, GraphSearchState& state);
+
+/**
+ * Searches a graph in order of cost plus a heuristic, the search behind
+ * dijkstra(), aStar() and distanceTable(). Uses a binary heap allowing
+ * repeated entries, skipping those that are no longer the lowest cost of
+ * their node.
+ * @param  start The index of the starting node.
+ * @param  goal The index of the goal node, or -1 to reach every node.
+ * @param  g The associated graph.
+ * @param[out]  state The state of the search, which may be reused across queries.
+ * @param  heuristic A consistent lower bound on the cost from a node to the
+ *                   goal, called once per node. Nodes with an infinite bound
+ *                   cannot reach the goal and are not searched.
+ * @param  settled Called with each node as its cost becomes final; returning
+ *                 true stops the search early, leaving the costs settled so far.
+ * @return  A list of indicies of nodes that form a path from the starting node to the goal node.
+ */
+template <typename Heuristic, typename Settled>
+std::vector<int> heuristicSearch(int start, int goal, const Graph& g, GraphSearchState& state, Heuristic heuristic,
+                                 Settled settled)
+{
+    int num_nodes = numNodes(g);
+    if (state.stamp.size() != static_cast<size_t>(num_nodes))
+    {
+        state.cost.assign(num_nodes, std::numeric_limits<double>::infinity());
+        state.estimate.assign(num_nodes, 0);
+        state.parent.assign(num_nodes, -1);
+        state.stamp.assign(num_nodes, 0);
+        state.round = 0;
+    }
+    if (++state.round == 0)
+    {
+        // The stamps wrapped around, so none of them can be trusted.
+        std::fill(state.stamp.begin(), state.stamp.end(), 0);
+        state.round = 1;
+    }
+    state.expanded = 0;
+    state.heap.clear();
+    if (start < 0 || start >= num_nodes || goal < -1 || goal >= num_nodes) return {};
+
+    state.stamp[start] = state.round;
+    state.cost[start] = 0;
+    state.estimate[start] = heuristic(start);
+    state.parent[start] = -1;
+    if (std::isinf(state.estimate[start])) return {};
+    state.heap.push_back({state.estimate[start], start});
+
+    while (!state.heap.empty())
+    {
+        std::pop_heap(state.heap.begin(), state.heap.end(), LaterEntry());
+        double priority = state.heap.back().first;
+        int current = state.heap.back().second;
+        state.heap.pop_back();
+        if (priority > state.cost[current] + state.estimate[current]) continue;
+
+        state.expanded++;
+        if (current == goal)
+        {
+            std::vector<int> path;
+            for (int n = goal; n != -1; n = state.parent[n]) path.push_back(n);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+        if (settled(current)) return {};
+
+        for (const GraphArc& arc : arcsOf(current, g))
+        {
+            double new_cost = state.cost[current] + arc.cost;
+            int neighbor = arc.neighbor;
+            if (state.stamp[neighbor] != state.round)
+            {
+                state.stamp[neighbor] = state.round;
+                state.cost[neighbor] = std::numeric_limits<double>::infinity();
+                state.estimate[neighbor] = heuristic(neighbor);
+            }
+            if (new_cost >= state.cost[neighbor] || std::isinf(state.estimate[neighbor])) continue;
+            state.cost[neighbor] = new_cost;
+            state.parent[neighbor] = current;
+            state.heap.push_back({new_cost + state.estimate[neighbor], neighbor});
+            std::push_heap(state.heap.begin(), state.heap.end(), LaterEntry());
+        }
+    }
+
+    return {};
+}
+
+/**
+ * Searches a graph in order of cost plus a heuristic until the goal is reached.
+ */
+template <typename Heuristic>
+std::vector<int> heuristicSearch(int start, int goal, const Graph& g, GraphSearchState& state, Heuristic heuristic)
+{
+    return heuristicSearch(start, goal, g, state, heuristic, [](int) { return false; });
+}
+
+/**
+ * Gets the cost of a path found by dijkstra(), dijkstraAll() or aStar().
+ * @param  goal The index of the goal node of the last query.
+ * @param  state The state of the last query.
+ * @return  The cost of the path to the goal, or infinity if there is none.
+ */
+double pathCost(int goal, const GraphSearchState& state);
+
+/**
+ * Sets heuristic_scale from the coordinates of a graph to the least cost per
+ * unit of distance of any arc. Called by createGraphFromDimacs().
+ * @param[out]  g The graph, with its coordinates.
+ */
+void setHeuristicScale(Graph& g);
+
 #endif  // PLANNING_H
\ No newline at end of file
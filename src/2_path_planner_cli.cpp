@@ -7,6 +7,8 @@
 #include <path_planning/utils/viz_utils.h>
 #include <path_planning/graph_search/graph_search.h>
 #include <path_planning/graph_search/distance_transform.h>
+#include <path_planning/graph_search/quadtree.h>
+#include <path_planning/graph_search/any_angle.h>
 
 /**
  * @brief Print Usage prints the command line usage for the program
@@ -14,12 +16,13 @@
 void print_usage()
 {
     std::cout << "Usage:\n";
-    std::cout << "./planner [map_file] [planning_algo] [start_x] [start_y] [goal_x] [goal_y]" << std::endl;
+    std::cout << "./planner [map_file] [planning_algo] [start_x] [start_y] [goal_x] [goal_y] [output_mode]" << std::endl;
+    std::cout << "output_mode is one of full (default), compact, hash or path, see parsePlanFileMode()." << std::endl;
 }
 
 int main(int argv, char **argc)
 {
-    std::string map_file, planning_algo;
+    std::string map_file, planning_algo, output_mode = "full";
     Cell start, goal;
     if (argv >= 7)
     {
@@ -28,6 +31,7 @@ int main(int argv, char **argc)
         planning_algo = std::string(argc[2]);
         start = {std::atoi(argc[3]), std::atoi(argc[4])};
         goal = {std::atoi(argc[5]), std::atoi(argc[6])};
+        if (argv >= 8) output_mode = std::string(argc[7]);
     }
     else
     {
@@ -44,10 +48,18 @@ int main(int argv, char **argc)
         std::cin >> goal.i;
         std::cout << "\tj: ";
         std::cin >> goal.j;
-        std::cout << "Which algorithm would you like to use? [dfs, bfs, astar] : ";
+        std::cout << "Which algorithm would you like to use? [dfs, bfs, astar, quadtree, thetastar, lazythetastar] : ";
         std::cin >> planning_algo;
     }
 
+    PlanFileOptions plan_file_options;
+    if (!parsePlanFileMode(output_mode, plan_file_options))
+    {
+        std::cerr << "Invalid output mode: " << output_mode << std::endl;
+        print_usage();
+        return 1;
+    }
+
     // Load the graph and ensure it is loaded successfully.
     GridGraph graph;
     if (!loadFromFile(map_file, graph))
@@ -75,6 +87,20 @@ int main(int argv, char **argc)
     {
         path = depthFirstSearch(graph, start, goal);
     }
+    else if (planning_algo == "quadtree")
+    {
+        QuadtreeMap quadtree;
+        buildQuadtree(graph, quadtree);
+        path = quadtreeSearch(graph, quadtree, start, goal);
+    }
+    else if (planning_algo == "thetastar")
+    {
+        path = thetaStarSearch(graph, start, goal);
+    }
+    else if (planning_algo == "lazythetastar")
+    {
+        path = lazyThetaStarSearch(graph, start, goal);
+    }
     else
     {
         std::cerr << "Invalid planning algorithm: " << planning_algo << std::endl;
@@ -92,7 +118,7 @@ int main(int argv, char **argc)
     }
 
     // Generate the output file for visualization.
-    generatePlanFile(start, goal, path, graph, planning_algo);
+    if (!generatePlanFile(start, goal, path, graph, planning_algo, "out.planner", plan_file_options)) return 1;
 
     return 0;
 }
@@ -9,6 +9,7 @@
 #include <path_planning/utils/viz_utils.h>
 #include <path_planning/graph_search/graph_search.h>
 #include <path_planning/graph_search/distance_transform.h>
+#include <path_planning/graph_search/any_angle.h>
 
 int main(int argc, char const *argv[])
 {
@@ -49,19 +50,26 @@ int main(int argc, char const *argv[])
 
     // Execute the path-planning algorithm (A* used here).
     std::vector<Cell> path = aStarSearch(graph, start, goal);
+
+    // Save the path output file for visualization in the navigation
+    // application while the robot drives.
+    std::future<bool> plan_file = generatePlanFileAsync(start, goal, path, graph);
+
     if (!path.empty()) 
     {
         std::cout << "Found path of length: " << path.size() << "\n";
-        // Drive the robot along the calculated path.
-        robot.drivePath(cellsToPoses(path, graph));
+        // Drive the robot through the waypoints where the path turns, rather
+        // than through every cell.
+        std::vector<Cell> waypoints = shortcutPath(graph, path);
+        std::cout << "Driving through " << waypoints.size() << " waypoints.\n";
+        robot.drivePath(cellsToPoses(waypoints, graph));
     } 
     else 
     {
         std::cout << "No valid path found.\n";
     }
 
-    // Save the path output file for visualization in the navigation application.
-    generatePlanFile(start, goal, path, graph);
+    plan_file.wait();
 
     return 0;
 }
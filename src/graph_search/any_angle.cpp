@@ -0,0 +1,155 @@
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/any_angle.h>
+
+/**
+ * Euclidean distance between two cells.
+ */
+static float euclideanDistance(const Cell& a, const Cell& b)
+{
+    return std::sqrt(static_cast<float>((a.i - b.i) * (a.i - b.i) + (a.j - b.j) * (a.j - b.j)));
+}
+
+/**
+ * Theta* and Lazy Theta*, which share everything but when line of sight is
+ * checked.
+ */
+static std::vector<Cell> anyAngleSearch(GridGraph& graph, const Cell& start, const Cell& goal, bool lazy,
+                                        AnyAngleStats* stats)
+{
+    AnyAngleStats local_stats;
+    AnyAngleStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = AnyAngleStats();
+
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return {};
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    if (testBit(blocked, goal.i, goal.j)) return {};
+
+    int num_cells = graph.width * graph.height;
+    std::vector<float> costs(num_cells, HIGH);
+    std::vector<int> parents(num_cells, -1);
+    std::vector<bool> closed(num_cells, false);
+    auto distance = [&](int a, int b) { return euclideanDistance(idxToCell(a, graph), idxToCell(b, graph)); };
+    auto sight = [&](int a, int b)
+    {
+        ++counters.line_of_sight_checks;
+        Cell ca = idxToCell(a, graph), cb = idxToCell(b, graph);
+        return lineOfSight(blocked, ca.i, ca.j, cb.i, cb.j);
+    };
+
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    int start_idx = cellToIdx(start.i, start.j, graph), goal_idx = cellToIdx(goal.i, goal.j, graph);
+    costs[start_idx] = 0;
+    parents[start_idx] = start_idx;
+    open_set.push({euclideanDistance(start, goal), start_idx});
+
+    while (!open_set.empty())
+    {
+        int current = open_set.top().second;
+        open_set.pop();
+        if (closed[current]) continue;
+
+        // Lazy Theta* only now checks the parent it assumed. If it is out of
+        // sight, the best expanded neighbor becomes the parent, and there
+        // always is one, since some expanded neighbor generated this cell.
+        Cell c = idxToCell(current, graph);
+        if (lazy && parents[current] != current && !sight(parents[current], current))
+        {
+            costs[current] = HIGH;
+            for (const auto& step : kNeighborSteps)
+            {
+                int ni = c.i + step[0], nj = c.j + step[1];
+                if (!isCellInBounds(ni, nj, graph)) continue;
+                int neighbor = cellToIdx(ni, nj, graph);
+                if (!closed[neighbor]) continue;
+                float cost = costs[neighbor] + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+                if (cost < costs[current])
+                {
+                    costs[current] = cost;
+                    parents[current] = neighbor;
+                }
+            }
+        }
+
+        closed[current] = true;
+        ++counters.expanded;
+        graph.visited_cells.push_back(c);
+        if (current == goal_idx) break;
+
+        int parent = parents[current];
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph) || testBit(blocked, ni, nj)) continue;
+            int neighbor = cellToIdx(ni, nj, graph);
+            if (closed[neighbor]) continue;
+
+            // Try to skip this cell and go straight from its parent.
+            int new_parent = current;
+            if (parent != current && (lazy || sight(parent, neighbor))) new_parent = parent;
+            float cost = costs[new_parent] + distance(new_parent, neighbor);
+            if (cost < costs[neighbor])
+            {
+                costs[neighbor] = cost;
+                parents[neighbor] = new_parent;
+                open_set.push({cost + euclideanDistance({ni, nj}, goal), neighbor});
+            }
+        }
+    }
+    if (!closed[goal_idx]) return {};
+
+    std::vector<Cell> path;
+    for (int idx = goal_idx; idx != start_idx; idx = parents[idx]) path.push_back(idxToCell(idx, graph));
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+std::vector<Cell> thetaStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, AnyAngleStats* stats)
+{
+    return anyAngleSearch(graph, start, goal, false, stats);
+}
+
+std::vector<Cell> lazyThetaStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, AnyAngleStats* stats)
+{
+    return anyAngleSearch(graph, start, goal, true, stats);
+}
+
+std::vector<Cell> shortcutPath(GridGraph& graph, const std::vector<Cell>& path, AnyAngleStats* stats)
+{
+    AnyAngleStats local_stats;
+    AnyAngleStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = AnyAngleStats();
+    if (path.size() <= 2) return path;
+
+    // Neighboring cells of the path need no check, so each new waypoint is
+    // at least two cells past the last one.
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    std::vector<Cell> waypoints = {path.front()};
+    size_t anchor = 0;
+    for (size_t k = 2; k < path.size(); ++k)
+    {
+        ++counters.line_of_sight_checks;
+        if (!lineOfSight(blocked, path[anchor].i, path[anchor].j, path[k].i, path[k].j))
+        {
+            anchor = k - 1;
+            waypoints.push_back(path[anchor]);
+        }
+    }
+    waypoints.push_back(path.back());
+    return waypoints;
+}
+
+float anyAnglePathLength(const std::vector<Cell>& path)
+{
+    float length = 0;
+    for (size_t k = 1; k < path.size(); ++k) length += euclideanDistance(path[k - 1], path[k]);
+    return length;
+}
@@ -0,0 +1,196 @@
+#include <set>
+#include <cmath>
+#include <vector>
+#include <climits>
+#include <utility>
+#include <algorithm>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/bounded_search.h>
+
+/**
+ * Fills in the path and its cost from the parents of each cell.
+ */
+static void tracePath(int goal_idx, const std::vector<int>& parents, const std::vector<float>& costs,
+                      const GridGraph& graph, BoundedSearchResult& result)
+{
+    for (int idx = goal_idx; idx != -1; idx = parents[idx]) result.path.push_back(idxToCell(idx, graph));
+    std::reverse(result.path.begin(), result.path.end());
+    result.cost = costs[goal_idx];
+}
+
+BoundedSearchResult weightedAStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, float w)
+{
+    BoundedSearchResult result;
+    w = std::max(w, 1.0f);
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return result;
+    initGraph(graph);
+
+    int num_cells = graph.width * graph.height;
+    std::vector<float> costs(num_cells, HIGH);
+    std::vector<int> parents(num_cells, -1);
+    std::vector<bool> closed(num_cells, false);
+
+    // The open set is a heap so that it can be scanned for the lower bound at
+    // the end. Ties go to the cell furthest from the start.
+    struct Entry
+    {
+        float key, cost;
+        int idx;
+    };
+    auto later = [](const Entry& a, const Entry& b)
+    {
+        return a.key > b.key || (a.key == b.key && a.cost < b.cost);
+    };
+    std::vector<Entry> open_set;
+    auto push = [&](float cost, int idx)
+    {
+        open_set.push_back({cost + w * octileDistance(idxToCell(idx, graph), goal), cost, idx});
+        std::push_heap(open_set.begin(), open_set.end(), later);
+    };
+
+    int start_idx = cellToIdx(start.i, start.j, graph), goal_idx = cellToIdx(goal.i, goal.j, graph);
+    costs[start_idx] = 0;
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
+    push(0, start_idx);
+
+    bool found = false;
+    while (!open_set.empty())
+    {
+        std::pop_heap(open_set.begin(), open_set.end(), later);
+        Entry entry = open_set.back();
+        open_set.pop_back();
+        if (entry.cost > costs[entry.idx] || closed[entry.idx]) continue;
+        if (checkExpandedCollision(entry.idx, graph)) continue;
+
+        closed[entry.idx] = true;
+        ++result.expanded;
+        Cell c = idxToCell(entry.idx, graph);
+        graph.visited_cells.push_back(c);
+        if (entry.idx == goal_idx)
+        {
+            found = true;
+            break;
+        }
+
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph)) continue;
+            int neighbor = cellToIdx(ni, nj, graph);
+            float tentative_cost = entry.cost + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (tentative_cost < costs[neighbor] && !checkNeighborCollision(neighbor, graph))
+            {
+                // Cheaper paths reopen closed cells, which keeps the lower
+                // bound below sound.
+                costs[neighbor] = tentative_cost;
+                parents[neighbor] = entry.idx;
+                closed[neighbor] = false;
+                push(tentative_cost, neighbor);
+            }
+        }
+    }
+    if (!found) return result;
+    tracePath(goal_idx, parents, costs, graph, result);
+
+    // Some cell on a shortest path is open with its optimal cost, so the
+    // lowest g + h in the open set is a lower bound on the shortest path.
+    float lower_bound = result.cost;
+    for (const Entry& entry : open_set)
+    {
+        if (entry.cost == costs[entry.idx] && !closed[entry.idx])
+        {
+            lower_bound = std::min(lower_bound, entry.cost + octileDistance(idxToCell(entry.idx, graph), goal));
+        }
+    }
+    result.bound = lower_bound > 0 ? std::max(std::min(result.cost / lower_bound, w), 1.0f) : 1;
+    return result;
+}
+
+BoundedSearchResult focalSearch(GridGraph& graph, const Cell& start, const Cell& goal, float w)
+{
+    BoundedSearchResult result;
+    w = std::max(w, 1.0f);
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return result;
+    initGraph(graph);
+
+    int num_cells = graph.width * graph.height;
+    std::vector<float> costs(num_cells, HIGH), scores(num_cells, HIGH);
+    std::vector<int> parents(num_cells, -1);
+
+    // Every open cell is in open_set by f. The open cells with f at most
+    // w * f_min are also in the focal list, by distance to the goal and then f.
+    struct FocalKey
+    {
+        float h, f;
+        int idx;
+        bool operator<(const FocalKey& other) const
+        {
+            return h < other.h || (h == other.h && (f < other.f || (f == other.f && idx < other.idx)));
+        }
+    };
+    std::set<std::pair<float, int>> open_set;
+    std::set<FocalKey> focal;
+    auto heuristic = [&](int idx) { return octileDistance(idxToCell(idx, graph), goal); };
+
+    int start_idx = cellToIdx(start.i, start.j, graph), goal_idx = cellToIdx(goal.i, goal.j, graph);
+    costs[start_idx] = 0;
+    scores[start_idx] = heuristic(start_idx);
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
+    open_set.insert({scores[start_idx], start_idx});
+    focal.insert({heuristic(start_idx), scores[start_idx], start_idx});
+    float f_min = scores[start_idx];
+
+    while (!open_set.empty())
+    {
+        // When the lowest f rises, the open cells below the new threshold
+        // join the focal list.
+        float new_f_min = open_set.begin()->first;
+        if (new_f_min > f_min)
+        {
+            for (auto it = open_set.upper_bound({w * f_min, INT_MAX});
+                 it != open_set.end() && it->first <= w * new_f_min; ++it)
+            {
+                focal.insert({heuristic(it->second), it->first, it->second});
+            }
+            f_min = new_f_min;
+        }
+
+        int current = focal.begin()->idx;
+        focal.erase(focal.begin());
+        open_set.erase({scores[current], current});
+        if (checkExpandedCollision(current, graph)) continue;
+
+        ++result.expanded;
+        Cell c = idxToCell(current, graph);
+        graph.visited_cells.push_back(c);
+        if (current == goal_idx)
+        {
+            tracePath(goal_idx, parents, costs, graph, result);
+            result.bound = f_min > 0 ? std::max(std::min(result.cost / f_min, w), 1.0f) : 1;
+            return result;
+        }
+
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph)) continue;
+            int neighbor = cellToIdx(ni, nj, graph);
+            float tentative_cost = costs[current] + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (tentative_cost < costs[neighbor] && !checkNeighborCollision(neighbor, graph))
+            {
+                // Cheaper paths reopen closed cells, which keeps f_min a lower
+                // bound on the shortest path.
+                float h = heuristic(neighbor);
+                open_set.erase({scores[neighbor], neighbor});
+                focal.erase({h, scores[neighbor], neighbor});
+                costs[neighbor] = tentative_cost;
+                scores[neighbor] = tentative_cost + h;
+                parents[neighbor] = current;
+                open_set.insert({scores[neighbor], neighbor});
+                if (scores[neighbor] <= w * f_min) focal.insert({h, scores[neighbor], neighbor});
+            }
+        }
+    }
+    return result;
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <cmath>
 #include <limits>
+#include <algorithm>
 
 #include <path_planning/utils/math_helpers.h>
 #include <path_planning/utils/graph_utils.h>
@@ -161,3 +162,107 @@ void distanceTransformEuclidean2D(GridGraph& graph)
         }
     }
 }
+
+/**
+ * Exact one-dimensional squared Euclidean distance transform of a sampled
+ * function (Felzenszwalb and Huttenlocher), in linear time.
+ * @param  f The squared distances of each element, 0 at obstacles.
+ * @param  n The number of elements.
+ * @param[out]  d The transformed squared distances.
+ * @param  v, z Scratch space of at least n and n + 1 elements.
+ */
+static void squaredDistanceTransform1D(const float* f, int n, float* d, int* v, float* z)
+{
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (int q = 1; q < n; ++q)
+    {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k])
+        {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+
+    k = 0;
+    for (int q = 0; q < n; ++q)
+    {
+        while (z[k + 1] < q) ++k;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+bool distanceTransformEuclidean2D(TiledGridGraph& graph, int max_distance)
+{
+    if (!graph.hasDistances())
+    {
+        std::cerr << "ERROR: distanceTransformEuclidean2D: Tiled graph has no distance layer." << std::endl;
+        return false;
+    }
+
+    int tile = graph.tileSize();
+    int margin = std::max(max_distance, 0);
+    // Large but finite, so the 1D transform arithmetic stays well defined.
+    const float far = 1e20;
+
+    std::vector<float> window, column, column_out, z;
+    std::vector<int> v;
+    for (int ty = 0; ty * tile < graph.height; ++ty)
+    {
+        for (int tx = 0; tx * tile < graph.width; ++tx)
+        {
+            // The tile plus a margin, which holds every obstacle within
+            // max_distance of a cell in the tile.
+            int i0 = std::max(tx * tile - margin, 0);
+            int j0 = std::max(ty * tile - margin, 0);
+            int i1 = std::min((tx + 1) * tile + margin, graph.width);
+            int j1 = std::min((ty + 1) * tile + margin, graph.height);
+            int w = i1 - i0, h = j1 - j0;
+
+            window.resize(static_cast<size_t>(w) * h);
+            for (int j = j0; j < j1; ++j)
+            {
+                for (int i = i0; i < i1; ++i)
+                {
+                    window[(j - j0) * w + (i - i0)] = graph.isCellOccupied(i, j) ? 0 : far;
+                }
+            }
+
+            int n = std::max(w, h);
+            column.resize(n);
+            column_out.resize(n);
+            v.resize(n);
+            z.resize(n + 1);
+            for (int i = 0; i < w; ++i)
+            {
+                for (int j = 0; j < h; ++j) column[j] = window[j * w + i];
+                squaredDistanceTransform1D(column.data(), h, column_out.data(), v.data(), z.data());
+                for (int j = 0; j < h; ++j) window[j * w + i] = column_out[j];
+            }
+            for (int j = 0; j < h; ++j)
+            {
+                squaredDistanceTransform1D(&window[j * w], w, column_out.data(), v.data(), z.data());
+                std::copy(column_out.begin(), column_out.begin() + w, window.begin() + j * w);
+            }
+
+            int ti1 = std::min((tx + 1) * tile, graph.width);
+            int tj1 = std::min((ty + 1) * tile, graph.height);
+            for (int j = ty * tile; j < tj1; ++j)
+            {
+                for (int i = tx * tile; i < ti1; ++i)
+                {
+                    float distance = std::sqrt(window[(j - j0) * w + (i - i0)]);
+                    graph.setObstacleDistance(i, j, std::min(distance, static_cast<float>(margin)));
+                }
+            }
+        }
+    }
+    return graph.flush();
+}
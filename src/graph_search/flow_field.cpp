@@ -0,0 +1,120 @@
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/flow_field.h>
+
+void computeFlowField(GridGraph& graph, const Cell& goal, FlowField& field)
+{
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+
+    int num_cells = graph.width * graph.height;
+    field.goal = goal;
+    field.map_version = graph.map_version;
+    field.width = graph.width;
+    field.height = graph.height;
+    field.directions.assign(num_cells, FLOW_FIELD_UNREACHABLE);
+    if (!isCellInBounds(goal.i, goal.j, graph)) return;
+
+    // The costs are only needed while searching, so the field itself stays at
+    // one byte per cell.
+    std::vector<float> costs(num_cells, HIGH);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+
+    int goal_idx = cellToIdx(goal.i, goal.j, graph);
+    costs[goal_idx] = 0;
+    field.directions[goal_idx] = FLOW_FIELD_GOAL;
+    open_set.push({0, goal_idx});
+
+    while (!open_set.empty())
+    {
+        float cost = open_set.top().first;
+        int current = open_set.top().second;
+        open_set.pop();
+        if (cost > costs[current]) continue;
+
+        Cell c = idxToCell(current, graph);
+        for (int k = 0; k < 8; ++k)
+        {
+            int di = kNeighborSteps[k][0], dj = kNeighborSteps[k][1];
+            int ni = c.i + di, nj = c.j + dj;
+            if (!isCellInBounds(ni, nj, graph) || testBit(blocked, ni, nj)) continue;
+
+            int neighbor = cellToIdx(ni, nj, graph);
+            float tentative_cost = cost + (di != 0 && dj != 0 ? M_SQRT2 : 1);
+            if (tentative_cost < costs[neighbor])
+            {
+                // The neighbor steps back along the opposite direction.
+                costs[neighbor] = tentative_cost;
+                field.directions[neighbor] = 7 - k;
+                open_set.push({tentative_cost, neighbor});
+            }
+        }
+    }
+}
+
+std::vector<Cell> flowFieldPath(const FlowField& field, const Cell& start)
+{
+    if (start.i < 0 || start.j < 0 || start.i >= field.width || start.j >= field.height) return {};
+
+    std::vector<Cell> path;
+    Cell c = start;
+    while (true)
+    {
+        uint8_t direction = field.directions[c.i + c.j * field.width];
+        if (direction == FLOW_FIELD_UNREACHABLE) return {};
+        path.push_back(c);
+        if (direction == FLOW_FIELD_GOAL) return path;
+        c.i += kNeighborSteps[direction][0];
+        c.j += kNeighborSteps[direction][1];
+    }
+}
+
+FlowFieldCache::FlowFieldCache(size_t max_fields) :
+    max_fields_(std::max<size_t>(max_fields, 1)),
+    hits_(0),
+    misses_(0)
+{
+}
+
+const FlowField& FlowFieldCache::getField(GridGraph& graph, const Cell& goal)
+{
+    if (!fields_.empty() && fields_.front().map_version != graph.map_version)
+    {
+        fields_.clear();
+    }
+
+    for (auto it = fields_.begin(); it != fields_.end(); ++it)
+    {
+        if (it->goal.i == goal.i && it->goal.j == goal.j)
+        {
+            ++hits_;
+            fields_.splice(fields_.begin(), fields_, it);
+            return fields_.front();
+        }
+    }
+
+    ++misses_;
+    if (fields_.size() >= max_fields_)
+    {
+        // Reuse the least recently used field's memory.
+        fields_.splice(fields_.begin(), fields_, std::prev(fields_.end()));
+    }
+    else
+    {
+        fields_.emplace_front();
+    }
+    computeFlowField(graph, goal, fields_.front());
+    return fields_.front();
+}
+
+std::vector<Cell> FlowFieldCache::findPath(GridGraph& graph, const Cell& start, const Cell& goal)
+{
+    return flowFieldPath(getField(graph, goal), start);
+}
@@ -4,6 +4,8 @@
 #include <stack>
 #include <unordered_set>
 #include <functional>
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 
 #include <path_planning/utils/math_helpers.h>
@@ -23,11 +25,13 @@ std::vector<Cell> depthFirstSearch(GridGraph &graph, const Cell &start, const Ce
     std::stack<int> visit_stack;
     visit_stack.push(start_idx);
     graph.nodes[start_idx].visited = true;
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
 
     while (!visit_stack.empty())
     {
         int current = visit_stack.top();
         visit_stack.pop();
+        if (checkExpandedCollision(current, graph)) continue;
 
         graph.visited_cells.push_back(idxToCell(current, graph));
 
@@ -38,7 +42,7 @@ std::vector<Cell> depthFirstSearch(GridGraph &graph, const Cell &start, const Ce
 
         for (int neighbor : findNeighbors(current, graph))
         {
-            if (!graph.nodes[neighbor].visited)
+            if (!graph.nodes[neighbor].visited && !checkNeighborCollision(neighbor, graph))
             {
                 graph.nodes[neighbor].visited = true;
                 graph.nodes[neighbor].parent = current;
@@ -67,11 +71,13 @@ std::vector<Cell> breadthFirstSearch(GridGraph &graph, const Cell &start, const
     visit_queue.push(start_idx);
     graph.nodes[start_idx].visited = true;
     graph.nodes[start_idx].cost = 0;
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
 
     while (!visit_queue.empty())
     {
         int current = visit_queue.front();
         visit_queue.pop();
+        if (checkExpandedCollision(current, graph)) continue;
 
         graph.visited_cells.push_back(idxToCell(current, graph));
 
@@ -94,7 +100,7 @@ std::vector<Cell> breadthFirstSearch(GridGraph &graph, const Cell &start, const
             float distance = std::sqrt(std::pow(current_cell.i - neighbor_cell.i, 2) +
                                        std::pow(current_cell.j - neighbor_cell.j, 2));
 
-            if (checkCollision(neighbor, graph)) {
+            if (checkNeighborCollision(neighbor, graph)) {
                 continue;
             }
 
@@ -112,6 +118,9 @@ std::vector<Cell> breadthFirstSearch(GridGraph &graph, const Cell &start, const
 
 bool depthLimitedSearch(GridGraph &graph, int current, int goal, int depth)
 {
+    // Cells that are only reached at the depth limit are never expanded, so
+    // lazy mode does not check them unless they are the goal.
+    if ((current == goal || depth > 0) && checkExpandedCollision(current, graph)) return false;
     if (current == goal) return true;
     if (depth <= 0) return false;
 
@@ -119,7 +128,7 @@ bool depthLimitedSearch(GridGraph &graph, int current, int goal, int depth)
 
     for (int neighbor : findNeighbors(current, graph))
     {
-        if (!graph.nodes[neighbor].visited)
+        if (!graph.nodes[neighbor].visited && !checkNeighborCollision(neighbor, graph))
         {
             graph.nodes[neighbor].visited = true;
             graph.nodes[neighbor].parent = current;
@@ -143,6 +152,9 @@ std::vector<Cell> iterativeDeepeningSearch(GridGraph &graph, const Cell &start,
     while (true)
     {
         initGraph(graph);
+        // Mark the start so it is never re-parented, which would make a cycle in the path.
+        graph.nodes[start_idx].visited = true;
+        graph.nodes[start_idx].collision = 0;  // The start is never checked.
         if (depthLimitedSearch(graph, start_idx, goal_idx, depth))
         {
             return tracePath(goal_idx, graph);
@@ -163,19 +175,23 @@ std::vector<Cell> aStarSearch(GridGraph &graph, const Cell &start, const Cell &g
     int start_idx = cellToIdx(start.i, start.j, graph);
     int goal_idx = cellToIdx(goal.i, goal.j, graph);
 
-    auto compare = [&](int a, int b) {
-        return graph.nodes[a].cost + heuristic(idxToCell(a, graph), goal) >
-               graph.nodes[b].cost + heuristic(idxToCell(b, graph), goal);
-    };
-    std::priority_queue<int, std::vector<int>, decltype(compare)> open_set(compare);
+    // Entries hold the score a cell was pushed with, so that lowering a cost
+    // never reorders the queue under it. Entries whose score is out of date
+    // are skipped when they come up.
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
 
     graph.nodes[start_idx].cost = 0;
-    open_set.push(start_idx);
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
+    open_set.push({heuristic(start, goal), start_idx});
 
     while (!open_set.empty())
     {
-        int current = open_set.top();
+        float score = open_set.top().first;
+        int current = open_set.top().second;
         open_set.pop();
+        if (score > graph.nodes[current].cost + heuristic(idxToCell(current, graph), goal)) continue;
+        if (checkExpandedCollision(current, graph)) continue;
 
         graph.visited_cells.push_back(idxToCell(current, graph));
 
@@ -187,14 +203,84 @@ std::vector<Cell> aStarSearch(GridGraph &graph, const Cell &start, const Cell &g
         for (int neighbor : findNeighbors(current, graph))
         {
             float tentative_cost = graph.nodes[current].cost + 1; 
-            if (tentative_cost < graph.nodes[neighbor].cost)
+            if (tentative_cost < graph.nodes[neighbor].cost && !checkNeighborCollision(neighbor, graph))
             {
                 graph.nodes[neighbor].cost = tentative_cost;
                 graph.nodes[neighbor].parent = current;
-                open_set.push(neighbor);
+                open_set.push({tentative_cost + heuristic(idxToCell(neighbor, graph), goal), neighbor});
             }
         }
     }
 
     return {}; 
 }
+
+std::vector<Cell> aStarSearch(TiledGridGraph &graph, const Cell &start, const Cell &goal, int64_t *num_expanded)
+{
+    struct TiledNode
+    {
+        float cost;
+        int64_t parent;
+        bool closed;
+    };
+    std::unordered_map<int64_t, TiledNode> nodes;
+
+    if (num_expanded != nullptr) *num_expanded = 0;
+    if (!graph.isCellInBounds(start.i, start.j) || !graph.isCellInBounds(goal.i, goal.j)) return {};
+
+    int64_t start_idx = graph.cellToIdx(start.i, start.j);
+    int64_t goal_idx = graph.cellToIdx(goal.i, goal.j);
+
+    using Entry = std::pair<float, int64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    nodes[start_idx] = {0, -1, false};
+    open_set.push({octileDistance(start, goal), start_idx});
+
+    while (!open_set.empty())
+    {
+        int64_t current = open_set.top().second;
+        open_set.pop();
+
+        TiledNode &current_node = nodes[current];
+        if (current_node.closed) continue;
+        current_node.closed = true;
+        if (num_expanded != nullptr) ++*num_expanded;
+
+        if (current == goal_idx)
+        {
+            std::vector<Cell> path;
+            for (int64_t idx = goal_idx; idx != -1; idx = nodes[idx].parent)
+            {
+                path.push_back(graph.idxToCell(idx));
+            }
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        float current_cost = current_node.cost;
+        Cell c = graph.idxToCell(current);
+        for (const auto& step : kNeighborSteps)
+        {
+            Cell n = {c.i + step[0], c.j + step[1]};
+            if (!graph.isCellInBounds(n.i, n.j)) continue;
+
+            int64_t neighbor = graph.cellToIdx(n.i, n.j);
+            auto found = nodes.find(neighbor);
+            if (found != nodes.end() && found->second.closed) continue;
+
+            float tentative_cost = current_cost + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (found != nodes.end() && tentative_cost >= found->second.cost) continue;
+            if (graph.checkCollision(n.i, n.j))
+            {
+                // Close cells in collision so they are only checked once.
+                nodes[neighbor] = {static_cast<float>(HIGH), -1, true};
+                continue;
+            }
+
+            nodes[neighbor] = {tentative_cost, current, false};
+            open_set.push({tentative_cost + octileDistance(n, goal), neighbor});
+        }
+    }
+
+    return {};
+}
@@ -0,0 +1,349 @@
+#include <cmath>
+#include <queue>
+#include <chrono>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/hpa_star.h>
+
+/**
+ * A rectangle of cells, [x0, x1) x [y0, y1).
+ */
+struct CellRect
+{
+    int x0, y0, x1, y1;
+
+    int width() const { return x1 - x0; }
+    int local(int i, int j) const { return (i - x0) + (j - y0) * width(); }
+    Cell cell(int local) const { return {x0 + local % width(), y0 + local / width()}; }
+};
+
+/**
+ * Searches the free cells of a rectangle from a source cell, which may itself
+ * be blocked. With a target, runs A* and stops once the target is reached.
+ * Without one, runs Dijkstra over the whole rectangle. Costs and parents are
+ * indexed by CellRect::local().
+ * @return  The number of cells expanded.
+ */
+static int64_t searchRect(const OccupancyBits& blocked, const CellRect& rect, const Cell& source,
+                          const Cell* target, std::vector<float>& costs, std::vector<int>& parents)
+{
+    int num_cells = rect.width() * (rect.y1 - rect.y0);
+    costs.assign(num_cells, HIGH);
+    parents.assign(num_cells, -1);
+    std::vector<bool> closed(num_cells, false);
+
+    auto heuristic = [&](const Cell& c) { return target != nullptr ? octileDistance(c, *target) : 0.0f; };
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    int source_local = rect.local(source.i, source.j);
+    costs[source_local] = 0;
+    open_set.push({heuristic(source), source_local});
+
+    int64_t num_expanded = 0;
+    while (!open_set.empty())
+    {
+        int current = open_set.top().second;
+        open_set.pop();
+        if (closed[current]) continue;
+        closed[current] = true;
+        ++num_expanded;
+
+        Cell c = rect.cell(current);
+        if (target != nullptr && c.i == target->i && c.j == target->j) break;
+
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (ni < rect.x0 || nj < rect.y0 || ni >= rect.x1 || nj >= rect.y1 || testBit(blocked, ni, nj)) continue;
+
+            int neighbor = rect.local(ni, nj);
+            float tentative_cost = costs[current] + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (!closed[neighbor] && tentative_cost < costs[neighbor])
+            {
+                costs[neighbor] = tentative_cost;
+                parents[neighbor] = current;
+                open_set.push({tentative_cost + heuristic({ni, nj}), neighbor});
+            }
+        }
+    }
+    return num_expanded;
+}
+
+/**
+ * Traces the cells from the source of a rectangle search to a cell.
+ */
+static std::vector<Cell> traceRect(const CellRect& rect, const std::vector<int>& parents, const Cell& end)
+{
+    std::vector<Cell> path;
+    for (int local = rect.local(end.i, end.j); local != -1; local = parents[local])
+    {
+        path.push_back(rect.cell(local));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+static int clusterOf(const HierarchicalGraph& hpa, const Cell& c)
+{
+    return c.i / hpa.cluster_size + (c.j / hpa.cluster_size) * hpa.clusters_x;
+}
+
+static CellRect clusterRect(const HierarchicalGraph& hpa, int cluster, const GridGraph& graph)
+{
+    int x0 = (cluster % hpa.clusters_x) * hpa.cluster_size;
+    int y0 = (cluster / hpa.clusters_x) * hpa.cluster_size;
+    return {x0, y0, std::min(x0 + hpa.cluster_size, graph.width), std::min(y0 + hpa.cluster_size, graph.height)};
+}
+
+void buildHierarchicalGraph(GridGraph& graph, int cluster_size, HierarchicalGraph& hpa)
+{
+    auto start_time = std::chrono::steady_clock::now();
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+
+    hpa = HierarchicalGraph();
+    hpa.cluster_size = std::max(cluster_size, 2);
+    hpa.clusters_x = (graph.width + hpa.cluster_size - 1) / hpa.cluster_size;
+    hpa.clusters_y = (graph.height + hpa.cluster_size - 1) / hpa.cluster_size;
+    hpa.map_version = graph.map_version;
+    hpa.cluster_nodes.resize(hpa.clusters_x * hpa.clusters_y);
+
+    std::unordered_map<int, int> cell_nodes;
+    auto addNode = [&](const Cell& c)
+    {
+        int idx = cellToIdx(c.i, c.j, graph);
+        auto found = cell_nodes.find(idx);
+        if (found != cell_nodes.end()) return found->second;
+        int node = hpa.node_cells.size();
+        cell_nodes[idx] = node;
+        hpa.node_cells.push_back(idx);
+        hpa.edges.emplace_back();
+        hpa.cluster_nodes[clusterOf(hpa, c)].push_back(node);
+        return node;
+    };
+    auto addTransition = [&](const Cell& a, const Cell& b)
+    {
+        int u = addNode(a), v = addNode(b);
+        hpa.edges[u].push_back({v, 1});
+        hpa.edges[v].push_back({u, 1});
+    };
+
+    // Walks along a border of the given length, where position k pairs cell
+    // a(k) on one side with b(k) on the other, and adds transitions for each
+    // run of positions where both cells are free.
+    auto addEntrances = [&](int length, std::function<Cell(int)> a, std::function<Cell(int)> b)
+    {
+        int run_start = -1;
+        for (int k = 0; k <= length; ++k)
+        {
+            bool open = k < length && !testBit(blocked, a(k).i, a(k).j) && !testBit(blocked, b(k).i, b(k).j);
+            if (open && run_start < 0) run_start = k;
+            if (open || run_start < 0) continue;
+
+            int run_end = k - 1;
+            if (run_end - run_start + 1 < HPA_MAX_SINGLE_ENTRANCE)
+            {
+                int middle = (run_start + run_end) / 2;
+                addTransition(a(middle), b(middle));
+            }
+            else
+            {
+                addTransition(a(run_start), b(run_start));
+                addTransition(a(run_end), b(run_end));
+            }
+            run_start = -1;
+        }
+    };
+
+    for (int cy = 0; cy < hpa.clusters_y; ++cy)
+    {
+        for (int cx = 0; cx < hpa.clusters_x; ++cx)
+        {
+            CellRect rect = clusterRect(hpa, cx + cy * hpa.clusters_x, graph);
+            if (cx + 1 < hpa.clusters_x)
+            {
+                addEntrances(rect.y1 - rect.y0,
+                             [&](int k) { return Cell{rect.x1 - 1, rect.y0 + k}; },
+                             [&](int k) { return Cell{rect.x1, rect.y0 + k}; });
+            }
+            if (cy + 1 < hpa.clusters_y)
+            {
+                addEntrances(rect.x1 - rect.x0,
+                             [&](int k) { return Cell{rect.x0 + k, rect.y1 - 1}; },
+                             [&](int k) { return Cell{rect.x0 + k, rect.y1}; });
+            }
+        }
+    }
+
+    // Join the nodes of each cluster by their shortest paths inside it.
+    std::vector<float> costs;
+    std::vector<int> parents;
+    for (int cluster = 0; cluster < static_cast<int>(hpa.cluster_nodes.size()); ++cluster)
+    {
+        CellRect rect = clusterRect(hpa, cluster, graph);
+        const std::vector<int>& nodes = hpa.cluster_nodes[cluster];
+        for (int u : nodes)
+        {
+            searchRect(blocked, rect, idxToCell(hpa.node_cells[u], graph), nullptr, costs, parents);
+            for (int v : nodes)
+            {
+                Cell c = idxToCell(hpa.node_cells[v], graph);
+                float cost = costs[rect.local(c.i, c.j)];
+                if (v != u && cost < HIGH) hpa.edges[u].push_back({v, cost});
+            }
+        }
+    }
+
+    hpa.build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+}
+
+size_t hierarchicalGraphBytes(const HierarchicalGraph& hpa)
+{
+    size_t bytes = sizeof(hpa) + hpa.node_cells.capacity() * sizeof(int);
+    for (const auto& edges : hpa.edges) bytes += sizeof(edges) + edges.capacity() * sizeof(HpaEdge);
+    for (const auto& nodes : hpa.cluster_nodes) bytes += sizeof(nodes) + nodes.capacity() * sizeof(int);
+    return bytes;
+}
+
+std::vector<Cell> hierarchicalSearch(GridGraph& graph, const HierarchicalGraph& hpa, const Cell& start,
+                                     const Cell& goal, HpaSearchStats* stats)
+{
+    HpaSearchStats local_stats;
+    HpaSearchStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = HpaSearchStats();
+    if (hpa.cluster_size == 0 || hpa.map_version != graph.map_version) return {};
+
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph) ||
+        testBit(blocked, goal.i, goal.j))
+    {
+        return {};
+    }
+    if (start.i == goal.i && start.j == goal.j) return {start};
+
+    // Connect the start and goal to the abstract nodes of their clusters. The
+    // searches are kept to refine the first and last steps of the path.
+    int start_cluster = clusterOf(hpa, start), goal_cluster = clusterOf(hpa, goal);
+    CellRect start_rect = clusterRect(hpa, start_cluster, graph);
+    CellRect goal_rect = clusterRect(hpa, goal_cluster, graph);
+    std::vector<float> start_costs, goal_costs;
+    std::vector<int> start_parents, goal_parents;
+    counters.cell_expanded += searchRect(blocked, start_rect, start, nullptr, start_costs, start_parents);
+    counters.cell_expanded += searchRect(blocked, goal_rect, goal, nullptr, goal_costs, goal_parents);
+
+    int num_nodes = hpa.node_cells.size();
+    const int start_node = num_nodes, goal_node = num_nodes + 1;
+    auto nodeCell = [&](int node)
+    {
+        if (node == start_node) return start;
+        if (node == goal_node) return goal;
+        return idxToCell(hpa.node_cells[node], graph);
+    };
+    auto goalCost = [&](int node)
+    {
+        Cell c = nodeCell(node);
+        return clusterOf(hpa, c) == goal_cluster ? goal_costs[goal_rect.local(c.i, c.j)] : HIGH;
+    };
+
+    std::vector<HpaEdge> start_edges;
+    for (int node : hpa.cluster_nodes[start_cluster])
+    {
+        Cell c = nodeCell(node);
+        float cost = start_costs[start_rect.local(c.i, c.j)];
+        if (cost < HIGH) start_edges.push_back({node, cost});
+    }
+    if (start_cluster == goal_cluster && start_costs[start_rect.local(goal.i, goal.j)] < HIGH)
+    {
+        start_edges.push_back({goal_node, start_costs[start_rect.local(goal.i, goal.j)]});
+    }
+
+    // A* over the abstract graph.
+    std::vector<float> costs(num_nodes + 2, HIGH);
+    std::vector<int> parents(num_nodes + 2, -1);
+    std::vector<bool> closed(num_nodes + 2, false);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    costs[start_node] = 0;
+    open_set.push({octileDistance(start, goal), start_node});
+
+    auto relax = [&](int from, int to, float edge_cost)
+    {
+        float tentative_cost = costs[from] + edge_cost;
+        if (!closed[to] && tentative_cost < costs[to])
+        {
+            costs[to] = tentative_cost;
+            parents[to] = from;
+            open_set.push({tentative_cost + octileDistance(nodeCell(to), goal), to});
+        }
+    };
+
+    while (!open_set.empty())
+    {
+        int current = open_set.top().second;
+        open_set.pop();
+        if (closed[current]) continue;
+        closed[current] = true;
+        ++counters.abstract_expanded;
+        if (current == goal_node) break;
+
+        const std::vector<HpaEdge>& edges = current == start_node ? start_edges : hpa.edges[current];
+        for (const HpaEdge& edge : edges) relax(current, edge.to, edge.cost);
+        if (current != start_node)
+        {
+            float cost = goalCost(current);
+            if (cost < HIGH) relax(current, goal_node, cost);
+        }
+    }
+
+    if (!closed[goal_node])
+    {
+        CellRect map_rect = {0, 0, graph.width, graph.height};
+        counters.fallback = true;
+        counters.cell_expanded += searchRect(blocked, map_rect, start, &goal, start_costs, start_parents);
+        if (start_costs[map_rect.local(goal.i, goal.j)] >= HIGH) return {};
+        return traceRect(map_rect, start_parents, goal);
+    }
+
+    std::vector<int> abstract_path;
+    for (int node = goal_node; node != -1; node = parents[node]) abstract_path.push_back(node);
+    std::reverse(abstract_path.begin(), abstract_path.end());
+
+    // Refine each abstract step into cells. Transitions between clusters are
+    // single steps, and the first and last steps come from the start and goal
+    // searches, so only the clusters crossed in between are searched again.
+    std::vector<Cell> path = {start};
+    std::vector<float> refine_costs;
+    std::vector<int> refine_parents;
+    for (size_t k = 1; k < abstract_path.size(); ++k)
+    {
+        int from = abstract_path[k - 1], to = abstract_path[k];
+        Cell a = nodeCell(from), b = nodeCell(to);
+        std::vector<Cell> segment;
+        if (from == start_node)
+        {
+            segment = traceRect(start_rect, start_parents, b);
+        }
+        else if (to == goal_node)
+        {
+            segment = traceRect(goal_rect, goal_parents, a);
+            std::reverse(segment.begin(), segment.end());
+        }
+        else if (std::abs(a.i - b.i) <= 1 && std::abs(a.j - b.j) <= 1)
+        {
+            segment = {a, b};
+        }
+        else
+        {
+            CellRect rect = clusterRect(hpa, clusterOf(hpa, a), graph);
+            counters.cell_expanded += searchRect(blocked, rect, a, &b, refine_costs, refine_parents);
+            segment = traceRect(rect, refine_parents, b);
+        }
+
+        for (size_t s = 1; s < segment.size(); ++s) path.push_back(segment[s]);
+    }
+    return path;
+}
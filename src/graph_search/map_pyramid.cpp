@@ -0,0 +1,196 @@
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/map_pyramid.h>
+
+/**
+ * Gets a new stamp for the scratch arrays, clearing them when the stamps wrap.
+ */
+static uint32_t nextStamp(MapPyramid& pyramid)
+{
+    if (++pyramid.stamp == 0)
+    {
+        std::fill(pyramid.visits.begin(), pyramid.visits.end(), 0);
+        std::fill(pyramid.corridor.begin(), pyramid.corridor.end(), 0);
+        pyramid.stamp = 1;
+    }
+    return pyramid.stamp;
+}
+
+/**
+ * Runs A* at one level of the pyramid. The start and goal cells are usable
+ * even if they are blocked. With a corridor stamp, only cells whose parent
+ * cell on the next coarser level is marked with it in pyramid.corridor are
+ * searched.
+ * @return  The cells of the path at this level, or an empty list.
+ */
+static std::vector<Cell> searchLevel(MapPyramid& pyramid, int level, const Cell& start, const Cell& goal,
+                                     uint32_t corridor_stamp, int64_t& num_expanded)
+{
+    const OccupancyBits& blocked = pyramid.levels[level];
+    int width = blocked.width;
+    int coarse_width = corridor_stamp != 0 ? pyramid.levels[level + 1].width : 0;
+    auto usable = [&](int i, int j)
+    {
+        if (i < 0 || j < 0 || i >= width || j >= blocked.height) return false;
+        if (corridor_stamp != 0 && pyramid.corridor[(i >> 1) + (j >> 1) * coarse_width] != corridor_stamp)
+        {
+            return false;
+        }
+        return !testBit(blocked, i, j) || (i == start.i && j == start.j) || (i == goal.i && j == goal.j);
+    };
+    if (!usable(start.i, start.j) || !usable(goal.i, goal.j)) return {};
+
+    // Ties between equal estimates go to the cell furthest from the start,
+    // which cuts the expansions across open areas where many paths are
+    // equally short.
+    uint32_t stamp = nextStamp(pyramid);
+    struct Entry
+    {
+        float estimate, cost;
+        int idx;
+        bool operator>(const Entry& other) const
+        {
+            return estimate > other.estimate || (estimate == other.estimate && cost < other.cost);
+        }
+    };
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    int start_idx = start.i + start.j * width, goal_idx = goal.i + goal.j * width;
+    pyramid.visits[start_idx] = stamp;
+    pyramid.costs[start_idx] = 0;
+    pyramid.parents[start_idx] = -1;
+    open_set.push({octileDistance(start, goal), 0, start_idx});
+
+    bool found = false;
+    while (!open_set.empty())
+    {
+        Entry entry = open_set.top();
+        open_set.pop();
+        int current = entry.idx;
+        float cost = pyramid.costs[current];
+        // Skip stale entries for cells that were reached more cheaply since.
+        if (entry.cost > cost) continue;
+        Cell c = {current % width, current / width};
+        ++num_expanded;
+        if (current == goal_idx)
+        {
+            found = true;
+            break;
+        }
+
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!usable(ni, nj)) continue;
+
+            int neighbor = ni + nj * width;
+            float tentative_cost = cost + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (pyramid.visits[neighbor] != stamp || tentative_cost < pyramid.costs[neighbor])
+            {
+                pyramid.visits[neighbor] = stamp;
+                pyramid.costs[neighbor] = tentative_cost;
+                pyramid.parents[neighbor] = current;
+                open_set.push({tentative_cost + octileDistance({ni, nj}, goal), tentative_cost, neighbor});
+            }
+        }
+    }
+    if (!found) return {};
+
+    std::vector<Cell> path;
+    for (int idx = goal_idx; idx != -1; idx = pyramid.parents[idx]) path.push_back({idx % width, idx / width});
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+void buildMapPyramid(GridGraph& graph, MapPyramid& pyramid, int num_levels)
+{
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    pyramid.map_version = graph.map_version;
+    pyramid.num_levels = std::max(num_levels, 0);
+    pyramid.levels.assign(1, blocked);
+    while (static_cast<int>(pyramid.levels.size()) <= pyramid.num_levels &&
+           (pyramid.levels.back().width > 1 || pyramid.levels.back().height > 1))
+    {
+        OccupancyBits coarse;
+        downsampleOccupancyBits(pyramid.levels.back(), coarse);
+        pyramid.levels.push_back(std::move(coarse));
+    }
+
+    // Every level fits in the scratch for the finest one.
+    size_t num_cells = static_cast<size_t>(graph.width) * graph.height;
+    pyramid.costs.assign(num_cells, HIGH);
+    pyramid.parents.assign(num_cells, -1);
+    pyramid.visits.assign(num_cells, 0);
+    pyramid.corridor.assign(num_cells, 0);
+    pyramid.stamp = 0;
+}
+
+size_t mapPyramidBytes(const MapPyramid& pyramid)
+{
+    size_t bytes = sizeof(pyramid);
+    for (const OccupancyBits& level : pyramid.levels) bytes += sizeof(level) + level.words.size() * sizeof(uint64_t);
+    return bytes;
+}
+
+std::vector<Cell> pyramidSearch(GridGraph& graph, MapPyramid& pyramid, const Cell& start, const Cell& goal,
+                                PyramidSearchStats* stats, int corridor_radius)
+{
+    PyramidSearchStats local_stats;
+    PyramidSearchStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = PyramidSearchStats();
+
+    if (pyramid.levels.empty() || pyramid.map_version != graph.map_version ||
+        pyramid.levels[0].width != graph.width || pyramid.levels[0].height != graph.height)
+    {
+        buildMapPyramid(graph, pyramid, pyramid.num_levels);
+    }
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph) ||
+        testBit(pyramid.levels[0], goal.i, goal.j))
+    {
+        return {};
+    }
+    if (start.i == goal.i && start.j == goal.j) return {start};
+
+    // Find the coarsest level with a path. Searches at coarse levels are
+    // small, so the ones that fail are cheap.
+    std::vector<Cell> path;
+    int level = pyramid.levels.size() - 1;
+    for (; level > 0; --level)
+    {
+        path = searchLevel(pyramid, level, {start.i >> level, start.j >> level}, {goal.i >> level, goal.j >> level},
+                           0, counters.expanded);
+        if (!path.empty()) break;
+    }
+    counters.coarse_level = level;
+
+    // Refine the path one level at a time within a corridor around it.
+    for (--level; level >= 0 && !path.empty(); --level)
+    {
+        const OccupancyBits& coarse = pyramid.levels[level + 1];
+        uint32_t corridor_stamp = nextStamp(pyramid);
+        for (const Cell& c : path)
+        {
+            int i0 = std::max(c.i - corridor_radius, 0), i1 = std::min(c.i + corridor_radius, coarse.width - 1);
+            int j0 = std::max(c.j - corridor_radius, 0), j1 = std::min(c.j + corridor_radius, coarse.height - 1);
+            for (int j = j0; j <= j1; ++j)
+            {
+                for (int i = i0; i <= i1; ++i) pyramid.corridor[i + j * coarse.width] = corridor_stamp;
+            }
+        }
+        path = searchLevel(pyramid, level, {start.i >> level, start.j >> level}, {goal.i >> level, goal.j >> level},
+                           corridor_stamp, counters.expanded);
+    }
+
+    if (path.empty())
+    {
+        counters.fallback = counters.coarse_level > 0;
+        counters.coarse_level = 0;
+        path = searchLevel(pyramid, 0, start, goal, 0, counters.expanded);
+    }
+    return path;
+}
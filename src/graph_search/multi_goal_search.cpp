@@ -0,0 +1,118 @@
+#include <cmath>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/multi_goal_search.h>
+
+MultiGoalResult multiGoalSearch(GridGraph& graph, const Cell& start, const std::vector<Cell>& goals,
+                                const std::vector<float>& biases)
+{
+    MultiGoalResult result;
+    if (!isCellInBounds(start.i, start.j, graph)) return result;
+
+    // Keep the goals in bounds, and the one with the lowest bias at each cell.
+    int num_cells = graph.width * graph.height;
+    std::vector<int> goal_at(num_cells, -1), goal_cells;
+    std::vector<float> goal_biases(goals.size(), 0);
+    int x0 = graph.width, y0 = graph.height, x1 = -1, y1 = -1;
+    float min_bias = HIGH;
+    for (size_t k = 0; k < goals.size(); ++k)
+    {
+        const Cell& goal = goals[k];
+        if (!isCellInBounds(goal.i, goal.j, graph)) continue;
+        goal_biases[k] = k < biases.size() ? std::max(biases[k], 0.0f) : 0;
+        int& current = goal_at[cellToIdx(goal.i, goal.j, graph)];
+        if (current >= 0 && goal_biases[current] <= goal_biases[k]) continue;
+        if (current < 0) goal_cells.push_back(cellToIdx(goal.i, goal.j, graph));
+        current = k;
+
+        x0 = std::min(x0, goal.i);
+        y0 = std::min(y0, goal.j);
+        x1 = std::max(x1, goal.i);
+        y1 = std::max(y1, goal.j);
+        min_bias = std::min(min_bias, goal_biases[k]);
+    }
+    if (goal_cells.empty()) return result;
+
+    bool exact = goal_cells.size() <= MULTI_GOAL_EXACT_HEURISTIC_GOALS;
+    auto heuristic = [&](const Cell& c)
+    {
+        if (!exact)
+        {
+            Cell nearest = {std::min(std::max(c.i, x0), x1), std::min(std::max(c.j, y0), y1)};
+            return octileDistance(c, nearest) + min_bias;
+        }
+        float h = HIGH;
+        for (int goal_idx : goal_cells)
+        {
+            int k = goal_at[goal_idx];
+            h = std::min(h, octileDistance(c, goals[k]) + goal_biases[k]);
+        }
+        return h;
+    };
+
+    initGraph(graph);
+
+    // Every goal has an edge to a virtual target with the goal's bias as its
+    // cost. The target's index is one past the last cell.
+    int target = num_cells;
+    std::vector<float> costs(num_cells + 1, HIGH);
+    std::vector<int> parents(num_cells + 1, -1);
+    std::vector<bool> closed(num_cells + 1, false);
+
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    int start_idx = cellToIdx(start.i, start.j, graph);
+    costs[start_idx] = 0;
+    graph.nodes[start_idx].collision = 0;  // The start is never checked.
+    open_set.push({heuristic(start), start_idx});
+
+    // The heuristic is consistent, being the lowest of consistent ones, so no
+    // cell needs to be expanded twice.
+    while (!open_set.empty())
+    {
+        int current = open_set.top().second;
+        open_set.pop();
+        if (closed[current]) continue;
+        if (current == target) break;
+        if (checkExpandedCollision(current, graph)) continue;
+
+        closed[current] = true;
+        ++result.expanded;
+        Cell c = idxToCell(current, graph);
+        graph.visited_cells.push_back(c);
+
+        if (goal_at[current] >= 0 && costs[current] + goal_biases[goal_at[current]] < costs[target])
+        {
+            costs[target] = costs[current] + goal_biases[goal_at[current]];
+            parents[target] = current;
+            open_set.push({costs[target], target});
+        }
+
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph)) continue;
+            int neighbor = cellToIdx(ni, nj, graph);
+            if (closed[neighbor]) continue;
+            float tentative_cost = costs[current] + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (tentative_cost < costs[neighbor] && !checkNeighborCollision(neighbor, graph))
+            {
+                costs[neighbor] = tentative_cost;
+                parents[neighbor] = current;
+                open_set.push({tentative_cost + heuristic({ni, nj}), neighbor});
+            }
+        }
+    }
+    if (parents[target] < 0) return result;
+
+    for (int idx = parents[target]; idx != -1; idx = parents[idx]) result.path.push_back(idxToCell(idx, graph));
+    std::reverse(result.path.begin(), result.path.end());
+    result.goal_index = goal_at[parents[target]];
+    result.cost = costs[target];
+    return result;
+}
@@ -0,0 +1,220 @@
+#include <cmath>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/parallel_astar.h>
+
+/**
+ * Paths cheaper than the best known by less than this are taken as float
+ * rounding, and do not reopen a cell.
+ */
+static const float kCostTolerance = 1e-3;
+
+/**
+ * A node sent to the thread that owns its cell.
+ */
+struct ParallelAStarMessage
+{
+    int idx;
+    int parent;
+    float cost;
+};
+
+/**
+ * Nodes sent together. The batches waiting for a thread form a linked list,
+ * pushed onto by any thread and taken whole by the owner.
+ */
+struct ParallelAStarBatch
+{
+    std::vector<ParallelAStarMessage> messages;
+    ParallelAStarBatch* next = nullptr;
+};
+
+/**
+ * The thread that owns a cell, from a hash of its block.
+ */
+static int cellOwner(int i, int j, int num_threads)
+{
+    uint32_t h = static_cast<uint32_t>(i / PARALLEL_ASTAR_BLOCK_SIZE) * 0x9E3779B1u;
+    h ^= static_cast<uint32_t>(j / PARALLEL_ASTAR_BLOCK_SIZE) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0xC2B2AE3Du;
+    h ^= h >> 13;
+    return h % num_threads;
+}
+
+ParallelAStarResult parallelAStarSearch(GridGraph& graph, const Cell& start, const Cell& goal, int num_threads)
+{
+    ParallelAStarResult result;
+    if (num_threads <= 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    result.num_threads = num_threads;
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return result;
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    if (testBit(blocked, goal.i, goal.j)) return result;
+
+    // Each cell's cost and parent are only ever touched by its owner until
+    // every thread has joined.
+    int num_cells = graph.width * graph.height;
+    std::vector<float> costs(num_cells, HIGH);
+    std::vector<int> parents(num_cells, -1);
+    std::vector<uint8_t> expanded(num_cells, 0);
+    int start_idx = cellToIdx(start.i, start.j, graph), goal_idx = cellToIdx(goal.i, goal.j, graph);
+
+    std::vector<std::atomic<ParallelAStarBatch*>> inboxes(num_threads);
+    for (auto& inbox : inboxes) inbox.store(nullptr);
+    std::atomic<float> best_cost(HIGH);
+
+    // The threads that are busy plus the nodes in flight. A thread counts
+    // itself before taking nodes off its inbox and only stops counting once
+    // it has sent everything it generated, so when this reaches zero no
+    // thread can ever have work again.
+    std::atomic<int64_t> work(num_threads);
+
+    std::vector<std::vector<Cell>> visited(num_threads);
+    std::vector<int64_t> thread_expanded(num_threads, 0), thread_reexpanded(num_threads, 0),
+        thread_messages(num_threads, 0);
+
+    auto worker = [&](int self)
+    {
+        using Entry = std::pair<float, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+        std::vector<ParallelAStarBatch*> outboxes(num_threads, nullptr);
+        bool busy = true;
+
+        auto receive = [&](int idx, int parent, float cost)
+        {
+            if (cost >= costs[idx] - kCostTolerance) return;
+            costs[idx] = cost;
+            parents[idx] = parent;
+            float score = cost + octileDistance(idxToCell(idx, graph), goal);
+            if (score < best_cost.load(std::memory_order_relaxed)) open_set.push({score, idx});
+        };
+        auto send = [&](int owner)
+        {
+            ParallelAStarBatch* batch = outboxes[owner];
+            if (batch == nullptr) return;
+            outboxes[owner] = nullptr;
+            work += batch->messages.size();
+            thread_messages[self] += batch->messages.size();
+            batch->next = inboxes[owner].load(std::memory_order_relaxed);
+            while (!inboxes[owner].compare_exchange_weak(batch->next, batch, std::memory_order_release,
+                                                         std::memory_order_relaxed))
+            {
+            }
+        };
+
+        if (self == cellOwner(start.i, start.j, num_threads)) receive(start_idx, -1, 0);
+
+        while (true)
+        {
+            ParallelAStarBatch* batch = inboxes[self].exchange(nullptr, std::memory_order_acquire);
+            if (batch != nullptr && !busy)
+            {
+                ++work;
+                busy = true;
+            }
+            while (batch != nullptr)
+            {
+                for (const ParallelAStarMessage& message : batch->messages)
+                {
+                    receive(message.idx, message.parent, message.cost);
+                }
+                work -= batch->messages.size();
+                ParallelAStarBatch* next = batch->next;
+                delete batch;
+                batch = next;
+            }
+
+            // Skip nodes made stale by a cheaper path or pruned by the best
+            // path to the goal so far.
+            while (!open_set.empty())
+            {
+                float score = open_set.top().first;
+                int idx = open_set.top().second;
+                if (score <= costs[idx] + octileDistance(idxToCell(idx, graph), goal) + 1e-4 &&
+                    score < best_cost.load(std::memory_order_relaxed))
+                {
+                    break;
+                }
+                open_set.pop();
+            }
+
+            if (!open_set.empty())
+            {
+                int current = open_set.top().second;
+                open_set.pop();
+                float cost = costs[current];
+                Cell c = idxToCell(current, graph);
+                ++thread_expanded[self];
+                if (expanded[current]) ++thread_reexpanded[self];
+                expanded[current] = 1;
+                visited[self].push_back(c);
+
+                if (current == goal_idx)
+                {
+                    float best = best_cost.load();
+                    while (cost < best && !best_cost.compare_exchange_weak(best, cost))
+                    {
+                    }
+                    continue;
+                }
+
+                for (const auto& step : kNeighborSteps)
+                {
+                    int ni = c.i + step[0], nj = c.j + step[1];
+                    if (!isCellInBounds(ni, nj, graph) || testBit(blocked, ni, nj)) continue;
+                    int neighbor = cellToIdx(ni, nj, graph);
+                    float next_cost = cost + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+                    if (next_cost + octileDistance({ni, nj}, goal) >= best_cost.load(std::memory_order_relaxed)) continue;
+
+                    int owner = cellOwner(ni, nj, num_threads);
+                    if (owner == self)
+                    {
+                        receive(neighbor, current, next_cost);
+                        continue;
+                    }
+                    if (outboxes[owner] == nullptr) outboxes[owner] = new ParallelAStarBatch();
+                    outboxes[owner]->messages.push_back({neighbor, current, next_cost});
+                    if (outboxes[owner]->messages.size() >= PARALLEL_ASTAR_BATCH_SIZE) send(owner);
+                }
+                continue;
+            }
+
+            // Nothing left to expand, so send everything held back and wait
+            // for more nodes or for every thread to be done.
+            for (int owner = 0; owner < num_threads; ++owner) send(owner);
+            if (busy)
+            {
+                busy = false;
+                --work;
+            }
+            if (work.load() == 0) break;
+            std::this_thread::yield();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; ++t) threads.emplace_back(worker, t);
+    worker(0);
+    for (auto& thread : threads) thread.join();
+
+    for (int t = 0; t < num_threads; ++t)
+    {
+        result.expanded += thread_expanded[t];
+        result.reexpanded += thread_reexpanded[t];
+        result.messages += thread_messages[t];
+        graph.visited_cells.insert(graph.visited_cells.end(), visited[t].begin(), visited[t].end());
+    }
+    if (costs[goal_idx] >= HIGH) return result;
+
+    result.cost = costs[goal_idx];
+    for (int idx = goal_idx; idx != -1; idx = parents[idx]) result.path.push_back(idxToCell(idx, graph));
+    std::reverse(result.path.begin(), result.path.end());
+    return result;
+}
@@ -0,0 +1,198 @@
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include <algorithm>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/bounded_search.h>
+#include <path_planning/graph_search/path_cache.h>
+
+/**
+ * The key of a cell in the cell index of a path cache.
+ */
+static uint64_t cellKey(const Cell& c)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(c.i)) << 32) | static_cast<uint32_t>(c.j);
+}
+
+size_t PathCacheKeyHash::operator()(const PathCacheKey& key) const
+{
+    uint32_t radius_bits;
+    std::memcpy(&radius_bits, &key.collision_radius, sizeof(radius_bits));
+    uint64_t h = radius_bits;
+    for (int value : {key.start_i, key.start_j, key.goal_i, key.goal_j})
+    {
+        h = (h ^ static_cast<uint32_t>(value)) * 0x100000001B3ull;
+    }
+    return static_cast<size_t>(h ^ (h >> 29));
+}
+
+PathCache::PathCache(size_t max_bytes, Planner planner) :
+    max_bytes_(max_bytes),
+    planner_(planner)
+{
+    if (!planner_)
+    {
+        planner_ = [](GridGraph& graph, const Cell& start, const Cell& goal)
+        {
+            return weightedAStarSearch(graph, start, goal, 1).path;
+        };
+    }
+}
+
+std::vector<Cell> PathCache::findPath(GridGraph& graph, const Cell& start, const Cell& goal)
+{
+    using Clock = std::chrono::steady_clock;
+    auto begin = Clock::now();
+    auto elapsed = [&]() { return std::chrono::duration<double>(Clock::now() - begin).count(); };
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return {};
+
+    PathCacheKey key = {graph.collision_radius, start.i, start.j, goal.i, goal.j};
+    auto found = by_key_.find(key);
+    if (found != by_key_.end())
+    {
+        auto entry = by_id_[found->second];
+        if (validate(graph, entry))
+        {
+            ++hits_;
+            touch(entry);
+            std::vector<Cell> path = entry->path;
+            saved_seconds_ += entry->plan_seconds - elapsed();
+            return path;
+        }
+    }
+
+    // Look for a cached path through both the start and the goal.
+    auto start_cells = by_cell_.find(cellKey(start)), goal_cells = by_cell_.find(cellKey(goal));
+    if (start_cells != by_cell_.end() && goal_cells != by_cell_.end())
+    {
+        std::vector<Occurrence> from, to;
+        for (const Occurrence& s : start_cells->second)
+        {
+            for (const Occurrence& g : goal_cells->second)
+            {
+                if (s.id != g.id) continue;
+                from.push_back(s);
+                to.push_back(g);
+            }
+        }
+        for (size_t k = 0; k < from.size(); ++k)
+        {
+            auto it = by_id_.find(from[k].id);
+            if (it == by_id_.end()) continue;
+            auto entry = it->second;
+            if (entry->collision_radius != graph.collision_radius || !validate(graph, entry)) continue;
+
+            int first = from[k].position, last = to[k].position;
+            std::vector<Cell> path;
+            if (first <= last)
+            {
+                path.assign(entry->path.begin() + first, entry->path.begin() + last + 1);
+            }
+            else
+            {
+                path.assign(entry->path.rbegin() + (entry->path.size() - 1 - first),
+                            entry->path.rbegin() + (entry->path.size() - last));
+            }
+            ++subpath_hits_;
+            touch(entry);
+            saved_seconds_ += entry->plan_seconds - elapsed();
+            return path;
+        }
+    }
+
+    ++misses_;
+    std::vector<Cell> path = planner_(graph, start, goal);
+    double plan_seconds = elapsed();
+    if (!path.empty()) insert(graph, start, goal, path, plan_seconds);
+    return path;
+}
+
+void PathCache::clear()
+{
+    entries_.clear();
+    by_id_.clear();
+    by_key_.clear();
+    by_cell_.clear();
+    bytes_ = 0;
+}
+
+double PathCache::hitRate() const
+{
+    int64_t queries = hits_ + subpath_hits_ + misses_;
+    return queries > 0 ? static_cast<double>(hits_ + subpath_hits_) / queries : 0;
+}
+
+bool PathCache::validate(GridGraph& graph, EntryList::iterator entry)
+{
+    if (entry->map_version == graph.map_version) return true;
+    if (entry->width != graph.width || entry->height != graph.height)
+    {
+        ++invalidated_;
+        erase(entry);
+        return false;
+    }
+
+    // The start of a path is never checked by the planners, so only the
+    // cells after it need to be free.
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    for (size_t k = 1; k < entry->path.size(); ++k)
+    {
+        if (testBit(blocked, entry->path[k].i, entry->path[k].j))
+        {
+            ++invalidated_;
+            erase(entry);
+            return false;
+        }
+    }
+    ++revalidated_;
+    entry->map_version = graph.map_version;
+    return true;
+}
+
+void PathCache::touch(EntryList::iterator entry)
+{
+    entries_.splice(entries_.begin(), entries_, entry);
+}
+
+void PathCache::erase(EntryList::iterator entry)
+{
+    for (const Cell& c : entry->path)
+    {
+        auto cell = by_cell_.find(cellKey(c));
+        if (cell == by_cell_.end()) continue;
+        std::vector<Occurrence>& occurrences = cell->second;
+        occurrences.erase(std::remove_if(occurrences.begin(), occurrences.end(),
+                                         [&](const Occurrence& o) { return o.id == entry->id; }),
+                          occurrences.end());
+        if (occurrences.empty()) by_cell_.erase(cell);
+    }
+    by_key_.erase({entry->collision_radius, entry->start.i, entry->start.j, entry->goal.i, entry->goal.j});
+    by_id_.erase(entry->id);
+    bytes_ -= entry->bytes;
+    entries_.erase(entry);
+}
+
+void PathCache::insert(GridGraph& graph, const Cell& start, const Cell& goal, const std::vector<Cell>& path,
+                       double plan_seconds)
+{
+    size_t bytes = sizeof(PathCacheEntry) + path.size() * (sizeof(Cell) + sizeof(Occurrence));
+    if (bytes > max_bytes_) return;
+    while (!entries_.empty() && bytes_ + bytes > max_bytes_)
+    {
+        ++evicted_;
+        erase(std::prev(entries_.end()));
+    }
+
+    PathCacheKey key = {graph.collision_radius, start.i, start.j, goal.i, goal.j};
+    auto found = by_key_.find(key);
+    if (found != by_key_.end()) erase(by_id_[found->second]);
+
+    uint64_t id = next_id_++;
+    entries_.push_front({id, start, goal, graph.collision_radius, graph.map_version, graph.width, graph.height, path,
+                         plan_seconds, bytes});
+    by_id_[id] = entries_.begin();
+    by_key_[key] = id;
+    for (size_t k = 0; k < path.size(); ++k) by_cell_[cellKey(path[k])].push_back({id, static_cast<int>(k)});
+    bytes_ += bytes;
+}
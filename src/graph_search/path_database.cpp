@@ -0,0 +1,281 @@
+#include <cmath>
+#include <queue>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <utility>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/graph_search/path_database.h>
+
+#define PATH_DATABASE_MAGIC "P3CPD001"
+
+/**
+ * The header of a serialized path database. It is followed by the ranks,
+ * rank cells, run offsets and runs arrays, each starting on an 8 byte
+ * boundary.
+ */
+struct PathDatabaseHeader
+{
+    char magic[8];
+    uint32_t width, height;
+    float collision_radius;
+    int32_t threshold;
+    uint64_t odds_checksum;
+    uint64_t num_free, num_runs;
+};
+
+/**
+ * Interleaves the bits of a cell's coordinates to get its position along the
+ * Z-order curve.
+ */
+static uint64_t mortonCode(uint32_t i, uint32_t j)
+{
+    uint64_t code = 0;
+    for (int bit = 0; bit < 32; ++bit)
+    {
+        code |= (static_cast<uint64_t>((i >> bit) & 1) << (2 * bit)) |
+                (static_cast<uint64_t>((j >> bit) & 1) << (2 * bit + 1));
+    }
+    return code;
+}
+
+/**
+ * Checksum of the map data a database depends on.
+ */
+static uint64_t mapChecksum(const GridGraph& graph)
+{
+    return fnv1aChecksum(graph.cell_odds.data(), graph.cell_odds.size());
+}
+
+void buildPathDatabase(GridGraph& graph, PathDatabase& db, int num_threads)
+{
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    db = PathDatabase();
+    db.width = graph.width;
+    db.height = graph.height;
+    db.collision_radius = graph.collision_radius;
+    db.threshold = graph.threshold;
+    db.odds_checksum = mapChecksum(graph);
+
+    // Rank the free cells along the Z-order curve.
+    std::vector<std::pair<uint64_t, uint32_t>> order;
+    for (int j = 0; j < graph.height; ++j)
+    {
+        for (int i = 0; i < graph.width; ++i)
+        {
+            if (!testBit(blocked, i, j)) order.push_back({mortonCode(i, j), cellToIdx(i, j, graph)});
+        }
+    }
+    std::sort(order.begin(), order.end());
+    const int num_free = order.size();
+    db.ranks.assign(graph.width * graph.height, -1);
+    db.rank_cells.resize(num_free);
+    for (int rank = 0; rank < num_free; ++rank)
+    {
+        db.rank_cells[rank] = order[rank].second;
+        db.ranks[order[rank].second] = rank;
+    }
+
+    // Each thread takes the next source and runs Dijkstra from it, recording
+    // the first move along the way to every cell, then run length encodes
+    // the moves in rank order.
+    std::vector<std::vector<uint32_t>> source_runs(num_free);
+    std::atomic<int> next_source(0);
+    auto worker = [&]()
+    {
+        std::vector<float> costs(num_free);
+        std::vector<uint8_t> moves(num_free);
+        using Entry = std::pair<float, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+
+        for (int source = next_source++; source < num_free; source = next_source++)
+        {
+            std::fill(costs.begin(), costs.end(), HIGH);
+            std::fill(moves.begin(), moves.end(), PATH_DATABASE_NO_MOVE);
+            costs[source] = 0;
+            open_set.push({0, source});
+
+            while (!open_set.empty())
+            {
+                float cost = open_set.top().first;
+                int current = open_set.top().second;
+                open_set.pop();
+                if (cost > costs[current]) continue;
+
+                Cell c = idxToCell(db.rank_cells[current], graph);
+                for (int k = 0; k < 8; ++k)
+                {
+                    int ni = c.i + kNeighborSteps[k][0], nj = c.j + kNeighborSteps[k][1];
+                    if (!isCellInBounds(ni, nj, graph)) continue;
+                    int neighbor = db.ranks[cellToIdx(ni, nj, graph)];
+                    if (neighbor < 0) continue;
+
+                    float tentative_cost = cost + (kNeighborSteps[k][0] != 0 && kNeighborSteps[k][1] != 0 ? M_SQRT2 : 1);
+                    if (tentative_cost < costs[neighbor])
+                    {
+                        costs[neighbor] = tentative_cost;
+                        moves[neighbor] = current == source ? k : moves[current];
+                        open_set.push({tentative_cost, neighbor});
+                    }
+                }
+            }
+
+            // The source's own move is never looked up, so it joins whichever
+            // run it falls in. The first run always starts at rank 0.
+            std::vector<uint32_t>& runs = source_runs[source];
+            int last_move = -1;
+            for (int rank = 0; rank < num_free; ++rank)
+            {
+                if (rank == source || moves[rank] == last_move) continue;
+                runs.push_back((runs.empty() ? 0 : static_cast<uint32_t>(rank) << 4) | moves[rank]);
+                last_move = moves[rank];
+            }
+            runs.shrink_to_fit();
+        }
+    };
+
+    if (num_threads <= 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; ++t) threads.emplace_back(worker);
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    db.run_offsets.resize(num_free + 1);
+    db.run_offsets[0] = 0;
+    for (int rank = 0; rank < num_free; ++rank)
+    {
+        db.run_offsets[rank + 1] = db.run_offsets[rank] + source_runs[rank].size();
+    }
+    db.runs.resize(db.run_offsets[num_free]);
+    for (int rank = 0; rank < num_free; ++rank)
+    {
+        std::copy(source_runs[rank].begin(), source_runs[rank].end(), db.runs.begin() + db.run_offsets[rank]);
+        std::vector<uint32_t>().swap(source_runs[rank]);
+    }
+}
+
+int pathDatabaseMove(const PathDatabase& db, int source, int target)
+{
+    int source_rank = db.ranks[source], target_rank = db.ranks[target];
+    if (source_rank < 0 || target_rank < 0 || source_rank == target_rank) return PATH_DATABASE_NO_MOVE;
+
+    const uint32_t* begin = db.runs.data() + db.run_offsets[source_rank];
+    const uint32_t* end = db.runs.data() + db.run_offsets[source_rank + 1];
+    if (begin == end) return PATH_DATABASE_NO_MOVE;
+    const uint32_t* run = std::upper_bound(begin, end, (static_cast<uint32_t>(target_rank) << 4) | 15u) - 1;
+    return *run & 15;
+}
+
+std::vector<Cell> pathDatabasePath(const PathDatabase& db, const Cell& start, const Cell& goal)
+{
+    if (start.i < 0 || start.j < 0 || start.i >= db.width || start.j >= db.height ||
+        goal.i < 0 || goal.j < 0 || goal.i >= db.width || goal.j >= db.height)
+    {
+        return {};
+    }
+    int goal_idx = goal.i + goal.j * db.width;
+    if (db.ranks[start.i + start.j * db.width] < 0 || db.ranks[goal_idx] < 0) return {};
+
+    std::vector<Cell> path = {start};
+    Cell c = start;
+    while (c.i != goal.i || c.j != goal.j)
+    {
+        int move = pathDatabaseMove(db, c.i + c.j * db.width, goal_idx);
+        if (move == PATH_DATABASE_NO_MOVE || path.size() > db.rank_cells.size()) return {};
+        c.i += kNeighborSteps[move][0];
+        c.j += kNeighborSteps[move][1];
+        path.push_back(c);
+    }
+    return path;
+}
+
+size_t pathDatabaseBytes(const PathDatabase& db)
+{
+    return sizeof(db) + db.ranks.size() * sizeof(int32_t) + db.rank_cells.size() * sizeof(uint32_t) +
+           db.run_offsets.size() * sizeof(uint64_t) + db.runs.size() * sizeof(uint32_t);
+}
+
+bool isPathDatabaseFor(const PathDatabase& db, const GridGraph& graph)
+{
+    return db.width == graph.width && db.height == graph.height && db.threshold == graph.threshold &&
+           db.collision_radius == graph.collision_radius && db.odds_checksum == mapChecksum(graph);
+}
+
+/**
+ * Rounds a size up to a multiple of 8 bytes.
+ */
+static uint64_t align8(uint64_t size)
+{
+    return (size + 7) & ~static_cast<uint64_t>(7);
+}
+
+bool savePathDatabase(const std::string& file_path, const PathDatabase& db)
+{
+    PathDatabaseHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PATH_DATABASE_MAGIC, sizeof(header.magic));
+    header.width = db.width;
+    header.height = db.height;
+    header.collision_radius = db.collision_radius;
+    header.threshold = db.threshold;
+    header.odds_checksum = db.odds_checksum;
+    header.num_free = db.rank_cells.size();
+    header.num_runs = db.runs.size();
+
+    std::vector<char> data;
+    auto append = [&data](const void* values, uint64_t size)
+    {
+        data.insert(data.end(), static_cast<const char*>(values), static_cast<const char*>(values) + size);
+        data.resize(align8(data.size()));
+    };
+    append(&header, sizeof(header));
+    append(db.ranks.data(), db.ranks.size() * sizeof(int32_t));
+    append(db.rank_cells.data(), db.rank_cells.size() * sizeof(uint32_t));
+    append(db.run_offsets.data(), db.run_offsets.size() * sizeof(uint64_t));
+    append(db.runs.data(), db.runs.size() * sizeof(uint32_t));
+    return saveBinaryMapDatabase(file_path, data.data(), data.size());
+}
+
+bool loadPathDatabase(const std::string& file_path, PathDatabase& db, bool verify_checksum)
+{
+    const char* data;
+    uint64_t size;
+    std::shared_ptr<const void> mapping;
+    if (!loadBinaryMapDatabase(file_path, data, size, mapping, verify_checksum)) return false;
+
+    PathDatabaseHeader header;
+    if (size < sizeof(header)) return false;
+    std::memcpy(&header, data, sizeof(header));
+    uint64_t num_cells = static_cast<uint64_t>(header.width) * header.height;
+    uint64_t ranks_offset = align8(sizeof(header));
+    uint64_t cells_offset = ranks_offset + align8(num_cells * sizeof(int32_t));
+    uint64_t offsets_offset = cells_offset + align8(header.num_free * sizeof(uint32_t));
+    uint64_t runs_offset = offsets_offset + align8((header.num_free + 1) * sizeof(uint64_t));
+    if (std::memcmp(header.magic, PATH_DATABASE_MAGIC, sizeof(header.magic)) != 0 ||
+        runs_offset + header.num_runs * sizeof(uint32_t) > size)
+    {
+        std::cerr << "ERROR: loadPathDatabase: Invalid path database in " << file_path << std::endl;
+        return false;
+    }
+
+    db = PathDatabase();
+    db.width = header.width;
+    db.height = header.height;
+    db.collision_radius = header.collision_radius;
+    db.threshold = header.threshold;
+    db.odds_checksum = header.odds_checksum;
+    db.ranks.setExternal(reinterpret_cast<int32_t*>(const_cast<char*>(data + ranks_offset)), num_cells, mapping);
+    db.rank_cells.setExternal(reinterpret_cast<uint32_t*>(const_cast<char*>(data + cells_offset)),
+                              header.num_free, mapping);
+    db.run_offsets.setExternal(reinterpret_cast<uint64_t*>(const_cast<char*>(data + offsets_offset)),
+                               header.num_free + 1, mapping);
+    db.runs.setExternal(reinterpret_cast<uint32_t*>(const_cast<char*>(data + runs_offset)), header.num_runs,
+                        mapping);
+    return true;
+}
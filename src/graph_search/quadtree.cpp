@@ -0,0 +1,212 @@
+#include <cmath>
+#include <chrono>
+#include <queue>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/quadtree.h>
+
+/**
+ * Adds the free leaves of the square of the given size at (x0, y0), clipped
+ * to the map, splitting it while it has both free and blocked cells.
+ */
+static void splitSquare(const OccupancyBits& blocked, int x0, int y0, int size, QuadtreeMap& quadtree)
+{
+    int x1 = std::min(x0 + size, quadtree.width), y1 = std::min(y0 + size, quadtree.height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    int64_t num_blocked = countSetBits(blocked, x0, y0, x1 - 1, y1 - 1);
+    if (num_blocked == 0)
+    {
+        int leaf = quadtree.leaves.size();
+        quadtree.leaves.push_back({x0, y0, x1, y1});
+        for (int j = y0; j < y1; ++j)
+        {
+            std::fill(quadtree.leaf_of_cell.begin() + j * quadtree.width + x0,
+                      quadtree.leaf_of_cell.begin() + j * quadtree.width + x1, leaf);
+        }
+        return;
+    }
+    if (num_blocked == static_cast<int64_t>(x1 - x0) * (y1 - y0)) return;
+
+    int half = size / 2;
+    splitSquare(blocked, x0, y0, half, quadtree);
+    splitSquare(blocked, x0 + half, y0, half, quadtree);
+    splitSquare(blocked, x0, y0 + half, half, quadtree);
+    splitSquare(blocked, x0 + half, y0 + half, half, quadtree);
+}
+
+void buildQuadtree(GridGraph& graph, QuadtreeMap& quadtree)
+{
+    auto build_start = std::chrono::steady_clock::now();
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    quadtree = QuadtreeMap();
+    quadtree.width = graph.width;
+    quadtree.height = graph.height;
+    quadtree.map_version = graph.map_version;
+    quadtree.leaf_of_cell.assign(graph.width * graph.height, -1);
+
+    int size = 1;
+    while (size < graph.width || size < graph.height) size *= 2;
+    splitSquare(blocked, 0, 0, size, quadtree);
+
+    // Find the neighbors of each leaf from the ring of cells around it.
+    int num_leaves = quadtree.leaves.size();
+    quadtree.neighbor_offsets.assign(num_leaves + 1, 0);
+    std::vector<int> ring;
+    for (int leaf = 0; leaf < num_leaves; ++leaf)
+    {
+        const QuadLeaf& rect = quadtree.leaves[leaf];
+        ring.clear();
+        auto addCell = [&](int i, int j)
+        {
+            if (i < 0 || j < 0 || i >= graph.width || j >= graph.height) return;
+            int neighbor = quadtree.leaf_of_cell[i + j * graph.width];
+            if (neighbor >= 0) ring.push_back(neighbor);
+        };
+        for (int i = rect.x0 - 1; i <= rect.x1; ++i)
+        {
+            addCell(i, rect.y0 - 1);
+            addCell(i, rect.y1);
+        }
+        for (int j = rect.y0; j < rect.y1; ++j)
+        {
+            addCell(rect.x0 - 1, j);
+            addCell(rect.x1, j);
+        }
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+        quadtree.neighbors.insert(quadtree.neighbors.end(), ring.begin(), ring.end());
+        quadtree.neighbor_offsets[leaf + 1] = quadtree.neighbors.size();
+    }
+
+    quadtree.build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - build_start).count();
+}
+
+size_t quadtreeBytes(const QuadtreeMap& quadtree)
+{
+    return sizeof(quadtree) + quadtree.leaves.capacity() * sizeof(QuadLeaf) +
+           (quadtree.leaf_of_cell.capacity() + quadtree.neighbor_offsets.capacity() +
+            quadtree.neighbors.capacity()) * sizeof(int);
+}
+
+/**
+ * Appends the cells of an octile path from one cell to another, not counting
+ * the first. Diagonal steps come first, so the path stays inside the
+ * bounding box of the two cells.
+ */
+static void appendWalk(Cell from, const Cell& to, std::vector<Cell>& path)
+{
+    while (from.i != to.i || from.j != to.j)
+    {
+        from.i += (to.i > from.i) - (to.i < from.i);
+        from.j += (to.j > from.j) - (to.j < from.j);
+        path.push_back(from);
+    }
+}
+
+std::vector<Cell> quadtreeSearch(GridGraph& graph, const QuadtreeMap& quadtree, const Cell& start, const Cell& goal,
+                                 QuadtreeSearchStats* stats)
+{
+    QuadtreeSearchStats local_stats;
+    QuadtreeSearchStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = QuadtreeSearchStats();
+
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return {};
+    int start_leaf = quadtree.leaf_of_cell[cellToIdx(start.i, start.j, graph)];
+    int goal_leaf = quadtree.leaf_of_cell[cellToIdx(goal.i, goal.j, graph)];
+    if (start_leaf < 0 || goal_leaf < 0) return {};
+
+    // Each leaf keeps the cell it was entered at, and the cell of its parent
+    // leaf that the path crossed over from.
+    int num_leaves = quadtree.leaves.size();
+    std::vector<float> costs(num_leaves, HIGH), estimates(num_leaves, HIGH);
+    std::vector<Cell> entries(num_leaves), exits(num_leaves);
+    std::vector<int> parents(num_leaves, -1);
+    std::vector<bool> closed(num_leaves, false);
+
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    costs[start_leaf] = 0;
+    entries[start_leaf] = start;
+    estimates[start_leaf] = octileDistance(start, goal);
+    open_set.push({estimates[start_leaf], start_leaf});
+
+    while (!open_set.empty())
+    {
+        int current = open_set.top().second;
+        open_set.pop();
+        if (closed[current]) continue;
+        closed[current] = true;
+        ++counters.leaves_expanded;
+        graph.visited_cells.push_back(entries[current]);
+        if (current == goal_leaf) break;
+
+        const QuadLeaf& rect = quadtree.leaves[current];
+        const Cell& entry = entries[current];
+        for (int k = quadtree.neighbor_offsets[current]; k < quadtree.neighbor_offsets[current + 1]; ++k)
+        {
+            int neighbor = quadtree.neighbors[k];
+            if (closed[neighbor]) continue;
+
+            // The neighbor's cells next to this leaf form a strip one cell
+            // wide. Try each of them with each of the cells of this leaf
+            // they touch.
+            const QuadLeaf& other = quadtree.leaves[neighbor];
+            int i0 = std::max(other.x0, rect.x0 - 1), i1 = std::min(other.x1 - 1, rect.x1);
+            int j0 = std::max(other.y0, rect.y0 - 1), j1 = std::min(other.y1 - 1, rect.y1);
+            float best_estimate = HIGH, best_cost = HIGH;
+            Cell best_entry = {-1, -1}, best_exit = {-1, -1};
+            for (int j = j0; j <= j1; ++j)
+            {
+                for (int i = i0; i <= i1; ++i)
+                {
+                    Cell next = {i, j};
+                    float remaining = octileDistance(next, goal);
+                    for (int ej = std::max(j - 1, rect.y0); ej <= std::min(j + 1, rect.y1 - 1); ++ej)
+                    {
+                        for (int ei = std::max(i - 1, rect.x0); ei <= std::min(i + 1, rect.x1 - 1); ++ei)
+                        {
+                            Cell exit = {ei, ej};
+                            float cost = costs[current] + octileDistance(entry, exit) + octileDistance(exit, next);
+                            if (cost + remaining < best_estimate)
+                            {
+                                best_estimate = cost + remaining;
+                                best_cost = cost;
+                                best_entry = next;
+                                best_exit = exit;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if (best_estimate < estimates[neighbor])
+            {
+                estimates[neighbor] = best_estimate;
+                costs[neighbor] = best_cost;
+                entries[neighbor] = best_entry;
+                exits[neighbor] = best_exit;
+                parents[neighbor] = current;
+                open_set.push({best_estimate, neighbor});
+            }
+        }
+    }
+    if (!closed[goal_leaf]) return {};
+
+    std::vector<int> leaf_path;
+    for (int leaf = goal_leaf; leaf != -1; leaf = parents[leaf]) leaf_path.push_back(leaf);
+    std::reverse(leaf_path.begin(), leaf_path.end());
+
+    std::vector<Cell> path = {start};
+    for (size_t k = 1; k < leaf_path.size(); ++k)
+    {
+        appendWalk(path.back(), exits[leaf_path[k]], path);
+        path.push_back(entries[leaf_path[k]]);
+    }
+    appendWalk(path.back(), goal, path);
+    return path;
+}
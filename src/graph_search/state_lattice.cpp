@@ -0,0 +1,423 @@
+#include <cmath>
+#include <queue>
+#include <tuple>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/state_lattice.h>
+
+/**
+ * The direction of each heading. Every heading has a short step that ends on
+ * a cell center, so straight motions stay on the lattice.
+ */
+static const int kHeadingVectors[LATTICE_NUM_HEADINGS][2] = {
+    {1, 0}, {2, 1}, {1, 1}, {1, 2}, {0, 1}, {-1, 2}, {-1, 1}, {-2, 1},
+    {-1, 0}, {-2, -1}, {-1, -1}, {-1, -2}, {0, -1}, {1, -2}, {1, -1}, {2, -1}};
+
+/**
+ * Samples per cell of chord length when sampling a motion. Samples closer
+ * than half a cell apart keep the swept cells 8-connected.
+ */
+static const int kSamplesPerCell = 40;
+
+float latticeHeadingAngle(int heading)
+{
+    return std::atan2(static_cast<float>(kHeadingVectors[heading][1]), static_cast<float>(kHeadingVectors[heading][0]));
+}
+
+int latticeHeadingIndex(float theta)
+{
+    int best = 0;
+    float best_diff = HIGH;
+    for (int heading = 0; heading < LATTICE_NUM_HEADINGS; ++heading)
+    {
+        float diff = std::abs(std::remainder(theta - latticeHeadingAngle(heading), 2 * static_cast<float>(M_PI)));
+        if (diff < best_diff)
+        {
+            best_diff = diff;
+            best = heading;
+        }
+    }
+    return best;
+}
+
+/**
+ * Samples the cubic Hermite curve from the origin at one heading to (di, dj)
+ * at another, with both tangents as long as the chord.
+ * @param[out]  samples The (x, y, theta) samples, including both ends.
+ * @return  The length of the curve, or a negative number if its curvature is
+ *          ever tighter than LATTICE_MIN_TURN_RADIUS allows.
+ */
+static float sampleTurn(int start_heading, int end_heading, int di, int dj, std::vector<std::array<float, 3>>& samples)
+{
+    float chord = std::sqrt(static_cast<float>(di * di + dj * dj));
+    float a0 = latticeHeadingAngle(start_heading), a1 = latticeHeadingAngle(end_heading);
+    float m0x = chord * std::cos(a0), m0y = chord * std::sin(a0);
+    float m1x = chord * std::cos(a1), m1y = chord * std::sin(a1);
+
+    int num_samples = static_cast<int>(std::ceil(chord * kSamplesPerCell));
+    samples.clear();
+    float length = 0;
+    for (int k = 0; k <= num_samples; ++k)
+    {
+        float t = static_cast<float>(k) / num_samples, t2 = t * t, t3 = t2 * t;
+        float x = (t3 - 2 * t2 + t) * m0x + (-2 * t3 + 3 * t2) * di + (t3 - t2) * m1x;
+        float y = (t3 - 2 * t2 + t) * m0y + (-2 * t3 + 3 * t2) * dj + (t3 - t2) * m1y;
+        float dx = (3 * t2 - 4 * t + 1) * m0x + (-6 * t2 + 6 * t) * di + (3 * t2 - 2 * t) * m1x;
+        float dy = (3 * t2 - 4 * t + 1) * m0y + (-6 * t2 + 6 * t) * dj + (3 * t2 - 2 * t) * m1y;
+        float ddx = (6 * t - 4) * m0x + (-12 * t + 6) * di + (6 * t - 2) * m1x;
+        float ddy = (6 * t - 4) * m0y + (-12 * t + 6) * dj + (6 * t - 2) * m1y;
+        float speed = std::sqrt(dx * dx + dy * dy);
+        if (speed < 1e-6 || std::abs(dx * ddy - dy * ddx) > speed * speed * speed / LATTICE_MIN_TURN_RADIUS) return -1;
+
+        if (k > 0) length += std::hypot(x - samples.back()[0], y - samples.back()[1]);
+        samples.push_back({x, y, std::atan2(dy, dx)});
+    }
+    samples.back() = {static_cast<float>(di), static_cast<float>(dj), a1};
+    return length;
+}
+
+/**
+ * Fills in the swept cells and poses of a primitive from samples along it.
+ */
+static void finishPrimitive(const std::vector<std::array<float, 3>>& samples, float length, MotionPrimitive& primitive)
+{
+    for (const auto& sample : samples)
+    {
+        Cell c = {static_cast<int>(std::lround(sample[0])), static_cast<int>(std::lround(sample[1]))};
+        if (c.i == 0 && c.j == 0) continue;
+        bool seen = std::any_of(primitive.swept.begin(), primitive.swept.end(),
+                                [&](const Cell& other) { return other.i == c.i && other.j == c.j; });
+        if (!seen) primitive.swept.push_back(c);
+    }
+
+    // Poses about a cell apart along the curve, ending exactly at its end.
+    int num_poses = std::max(1, static_cast<int>(std::lround(length)));
+    float travelled = 0;
+    int next_pose = 1;
+    for (size_t k = 1; k < samples.size() && next_pose < num_poses; ++k)
+    {
+        travelled += std::hypot(samples[k][0] - samples[k - 1][0], samples[k][1] - samples[k - 1][1]);
+        if (travelled >= length * next_pose / num_poses)
+        {
+            primitive.poses.push_back(samples[k]);
+            ++next_pose;
+        }
+    }
+    primitive.poses.push_back(samples.back());
+    primitive.cost = length;
+}
+
+/**
+ * Makes the straight primitive along a heading covering the given number of
+ * short steps.
+ */
+static MotionPrimitive makeStraight(int heading, int steps)
+{
+    MotionPrimitive primitive;
+    primitive.start_heading = primitive.end_heading = heading;
+    primitive.di = steps * kHeadingVectors[heading][0];
+    primitive.dj = steps * kHeadingVectors[heading][1];
+
+    float length = std::sqrt(static_cast<float>(primitive.di * primitive.di + primitive.dj * primitive.dj));
+    float theta = latticeHeadingAngle(heading);
+    int num_samples = static_cast<int>(std::ceil(length * kSamplesPerCell));
+    std::vector<std::array<float, 3>> samples;
+    for (int k = 0; k <= num_samples; ++k)
+    {
+        float t = static_cast<float>(k) / num_samples;
+        samples.push_back({t * primitive.di, t * primitive.dj, theta});
+    }
+    finishPrimitive(samples, length, primitive);
+    return primitive;
+}
+
+/**
+ * Fills the heuristic table with Dijkstra's algorithm, backwards from the
+ * origin at every heading over the primitives in free space.
+ */
+static void buildHeuristicTable(StateLattice& lattice)
+{
+    int radius = lattice.heuristic_radius, window = 2 * radius;
+    int size = 2 * window + 1;
+    std::vector<std::vector<const MotionPrimitive*>> incoming(LATTICE_NUM_HEADINGS);
+    for (const auto& primitives : lattice.primitives)
+    {
+        for (const MotionPrimitive& primitive : primitives) incoming[primitive.end_heading].push_back(&primitive);
+    }
+
+    auto stateOf = [&](int di, int dj, int heading)
+    {
+        return ((dj + window) * size + (di + window)) * LATTICE_NUM_HEADINGS + heading;
+    };
+    std::vector<float> costs(size * size * LATTICE_NUM_HEADINGS, HIGH);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    for (int heading = 0; heading < LATTICE_NUM_HEADINGS; ++heading)
+    {
+        costs[stateOf(0, 0, heading)] = 0;
+        open_set.push({0, stateOf(0, 0, heading)});
+    }
+
+    while (!open_set.empty())
+    {
+        Entry entry = open_set.top();
+        open_set.pop();
+        if (entry.first > costs[entry.second]) continue;
+        int heading = entry.second % LATTICE_NUM_HEADINGS, cell = entry.second / LATTICE_NUM_HEADINGS;
+        int di = cell % size - window, dj = cell / size - window;
+        for (const MotionPrimitive* primitive : incoming[heading])
+        {
+            int pi = di - primitive->di, pj = dj - primitive->dj;
+            if (std::abs(pi) > window || std::abs(pj) > window) continue;
+            int previous = stateOf(pi, pj, primitive->start_heading);
+            float cost = entry.first + primitive->cost;
+            if (cost < costs[previous])
+            {
+                costs[previous] = cost;
+                open_set.push({cost, previous});
+            }
+        }
+    }
+
+    int table_size = 2 * radius + 1;
+    lattice.heuristic.assign(table_size * table_size * LATTICE_NUM_HEADINGS, 0);
+    for (int dj = -radius; dj <= radius; ++dj)
+    {
+        for (int di = -radius; di <= radius; ++di)
+        {
+            for (int heading = 0; heading < LATTICE_NUM_HEADINGS; ++heading)
+            {
+                int entry = ((dj + radius) * table_size + (di + radius)) * LATTICE_NUM_HEADINGS + heading;
+                lattice.heuristic[entry] = costs[stateOf(di, dj, heading)];
+            }
+        }
+    }
+}
+
+void buildStateLattice(StateLattice& lattice, int heuristic_radius)
+{
+    lattice = StateLattice();
+    lattice.primitives.resize(LATTICE_NUM_HEADINGS);
+    std::vector<std::array<float, 3>> samples, best_samples;
+    for (int heading = 0; heading < LATTICE_NUM_HEADINGS; ++heading)
+    {
+        auto& primitives = lattice.primitives[heading];
+        primitives.push_back(makeStraight(heading, 1));
+        primitives.push_back(makeStraight(heading, LATTICE_LONG_STRAIGHT));
+
+        for (int turn : {-1, 1})
+        {
+            int end_heading = (heading + turn + LATTICE_NUM_HEADINGS) % LATTICE_NUM_HEADINGS;
+            MotionPrimitive in_place;
+            in_place.start_heading = heading;
+            in_place.end_heading = end_heading;
+            in_place.di = in_place.dj = 0;
+            in_place.cost = LATTICE_TURN_IN_PLACE_COST;
+            in_place.poses.push_back({0, 0, latticeHeadingAngle(end_heading)});
+            primitives.push_back(in_place);
+
+            // The shortest smooth turn ending ahead of both headings.
+            const int* v0 = kHeadingVectors[heading];
+            const int* v1 = kHeadingVectors[end_heading];
+            float best_length = HIGH;
+            int best_di = 0, best_dj = 0;
+            for (int dj = -LATTICE_MAX_TURN_REACH; dj <= LATTICE_MAX_TURN_REACH; ++dj)
+            {
+                for (int di = -LATTICE_MAX_TURN_REACH; di <= LATTICE_MAX_TURN_REACH; ++di)
+                {
+                    if (di * v0[0] + dj * v0[1] <= 0 || di * v1[0] + dj * v1[1] <= 0) continue;
+                    float length = sampleTurn(heading, end_heading, di, dj, samples);
+                    if (length > 0 && length < best_length)
+                    {
+                        best_length = length;
+                        best_di = di;
+                        best_dj = dj;
+                        best_samples.swap(samples);
+                    }
+                }
+            }
+            if (best_length == HIGH) continue;
+
+            MotionPrimitive smooth;
+            smooth.start_heading = heading;
+            smooth.end_heading = end_heading;
+            smooth.di = best_di;
+            smooth.dj = best_dj;
+            finishPrimitive(best_samples, best_length, smooth);
+            primitives.push_back(smooth);
+        }
+    }
+
+    lattice.heuristic_radius = heuristic_radius;
+    if (heuristic_radius > 0) buildHeuristicTable(lattice);
+}
+
+float latticeHeuristic(const StateLattice& lattice, int di, int dj, int heading)
+{
+    float euclidean = std::sqrt(static_cast<float>(di * di + dj * dj));
+    int radius = lattice.heuristic_radius;
+    if (radius == 0 || std::abs(di) > radius || std::abs(dj) > radius) return euclidean;
+    int table_size = 2 * radius + 1;
+    return std::max(euclidean, lattice.heuristic[((dj + radius) * table_size + (di + radius)) * LATTICE_NUM_HEADINGS + heading]);
+}
+
+/**
+ * Finds the octile distance from every cell to the goal over the free cells
+ * with Dijkstra's algorithm. Unreachable cells are left at HIGH.
+ */
+static void gridDistances(const GridGraph& graph, const OccupancyBits& blocked, const Cell& goal,
+                          std::vector<float>& distances)
+{
+    distances.assign(graph.width * graph.height, HIGH);
+    using Entry = std::pair<float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+    int goal_idx = cellToIdx(goal.i, goal.j, graph);
+    distances[goal_idx] = 0;
+    open_set.push({0, goal_idx});
+    while (!open_set.empty())
+    {
+        Entry entry = open_set.top();
+        open_set.pop();
+        if (entry.first > distances[entry.second]) continue;
+        Cell c = idxToCell(entry.second, graph);
+        for (const auto& step : kNeighborSteps)
+        {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph) || testBit(blocked, ni, nj)) continue;
+            int neighbor = cellToIdx(ni, nj, graph);
+            float distance = entry.first + (step[0] != 0 && step[1] != 0 ? M_SQRT2 : 1);
+            if (distance < distances[neighbor])
+            {
+                distances[neighbor] = distance;
+                open_set.push({distance, neighbor});
+            }
+        }
+    }
+}
+
+std::vector<std::array<float, 3>> latticeSearch(GridGraph& graph, const StateLattice& lattice, const Cell& start,
+                                                float start_theta, const Cell& goal, LatticeSearchStats* stats,
+                                                std::vector<Cell>* cells)
+{
+    LatticeSearchStats local_stats;
+    LatticeSearchStats& counters = stats != nullptr ? *stats : local_stats;
+    counters = LatticeSearchStats();
+    if (cells != nullptr) cells->clear();
+
+    if (!isCellInBounds(start.i, start.j, graph) || !isCellInBounds(goal.i, goal.j, graph)) return {};
+    const OccupancyBits& blocked = getCSpaceBits(graph);
+    if (testBit(blocked, goal.i, goal.j)) return {};
+
+    // States are numbered cell * LATTICE_NUM_HEADINGS + heading. Only the
+    // states the search reaches are stored.
+    struct LatticeNode
+    {
+        float cost;
+        int parent;         // The previous state, or -1 at the start.
+        int primitive;      // The primitive from the previous state's heading.
+    };
+    std::unordered_map<int, LatticeNode> nodes;
+    using Entry = std::tuple<float, float, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_set;
+
+    std::vector<float> grid_distances;
+    if (lattice.grid_heuristic)
+    {
+        gridDistances(graph, blocked, goal, grid_distances);
+        if (grid_distances[cellToIdx(start.i, start.j, graph)] == HIGH && !testBit(blocked, start.i, start.j)) return {};
+    }
+    const float grid_scale = std::cos(M_PI / 8);
+    auto estimate = [&](int i, int j, int heading)
+    {
+        float h = latticeHeuristic(lattice, i - goal.i, j - goal.j, heading);
+        if (grid_distances.empty()) return h;
+        return std::max(h, grid_scale * grid_distances[cellToIdx(i, j, graph)]);
+    };
+
+    int start_heading = latticeHeadingIndex(start_theta);
+    int start_state = cellToIdx(start.i, start.j, graph) * LATTICE_NUM_HEADINGS + start_heading;
+    int goal_idx = cellToIdx(goal.i, goal.j, graph);
+    nodes[start_state] = {0, -1, -1};
+    open_set.push(Entry(estimate(start.i, start.j, start_heading), 0, start_state));
+
+    // The heuristic table is not consistent with the Euclidean distance it
+    // falls back to, nor with the grid distances, so states are expanded
+    // again when a cheaper path to them is found.
+    int goal_state = -1;
+    while (!open_set.empty())
+    {
+        float cost = std::get<1>(open_set.top());
+        int state = std::get<2>(open_set.top());
+        open_set.pop();
+        if (cost > nodes[state].cost) continue;
+
+        int heading = state % LATTICE_NUM_HEADINGS;
+        Cell c = idxToCell(state / LATTICE_NUM_HEADINGS, graph);
+        ++counters.expanded;
+        graph.visited_cells.push_back(c);
+        if (state / LATTICE_NUM_HEADINGS == goal_idx)
+        {
+            goal_state = state;
+            break;
+        }
+
+        const auto& primitives = lattice.primitives[heading];
+        for (size_t k = 0; k < primitives.size(); ++k)
+        {
+            const MotionPrimitive& primitive = primitives[k];
+            int ei = c.i + primitive.di, ej = c.j + primitive.dj;
+            if (!isCellInBounds(ei, ej, graph)) continue;
+            if (!grid_distances.empty() && grid_distances[cellToIdx(ei, ej, graph)] == HIGH) continue;
+            bool clear = true;
+            for (const Cell& offset : primitive.swept)
+            {
+                ++counters.swept_cells_checked;
+                int si = c.i + offset.i, sj = c.j + offset.j;
+                if (!isCellInBounds(si, sj, graph) || testBit(blocked, si, sj))
+                {
+                    clear = false;
+                    break;
+                }
+            }
+            if (!clear) continue;
+
+            float next_cost = cost + primitive.cost;
+            int next_state = cellToIdx(ei, ej, graph) * LATTICE_NUM_HEADINGS + primitive.end_heading;
+            auto it = nodes.find(next_state);
+            if (it == nodes.end() || next_cost < it->second.cost)
+            {
+                nodes[next_state] = {next_cost, state, static_cast<int>(k)};
+                open_set.push(Entry(next_cost + estimate(ei, ej, primitive.end_heading), next_cost, next_state));
+            }
+        }
+    }
+    if (goal_state < 0) return {};
+
+    std::vector<int> states;
+    for (int state = goal_state; state != -1; state = nodes[state].parent) states.push_back(state);
+    std::reverse(states.begin(), states.end());
+
+    auto origin = cellToPos(start.i, start.j, graph);
+    std::vector<std::array<float, 3>> poses = {{origin[0], origin[1], latticeHeadingAngle(start_heading)}};
+    if (cells != nullptr) cells->push_back(start);
+    for (size_t k = 1; k < states.size(); ++k)
+    {
+        int previous = states[k - 1];
+        const MotionPrimitive& primitive =
+            lattice.primitives[previous % LATTICE_NUM_HEADINGS][nodes[states[k]].primitive];
+        Cell from = idxToCell(previous / LATTICE_NUM_HEADINGS, graph);
+        auto position = cellToPos(from.i, from.j, graph);
+        for (const auto& pose : primitive.poses)
+        {
+            poses.push_back({position[0] + pose[0] * graph.meters_per_cell,
+                             position[1] + pose[1] * graph.meters_per_cell, pose[2]});
+        }
+        if (cells == nullptr) continue;
+        for (const Cell& offset : primitive.swept) cells->push_back({from.i + offset.i, from.j + offset.j});
+    }
+    return poses;
+}
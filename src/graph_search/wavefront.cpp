@@ -0,0 +1,106 @@
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/graph_search/wavefront.h>
+
+int expandWavefront(const OccupancyBits& blocked, const Cell& start, int max_hops,
+                    OccupancyBits& reached, std::vector<int>* hops)
+{
+    const int width = blocked.width, height = blocked.height, words_per_row = blocked.words_per_row;
+    const size_t num_words = blocked.words.size();
+    reached.width = width;
+    reached.height = height;
+    reached.words_per_row = words_per_row;
+    reached.words.assign(num_words, 0);
+    if (hops != nullptr) hops->assign(static_cast<size_t>(width) * height, -1);
+    if (start.i < 0 || start.j < 0 || start.i >= width || start.j >= height) return 0;
+
+    // The frontier is a list of its nonzero words. Each step, every frontier
+    // word is spread one cell sideways and ORed into the words above, below
+    // and at the same place in a dense scratch grid, which also lists the
+    // words it touched so only those are read back and cleared.
+    std::vector<std::pair<size_t, uint64_t>> frontier, next;
+    std::vector<uint64_t> grown(num_words, 0);
+    std::vector<size_t> touched;
+    auto grow = [&](size_t word, uint64_t bits)
+    {
+        if (grown[word] == 0) touched.push_back(word);
+        grown[word] |= bits;
+    };
+
+    size_t start_word = start.j * static_cast<size_t>(words_per_row) + (start.i >> 6);
+    uint64_t start_bit = uint64_t(1) << (start.i & 63);
+    reached.words[start_word] = start_bit;
+    frontier.push_back({start_word, start_bit});
+    if (hops != nullptr) (*hops)[start.i + start.j * static_cast<size_t>(width)] = 0;
+
+    const uint64_t* blocked_words = blocked.words.data();
+    uint64_t* reached_words = reached.words.data();
+    const size_t last_row = static_cast<size_t>(height - 1) * words_per_row;
+    const uint64_t high_bit = uint64_t(1) << 63;
+
+    int step = 0;
+    while (!frontier.empty() && (max_hops < 0 || step < max_hops))
+    {
+        ++step;
+        touched.clear();
+        for (const auto& entry : frontier)
+        {
+            size_t word = entry.first;
+            uint64_t bits = entry.second;
+            int w = word % words_per_row;
+            uint64_t spread = bits | (bits << 1) | (bits >> 1);
+            uint64_t carry_left = (bits & 1) && w > 0 ? high_bit : 0;
+            uint64_t carry_right = (bits & high_bit) && w + 1 < words_per_row ? 1 : 0;
+
+            size_t first = word < static_cast<size_t>(words_per_row) ? word : word - words_per_row;
+            size_t last = word >= last_row ? word : word + words_per_row;
+            for (size_t row = first; row <= last; row += words_per_row)
+            {
+                grow(row, spread);
+                if (carry_left) grow(row - 1, carry_left);
+                if (carry_right) grow(row + 1, carry_right);
+            }
+        }
+
+        // Keep only the new cells that are clear.
+        next.clear();
+        for (size_t word : touched)
+        {
+            uint64_t bits = grown[word] & ~blocked_words[word] & ~reached_words[word];
+            grown[word] = 0;
+            if (bits == 0) continue;
+            reached_words[word] |= bits;
+            next.push_back({word, bits});
+
+            if (hops != nullptr)
+            {
+                size_t cell = (word / words_per_row) * static_cast<size_t>(width) + (word % words_per_row) * 64;
+                while (bits != 0)
+                {
+                    (*hops)[cell + __builtin_ctzll(bits)] = step;
+                    bits &= bits - 1;
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return frontier.empty() ? step - 1 : step;
+}
+
+std::vector<int> wavefrontHopDistances(GridGraph& graph, const Cell& start, int max_hops)
+{
+    OccupancyBits reached;
+    std::vector<int> hops;
+    expandWavefront(getCSpaceBits(graph), start, max_hops, reached, &hops);
+    return hops;
+}
+
+OccupancyBits wavefrontReachable(GridGraph& graph, const Cell& start, int max_hops)
+{
+    OccupancyBits reached;
+    expandWavefront(getCSpaceBits(graph), start, max_hops, reached);
+    return reached;
+}
@@ -0,0 +1,71 @@
+#include <iostream>
+#include <string>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/graph_search/distance_transform.h>
+
+/**
+ * @brief Print Usage prints the command line usage for the program
+ */
+void print_usage()
+{
+    std::cout << "Usage:\n";
+    std::cout << "./map_convert [in_file] [out_file] [--dt] [--cspace] [--verify]\n\n";
+    std::cout << "Converts a text .map file to a binary map, or a binary map back to text.\n";
+    std::cout << "\t--dt      Compute and store the distance transform in the binary map.\n";
+    std::cout << "\t--cspace  Compute and store the C-space layer in the binary map.\n";
+    std::cout << "\t--verify  Verify all checksums when reading a binary map.\n";
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        print_usage();
+        return 1;
+    }
+
+    std::string in_file = argv[1];
+    std::string out_file = argv[2];
+    bool include_dt = false, include_cspace = false, verify = false;
+    for (int k = 3; k < argc; ++k)
+    {
+        std::string flag = argv[k];
+        if (flag == "--dt") include_dt = true;
+        else if (flag == "--cspace") include_cspace = true;
+        else if (flag == "--verify") verify = true;
+        else
+        {
+            std::cerr << "Invalid option: " << flag << std::endl;
+            print_usage();
+            return 1;
+        }
+    }
+
+    GridGraph graph;
+    if (isBinaryMapFile(in_file))
+    {
+        if (!loadFromBinaryFile(in_file, graph, verify))
+        {
+            std::cerr << "Invalid map file: " << in_file << std::endl;
+            return 1;
+        }
+        if (!saveToFile(out_file, graph)) return 1;
+        std::cout << "Wrote text map to " << out_file << std::endl;
+        return 0;
+    }
+
+    if (!loadFromFile(in_file, graph))
+    {
+        std::cerr << "Invalid map file: " << in_file << std::endl;
+        return 1;
+    }
+    if (include_dt) distanceTransformEuclidean2D(graph);
+    if (include_cspace) computeCSpace(graph);
+
+    if (!saveToBinaryFile(out_file, graph, include_dt, include_cspace)) return 1;
+    std::cout << "Wrote binary map to " << out_file << std::endl;
+
+    return 0;
+}
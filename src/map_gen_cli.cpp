@@ -0,0 +1,58 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+
+/**
+ * @brief Print Usage prints the command line usage for the program
+ */
+void print_usage()
+{
+    std::cout << "Usage:\n";
+    std::cout << "./map_gen [type] [width] [height] [param] [seed] [out_file]\n\n";
+    std::cout << "Types and their param:\n";
+    std::cout << "\trandom  Random rectangular obstacles. param: density in [0, 1].\n";
+    std::cout << "\tmaze    Recursive division maze. param: corridor width in cells.\n";
+    std::cout << "\trooms   Rooms joined by corridors. param: number of rooms.\n";
+    std::cout << "\tnarrow  Wall with a single narrow gap. param: gap width in cells.\n";
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 7)
+    {
+        print_usage();
+        return 1;
+    }
+
+    std::string type = argv[1];
+    int width = std::atoi(argv[2]);
+    int height = std::atoi(argv[3]);
+    float param = std::atof(argv[4]);
+    unsigned int seed = std::strtoul(argv[5], nullptr, 10);
+    std::string out_file = argv[6];
+
+    if (width <= 0 || height <= 0)
+    {
+        std::cerr << "Invalid map size: " << width << " x " << height << std::endl;
+        return 1;
+    }
+
+    GridGraph graph;
+    if (!generateMap(type, width, height, param, seed, graph))
+    {
+        std::cerr << "Invalid map type: " << type << std::endl;
+        print_usage();
+        return 1;
+    }
+
+    if (!saveToFile(out_file, graph))
+    {
+        return 1;
+    }
+    std::cout << "Wrote " << width << " x " << height << " " << type << " map to " << out_file << std::endl;
+
+    return 0;
+}
@@ -1,4 +1,7 @@
 #include <cmath>
+#include <cstdio>
+#include <atomic>
+#include <memory>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -6,6 +9,7 @@
 
 #include <path_planning/utils/math_helpers.h>
 #include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
 
 #define HIGH 1e6
 
@@ -17,15 +21,123 @@ bool isLoaded(const GridGraph& graph) {
     return correct_size && positive_size && positive_m_per_cell;
 }
 
+/**
+ * Reads whitespace separated tokens and integers from a file through a large
+ * fixed size buffer. Integers are parsed by hand, which avoids the per token
+ * locale and stream state overhead of operator>> on multi-million cell maps.
+ */
+class MapFileScanner {
+public:
+    explicit MapFileScanner(FILE* file) : file_(file), buffer_(1 << 20), pos_(0), end_(0) {}
+
+    /**
+     * Reads the next whitespace separated token.
+     * @return  False if the end of the file was reached first.
+     */
+    bool nextToken(std::string& token) {
+        token.clear();
+        if (!skipSpace()) return false;
+        while ((pos_ < end_ || refill()) && !isSpace(buffer_[pos_])) {
+            token.push_back(buffer_[pos_++]);
+        }
+        return true;
+    }
+
+    /**
+     * Reads the next integer.
+     * @return  False if the end of the file was reached or the token is not an integer.
+     */
+    bool nextInt(int& value) {
+        if (!skipSpace()) return false;
+        bool negative = false;
+        if (buffer_[pos_] == '-' || buffer_[pos_] == '+') {
+            negative = buffer_[pos_] == '-';
+            ++pos_;
+        }
+        int result = 0, num_digits = 0;
+        while (pos_ < end_ || refill()) {
+            unsigned int digit = static_cast<unsigned char>(buffer_[pos_]) - '0';
+            if (digit > 9) break;
+            result = 10 * result + digit;
+            ++num_digits;
+            ++pos_;
+        }
+        value = negative ? -result : result;
+        return num_digits > 0;
+    }
+
+private:
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    bool refill() {
+        pos_ = 0;
+        end_ = std::fread(buffer_.data(), 1, buffer_.size(), file_);
+        return end_ > 0;
+    }
+
+    bool skipSpace() {
+        while (true) {
+            if (pos_ == end_ && !refill()) return false;
+            if (!isSpace(buffer_[pos_])) return true;
+            ++pos_;
+        }
+    }
+
+    FILE* file_;
+    std::vector<char> buffer_;
+    size_t pos_, end_;
+};
+
+/**
+ * Formats a cell odds value followed by the given separator. Returns a pointer
+ * past the last character written. At most 5 characters are written.
+ */
+static char* formatOdds(int8_t odds, char separator, char* out) {
+    int value = odds;
+    if (value < 0) {
+        *out++ = '-';
+        value = -value;
+    }
+    if (value >= 100) *out++ = '0' + value / 100;
+    if (value >= 10) *out++ = '0' + (value / 10) % 10;
+    *out++ = '0' + value % 10;
+    *out++ = separator;
+    return out;
+}
+
+std::string formatHeader(const GridGraph& graph, char separator) {
+    std::ostringstream oss;
+    oss << graph.origin_x << " " << graph.origin_y << " ";
+    oss << graph.width << " " << graph.height << " " << graph.meters_per_cell << separator;
+    return oss.str();
+}
+
 bool loadFromFile(const std::string& file_path, GridGraph& graph) {
-    std::ifstream in(file_path);
-    if (!in.is_open()) {
+    if (isBinaryMapFile(file_path)) {
+        return loadFromBinaryFile(file_path, graph);
+    }
+
+    FILE* file = std::fopen(file_path.c_str(), "rb");
+    if (file == nullptr) {
         std::cerr << "ERROR: loadFromFile: Failed to load from " << file_path << std::endl;
         return false;
     }
+    std::unique_ptr<FILE, int (*)(FILE*)> closer(file, std::fclose);
+    MapFileScanner scanner(file);
 
     // Read header
-    in >> graph.origin_x >> graph.origin_y >> graph.width >> graph.height >> graph.meters_per_cell;
+    std::string origin_x, origin_y, meters_per_cell;
+    if (!scanner.nextToken(origin_x) || !scanner.nextToken(origin_y) ||
+        !scanner.nextInt(graph.width) || !scanner.nextInt(graph.height) ||
+        !scanner.nextToken(meters_per_cell)) {
+        std::cerr << "ERROR: loadFromFile: Invalid header in " << file_path << std::endl;
+        return false;
+    }
+    graph.origin_x = std::strtof(origin_x.c_str(), nullptr);
+    graph.origin_y = std::strtof(origin_y.c_str(), nullptr);
+    graph.meters_per_cell = std::strtof(meters_per_cell.c_str(), nullptr);
 
     if (graph.width < 0 || graph.height < 0 || graph.meters_per_cell <= 0.0f) {
         return false;
@@ -36,17 +148,46 @@ bool loadFromFile(const std::string& file_path, GridGraph& graph) {
     int num_cells = graph.width * graph.height;
     graph.cell_odds.resize(num_cells);
     graph.obstacle_distances = std::vector<float>(num_cells, 0);
+    graph.cspace.clear();
+    graph.cspace_bits = OccupancyBits();
 
     int odds;
     for (int idx = 0; idx < num_cells; ++idx) {
-        in >> odds;
+        if (!scanner.nextInt(odds)) {
+            std::cerr << "ERROR: loadFromFile: Expected " << num_cells << " cells but read " << idx
+                      << " from " << file_path << std::endl;
+            return false;
+        }
         graph.cell_odds[idx] = odds;
     }
 
+    updateOccupancyBits(graph);
+    markMapChanged(graph);
     initGraph(graph);
     return true;
 }
 
+bool saveToFile(const std::string& file_path, const GridGraph& graph) {
+    std::ofstream out(file_path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "ERROR: saveToFile: Failed to save to " << file_path << std::endl;
+        return false;
+    }
+
+    out << formatHeader(graph, '\n');
+
+    // Rows are formatted into a buffer and written in one go.
+    std::vector<char> row(5 * std::max(graph.width, 1));
+    for (int j = 0; j < graph.height; j++) {
+        char* end = row.data();
+        for (int i = 0; i < graph.width; i++) {
+            end = formatOdds(graph.cell_odds[cellToIdx(i, j, graph)], i < graph.width - 1 ? ' ' : '\n', end);
+        }
+        out.write(row.data(), end - row.data());
+    }
+    return out.good();
+}
+
 /*void initGraph(GridGraph& graph) {
 
     for (auto& node : graph.nodes) {
@@ -57,7 +198,8 @@ bool loadFromFile(const std::string& file_path, GridGraph& graph) {
 }*/
 
 void initGraph(GridGraph& graph) {
-    if (graph.nodes.empty()) {
+    if (graph.nodes.size() != static_cast<size_t>(graph.width) * graph.height) {
+        graph.nodes.clear();
         graph.nodes.resize(graph.width * graph.height);
         for (int idx = 0; idx < graph.width * graph.height; ++idx) {
             graph.nodes[idx].visited = false;
@@ -69,21 +211,25 @@ void initGraph(GridGraph& graph) {
             node.visited = false;
             node.parent = -1;
             node.cost = HIGH;
+            node.collision = -1;
         }
     }
+    if (graph.collision_mode == COLLISION_PRECOMPUTED) getCSpaceBits(graph);
 }
 
 std::string mapAsString(GridGraph& graph) {
-    std::ostringstream oss;
-    oss << graph.origin_x << " " << graph.origin_y << " ";
-    oss << graph.width << " " << graph.height << " " << graph.meters_per_cell << " ";
+    std::string header = formatHeader(graph, ' ');
+    int num_cells = graph.width * graph.height;
 
-    for (int j = 0; j < graph.height; j++) {
-        for (int i = 0; i < graph.width; i++) {
-            oss << +graph.cell_odds[cellToIdx(i, j, graph)] << " ";
-        }
+    // Each cell takes at most 5 characters, "-128 ".
+    std::string result(header.size() + 5 * static_cast<size_t>(num_cells), ' ');
+    char* begin = &result[0];
+    char* end = std::copy(header.begin(), header.end(), begin);
+    for (int idx = 0; idx < num_cells; ++idx) {
+        end = formatOdds(graph.cell_odds[idx], ' ', end);
     }
-    return oss.str();
+    result.resize(end - begin);
+    return result;
 }
 
 int cellToIdx(int i, int j, const GridGraph& graph) {
@@ -115,6 +261,8 @@ bool isCellInBounds(int i, int j, const GridGraph& graph) {
 }
 
 bool isIdxOccupied(int idx, const GridGraph& graph) {
+    // Read the odds rather than graph.occupancy_bits, which go stale when the
+    // odds or threshold are changed directly.
     return graph.cell_odds[idx] >= graph.threshold;
 }
 
@@ -122,6 +270,8 @@ bool isCellOccupied(int i, int j, const GridGraph& graph) {
     return isIdxOccupied(cellToIdx(i, j, graph), graph);
 }
 
+const int kNeighborSteps[8][2] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+
 std::vector<int> findNeighbors(int idx, const GridGraph& graph) {
     int i = idx % graph.width;
     int j = idx / graph.width;
@@ -168,6 +318,110 @@ bool checkCollision(int idx, const GridGraph& graph) {
     return false;
 }
 
+void computeCSpace(GridGraph& graph) {
+    int num_cells = graph.width * graph.height;
+    graph.cspace.assign(num_cells, 0);
+    for (int idx = 0; idx < num_cells; ++idx) {
+        graph.cspace[idx] = checkCollision(idx, graph);
+    }
+    updateCSpaceBits(graph);
+}
+
+/**
+ * Packs a per-cell array into a bit grid, setting the bits of the cells for
+ * which the predicate is true. Each word is assembled in a register and
+ * stored once.
+ */
+template <class T, class Predicate>
+static void packBits(const T* values, int width, int height, Predicate isSet, OccupancyBits& bits) {
+    initOccupancyBits(width, height, bits);
+    for (int j = 0; j < height; ++j) {
+        const T* row = values + j * static_cast<size_t>(width);
+        uint64_t* out = bits.words.data() + j * static_cast<size_t>(bits.words_per_row);
+        for (int w = 0; w < bits.words_per_row; ++w) {
+            uint64_t word = out[w];
+            int end = std::min(64, width - 64 * w);
+            for (int k = 0; k < end; ++k) {
+                word |= static_cast<uint64_t>(isSet(row[64 * w + k])) << k;
+            }
+            out[w] = word;
+        }
+    }
+}
+
+void updateOccupancyBits(GridGraph& graph) {
+    int8_t threshold = graph.threshold;
+    packBits(graph.cell_odds.data(), graph.width, graph.height,
+             [threshold](int8_t odds) { return odds >= threshold; }, graph.occupancy_bits);
+}
+
+void updateCSpaceBits(GridGraph& graph) {
+    if (graph.cspace.size() != static_cast<size_t>(graph.width) * graph.height) {
+        computeCSpace(graph);
+        return;
+    }
+    packBits(graph.cspace.data(), graph.width, graph.height,
+             [](uint8_t value) { return value != 0; }, graph.cspace_bits);
+}
+
+void markMapChanged(GridGraph& graph) {
+    static std::atomic<uint64_t> last_version(0);
+    graph.map_version = ++last_version;
+}
+
+void setCellOdds(int idx, int8_t odds, GridGraph& graph) {
+    graph.cell_odds[idx] = odds;
+    Cell c = idxToCell(idx, graph);
+    if (graph.occupancy_bits.width == graph.width && graph.occupancy_bits.height == graph.height) {
+        setBit(graph.occupancy_bits, c.i, c.j, odds >= graph.threshold);
+    }
+
+    // Only cells within the collision radius can see this cell.
+    if (graph.cspace.size() == static_cast<size_t>(graph.width) * graph.height) {
+        bool has_bits = graph.cspace_bits.width == graph.width && graph.cspace_bits.height == graph.height;
+        int reach = static_cast<int>(std::ceil(graph.collision_radius / graph.meters_per_cell)) + 1;
+        for (int j = std::max(c.j - reach, 0); j <= std::min(c.j + reach, graph.height - 1); ++j) {
+            for (int i = std::max(c.i - reach, 0); i <= std::min(c.i + reach, graph.width - 1); ++i) {
+                int n = cellToIdx(i, j, graph);
+                graph.cspace[n] = checkCollision(n, graph);
+                if (has_bits) setBit(graph.cspace_bits, i, j, graph.cspace[n]);
+            }
+        }
+    }
+    markMapChanged(graph);
+}
+
+const OccupancyBits& getCSpaceBits(GridGraph& graph) {
+    if (graph.cspace_bits.width != graph.width || graph.cspace_bits.height != graph.height) {
+        updateCSpaceBits(graph);
+    }
+    return graph.cspace_bits;
+}
+
+bool checkCollisionBits(int idx, const GridGraph& graph) {
+    if (graph.cspace_bits.width != graph.width || graph.cspace_bits.height != graph.height) {
+        return checkCollision(idx, graph);
+    }
+    return testBit(graph.cspace_bits, idx % graph.width, idx / graph.width);
+}
+
+bool checkNeighborCollision(int idx, GridGraph& graph) {
+    if (graph.collision_mode == COLLISION_LAZY) return graph.nodes[idx].collision == 1;
+    if (graph.collision_mode == COLLISION_PRECOMPUTED) return checkCollisionBits(idx, graph);
+    ++graph.collision_checks;
+    return checkCollision(idx, graph);
+}
+
+bool checkExpandedCollision(int idx, GridGraph& graph) {
+    if (graph.collision_mode != COLLISION_LAZY) return false;
+    int8_t& collision = graph.nodes[idx].collision;
+    if (collision < 0) {
+        ++graph.collision_checks;
+        collision = checkCollision(idx, graph);
+    }
+    return collision == 1;
+}
+
 int getParent(int idx, const GridGraph& graph) {
     return graph.nodes[idx].parent;
 }
@@ -0,0 +1,432 @@
+#include <cstdio>
+#include <vector>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+
+/**
+ * Rounds an offset up to the next section boundary.
+ */
+static uint64_t alignSection(uint64_t offset) {
+    return (offset + 63) & ~static_cast<uint64_t>(63);
+}
+
+/**
+ * Reverses the byte order of a value in place.
+ */
+template <class T>
+static void swapBytes(T& value) {
+    char* bytes = reinterpret_cast<char*>(&value);
+    std::reverse(bytes, bytes + sizeof(T));
+}
+
+/**
+ * Converts every field of a header written with the other byte order.
+ */
+static void swapHeader(BinaryMapHeader& header) {
+    swapBytes(header.version);
+    swapBytes(header.endian_tag);
+    swapBytes(header.width);
+    swapBytes(header.height);
+    swapBytes(header.origin_x);
+    swapBytes(header.origin_y);
+    swapBytes(header.meters_per_cell);
+    swapBytes(header.collision_radius);
+    swapBytes(header.threshold);
+    swapBytes(header.flags);
+    swapBytes(header.odds_offset);
+    swapBytes(header.dt_offset);
+    swapBytes(header.cspace_offset);
+    swapBytes(header.odds_checksum);
+    swapBytes(header.dt_checksum);
+    swapBytes(header.cspace_checksum);
+    swapBytes(header.header_checksum);
+    swapBytes(header.bits_offset);
+    swapBytes(header.bits_checksum);
+    swapBytes(header.database_offset);
+}
+
+uint64_t fnv1aChecksum(const void* data, size_t size, uint64_t seed) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t k = 0; k < size; ++k) {
+        hash ^= bytes[k];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * Computes the header checksum, which covers the raw header bytes with the
+ * checksum field set to zero.
+ */
+static uint64_t headerChecksum(BinaryMapHeader raw) {
+    raw.header_checksum = 0;
+    return fnv1aChecksum(&raw, sizeof(raw));
+}
+
+bool isBinaryMapFile(const std::string& file_path) {
+    char magic[8];
+    std::ifstream in(file_path, std::ios::binary);
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, BINARY_MAP_MAGIC, sizeof(magic)) == 0;
+}
+
+bool saveToBinaryFile(const std::string& file_path, const GridGraph& graph,
+                      bool include_dt, bool include_cspace) {
+    uint64_t num_cells = static_cast<uint64_t>(graph.width) * graph.height;
+    if (!isLoaded(graph)) {
+        std::cerr << "ERROR: saveToBinaryFile: Graph is not loaded." << std::endl;
+        return false;
+    }
+    if (include_dt && graph.obstacle_distances.size() != num_cells) {
+        std::cerr << "ERROR: saveToBinaryFile: Distance transform has the wrong size." << std::endl;
+        return false;
+    }
+    include_cspace = include_cspace && graph.cspace.size() == num_cells;
+    const OccupancyBits& bits = graph.occupancy_bits;
+    bool include_bits = bits.width == graph.width && bits.height == graph.height;
+    uint64_t bits_size = bits.words.size() * sizeof(uint64_t);
+
+    BinaryMapHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, BINARY_MAP_MAGIC, sizeof(header.magic));
+    header.version = BINARY_MAP_VERSION;
+    header.endian_tag = BINARY_MAP_ENDIAN_TAG;
+    header.width = graph.width;
+    header.height = graph.height;
+    header.origin_x = graph.origin_x;
+    header.origin_y = graph.origin_y;
+    header.meters_per_cell = graph.meters_per_cell;
+    header.collision_radius = graph.collision_radius;
+    header.threshold = graph.threshold;
+
+    uint64_t end = sizeof(header);
+    header.odds_offset = alignSection(end);
+    header.odds_checksum = fnv1aChecksum(graph.cell_odds.data(), num_cells);
+    end = header.odds_offset + num_cells;
+    if (include_dt) {
+        header.flags |= BINARY_MAP_HAS_DT;
+        header.dt_offset = alignSection(end);
+        header.dt_checksum = fnv1aChecksum(graph.obstacle_distances.data(), num_cells * sizeof(float));
+        end = header.dt_offset + num_cells * sizeof(float);
+    }
+    if (include_cspace) {
+        header.flags |= BINARY_MAP_HAS_CSPACE;
+        header.cspace_offset = alignSection(end);
+        header.cspace_checksum = fnv1aChecksum(graph.cspace.data(), num_cells);
+        end = header.cspace_offset + num_cells;
+    }
+    if (include_bits) {
+        header.flags |= BINARY_MAP_HAS_OCCUPANCY_BITS;
+        header.bits_offset = alignSection(end);
+        header.bits_checksum = fnv1aChecksum(bits.words.data(), bits_size);
+        end = header.bits_offset + bits_size;
+    }
+    header.header_checksum = headerChecksum(header);
+
+    std::ofstream out(file_path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "ERROR: saveToBinaryFile: Failed to save to " << file_path << std::endl;
+        return false;
+    }
+
+    // Writes a section, padding the file up to its offset first.
+    auto writeSection = [&out](uint64_t offset, const void* data, uint64_t size) {
+        static const char zeros[64] = {0};
+        out.write(zeros, offset - static_cast<uint64_t>(out.tellp()));
+        out.write(static_cast<const char*>(data), size);
+    };
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeSection(header.odds_offset, graph.cell_odds.data(), num_cells);
+    if (include_dt) {
+        writeSection(header.dt_offset, graph.obstacle_distances.data(), num_cells * sizeof(float));
+    }
+    if (include_cspace) {
+        writeSection(header.cspace_offset, graph.cspace.data(), num_cells);
+    }
+    if (include_bits) {
+        writeSection(header.bits_offset, bits.words.data(), bits_size);
+    }
+    return out.good();
+}
+
+bool loadFromBinaryFile(const std::string& file_path, GridGraph& graph, bool verify_checksums) {
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERROR: loadFromBinaryFile: Failed to load from " << file_path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryMapHeader))) {
+        std::cerr << "ERROR: loadFromBinaryFile: File too small: " << file_path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    uint64_t file_size = info.st_size;
+    void* ptr = mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        std::cerr << "ERROR: loadFromBinaryFile: Failed to map " << file_path << std::endl;
+        return false;
+    }
+    std::shared_ptr<const void> mapping(ptr, [file_size](const void* p) {
+        munmap(const_cast<void*>(p), file_size);
+    });
+    char* base = static_cast<char*>(ptr);
+
+    BinaryMapHeader raw;
+    std::memcpy(&raw, base, sizeof(raw));
+    BinaryMapHeader header = raw;
+    if (std::memcmp(header.magic, BINARY_MAP_MAGIC, sizeof(header.magic)) != 0) {
+        std::cerr << "ERROR: loadFromBinaryFile: Not a binary map: " << file_path << std::endl;
+        return false;
+    }
+
+    bool swapped = header.endian_tag != BINARY_MAP_ENDIAN_TAG;
+    if (swapped) swapHeader(header);
+    if (header.endian_tag != BINARY_MAP_ENDIAN_TAG || header.version != BINARY_MAP_VERSION) {
+        std::cerr << "ERROR: loadFromBinaryFile: Unsupported binary map version in " << file_path << std::endl;
+        return false;
+    }
+    if (headerChecksum(raw) != header.header_checksum) {
+        std::cerr << "ERROR: loadFromBinaryFile: Header checksum mismatch in " << file_path << std::endl;
+        return false;
+    }
+
+    // Checks that a section lies inside the file and, if asked, its checksum.
+    uint64_t num_cells = static_cast<uint64_t>(header.width) * header.height;
+    auto checkSection = [&](uint64_t offset, uint64_t size, uint64_t checksum, const char* name) {
+        if (offset % 64 != 0 || offset > file_size || size > file_size - offset) {
+            std::cerr << "ERROR: loadFromBinaryFile: Truncated " << name << " section in " << file_path << std::endl;
+            return false;
+        }
+        if (verify_checksums && fnv1aChecksum(base + offset, size) != checksum) {
+            std::cerr << "ERROR: loadFromBinaryFile: Checksum mismatch in " << name << " section of "
+                      << file_path << std::endl;
+            return false;
+        }
+        return true;
+    };
+    bool has_dt = header.flags & BINARY_MAP_HAS_DT;
+    bool has_cspace = header.flags & BINARY_MAP_HAS_CSPACE;
+    bool has_bits = header.flags & BINARY_MAP_HAS_OCCUPANCY_BITS;
+    uint64_t num_words = static_cast<uint64_t>((header.width + 63) / 64) * header.height;
+    if (header.meters_per_cell <= 0.0f ||
+        !checkSection(header.odds_offset, num_cells, header.odds_checksum, "cell odds") ||
+        (has_dt && !checkSection(header.dt_offset, num_cells * sizeof(float), header.dt_checksum, "distance")) ||
+        (has_cspace && !checkSection(header.cspace_offset, num_cells, header.cspace_checksum, "C-space")) ||
+        (has_bits && !checkSection(header.bits_offset, num_words * sizeof(uint64_t), header.bits_checksum,
+                                   "occupancy bits"))) {
+        return false;
+    }
+
+    graph.width = header.width;
+    graph.height = header.height;
+    graph.origin_x = header.origin_x;
+    graph.origin_y = header.origin_y;
+    graph.meters_per_cell = header.meters_per_cell;
+    graph.collision_radius = header.collision_radius;
+    graph.threshold = header.threshold;
+
+    graph.cell_odds.setExternal(reinterpret_cast<int8_t*>(base + header.odds_offset), num_cells, mapping);
+
+    if (!has_dt) {
+        graph.obstacle_distances.assign(num_cells, 0);
+    } else if (!swapped) {
+        graph.obstacle_distances.setExternal(reinterpret_cast<float*>(base + header.dt_offset), num_cells, mapping);
+    } else {
+        graph.obstacle_distances.resize(num_cells);
+        std::memcpy(graph.obstacle_distances.data(), base + header.dt_offset, num_cells * sizeof(float));
+        for (float& distance : graph.obstacle_distances) swapBytes(distance);
+    }
+
+    if (has_cspace) {
+        graph.cspace.setExternal(reinterpret_cast<uint8_t*>(base + header.cspace_offset), num_cells, mapping);
+    } else {
+        graph.cspace.clear();
+    }
+    graph.cspace_bits = OccupancyBits();
+
+    OccupancyBits& bits = graph.occupancy_bits;
+    if (!has_bits) {
+        updateOccupancyBits(graph);
+    } else {
+        bits.width = header.width;
+        bits.height = header.height;
+        bits.words_per_row = (bits.width + 63) / 64;
+        if (!swapped) {
+            bits.words.setExternal(reinterpret_cast<uint64_t*>(base + header.bits_offset), num_words, mapping);
+        } else {
+            bits.words.resize(num_words);
+            std::memcpy(bits.words.data(), base + header.bits_offset, num_words * sizeof(uint64_t));
+            for (uint64_t& word : bits.words) swapBytes(word);
+        }
+    }
+
+    markMapChanged(graph);
+    graph.nodes.clear();
+    graph.visited_cells.clear();
+    return true;
+}
+
+/**
+ * Reads and validates the header of a binary map opened for writing. Files
+ * written with another byte order are rejected.
+ */
+static bool readHeaderForUpdate(int fd, const std::string& file_path, BinaryMapHeader& header) {
+    if (pread(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, BINARY_MAP_MAGIC, sizeof(header.magic)) != 0 ||
+        header.endian_tag != BINARY_MAP_ENDIAN_TAG || header.version != BINARY_MAP_VERSION) {
+        std::cerr << "ERROR: Not a binary map with native byte order: " << file_path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Computes the checksum of a section of an open file with a fixed size buffer.
+ */
+static bool fileChecksum(int fd, uint64_t offset, uint64_t size, uint64_t& checksum) {
+    std::vector<char> buffer(1 << 20);
+    checksum = fnv1aChecksum(nullptr, 0);
+    while (size > 0) {
+        size_t chunk = std::min<uint64_t>(size, buffer.size());
+        if (pread(fd, buffer.data(), chunk, offset) != static_cast<ssize_t>(chunk)) return false;
+        checksum = fnv1aChecksum(buffer.data(), chunk, checksum);
+        offset += chunk;
+        size -= chunk;
+    }
+    return true;
+}
+
+bool addBinaryMapDistanceLayer(const std::string& file_path) {
+    int fd = open(file_path.c_str(), O_RDWR);
+    if (fd < 0) {
+        std::cerr << "ERROR: addBinaryMapDistanceLayer: Failed to open " << file_path << std::endl;
+        return false;
+    }
+    BinaryMapHeader header;
+    bool ok = readHeaderForUpdate(fd, file_path, header);
+    if (ok && !(header.flags & BINARY_MAP_HAS_DT)) {
+        struct stat info;
+        uint64_t num_cells = static_cast<uint64_t>(header.width) * header.height;
+        ok = fstat(fd, &info) == 0;
+        header.dt_offset = alignSection(info.st_size);
+        header.flags |= BINARY_MAP_HAS_DT;
+        ok = ok && ftruncate(fd, header.dt_offset + num_cells * sizeof(float)) == 0 &&
+             fileChecksum(fd, header.dt_offset, num_cells * sizeof(float), header.dt_checksum);
+        header.header_checksum = headerChecksum(header);
+        ok = ok && pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    }
+    close(fd);
+    return ok;
+}
+
+bool saveBinaryMapDatabase(const std::string& file_path, const void* data, uint64_t size) {
+    int fd = open(file_path.c_str(), O_RDWR);
+    if (fd < 0) {
+        std::cerr << "ERROR: saveBinaryMapDatabase: Failed to open " << file_path << std::endl;
+        return false;
+    }
+    BinaryMapHeader header;
+    struct stat info;
+    bool ok = readHeaderForUpdate(fd, file_path, header) && fstat(fd, &info) == 0;
+    if (ok) {
+        uint64_t section[2] = {size, fnv1aChecksum(data, size)};
+        header.database_offset = alignSection(info.st_size);
+        header.flags |= BINARY_MAP_HAS_PATH_DATABASE;
+        header.header_checksum = headerChecksum(header);
+        ok = pwrite(fd, section, sizeof(section), header.database_offset) == static_cast<ssize_t>(sizeof(section));
+
+        // Write in chunks, since a single write may be cut short.
+        const char* bytes = static_cast<const char*>(data);
+        uint64_t written = 0;
+        while (ok && written < size) {
+            ssize_t n = pwrite(fd, bytes + written, std::min<uint64_t>(size - written, 1 << 30),
+                               header.database_offset + sizeof(section) + written);
+            ok = n > 0;
+            written += std::max<ssize_t>(n, 0);
+        }
+        ok = ok && pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    }
+    close(fd);
+    return ok;
+}
+
+bool loadBinaryMapDatabase(const std::string& file_path, const char*& data, uint64_t& size,
+                           std::shared_ptr<const void>& mapping, bool verify_checksum) {
+    int fd = open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERROR: loadBinaryMapDatabase: Failed to open " << file_path << std::endl;
+        return false;
+    }
+    BinaryMapHeader header;
+    struct stat info;
+    if (!readHeaderForUpdate(fd, file_path, header) || fstat(fd, &info) != 0 ||
+        !(header.flags & BINARY_MAP_HAS_PATH_DATABASE)) {
+        close(fd);
+        return false;
+    }
+
+    uint64_t file_size = info.st_size;
+    uint64_t section[2];
+    if (header.database_offset % 64 != 0 || header.database_offset + sizeof(section) > file_size ||
+        pread(fd, section, sizeof(section), header.database_offset) != static_cast<ssize_t>(sizeof(section)) ||
+        section[0] > file_size - header.database_offset - sizeof(section)) {
+        std::cerr << "ERROR: loadBinaryMapDatabase: Truncated path database in " << file_path << std::endl;
+        close(fd);
+        return false;
+    }
+
+    void* ptr = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        std::cerr << "ERROR: loadBinaryMapDatabase: Failed to map " << file_path << std::endl;
+        return false;
+    }
+    mapping.reset(ptr, [file_size](const void* p) { munmap(const_cast<void*>(p), file_size); });
+    data = static_cast<const char*>(ptr) + header.database_offset + sizeof(section);
+    size = section[0];
+    if (verify_checksum && fnv1aChecksum(data, size) != section[1]) {
+        std::cerr << "ERROR: loadBinaryMapDatabase: Checksum mismatch in " << file_path << std::endl;
+        mapping.reset();
+        return false;
+    }
+    return true;
+}
+
+bool updateBinaryMapChecksums(const std::string& file_path) {
+    int fd = open(file_path.c_str(), O_RDWR);
+    if (fd < 0) {
+        std::cerr << "ERROR: updateBinaryMapChecksums: Failed to open " << file_path << std::endl;
+        return false;
+    }
+    BinaryMapHeader header;
+    bool ok = readHeaderForUpdate(fd, file_path, header);
+    uint64_t num_cells = static_cast<uint64_t>(header.width) * header.height;
+    ok = ok && fileChecksum(fd, header.odds_offset, num_cells, header.odds_checksum);
+    if (header.flags & BINARY_MAP_HAS_DT) {
+        ok = ok && fileChecksum(fd, header.dt_offset, num_cells * sizeof(float), header.dt_checksum);
+    }
+    if (header.flags & BINARY_MAP_HAS_CSPACE) {
+        ok = ok && fileChecksum(fd, header.cspace_offset, num_cells, header.cspace_checksum);
+    }
+    if (header.flags & BINARY_MAP_HAS_OCCUPANCY_BITS) {
+        uint64_t num_words = static_cast<uint64_t>((header.width + 63) / 64) * header.height;
+        ok = ok && fileChecksum(fd, header.bits_offset, num_words * sizeof(uint64_t), header.bits_checksum);
+    }
+    header.header_checksum = headerChecksum(header);
+    ok = ok && pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    close(fd);
+    return ok;
+}
@@ -0,0 +1,217 @@
+#include <cmath>
+#include <array>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+
+/**
+ * Sets the odds of a cell, keeping the occupancy bits up to date.
+ */
+static void setOdds(int i, int j, int8_t odds, GridGraph& graph) {
+    graph.cell_odds[cellToIdx(i, j, graph)] = odds;
+    setBit(graph.occupancy_bits, i, j, odds >= graph.threshold);
+}
+
+/**
+ * Sets every cell in the rectangle [i0, i1) x [j0, j1) to the given odds,
+ * clipped to the map.
+ */
+static void fillRect(int i0, int j0, int i1, int j1, int8_t odds, GridGraph& graph) {
+    i0 = std::max(i0, 0);
+    j0 = std::max(j0, 0);
+    i1 = std::min(i1, graph.width);
+    j1 = std::min(j1, graph.height);
+    for (int j = j0; j < j1; ++j) {
+        for (int i = i0; i < i1; ++i) {
+            setOdds(i, j, odds, graph);
+        }
+    }
+}
+
+/**
+ * Draws a one cell thick wall around the border of the map.
+ */
+static void drawBorder(GridGraph& graph) {
+    fillRect(0, 0, graph.width, 1, OCCUPIED_CELL_ODDS, graph);
+    fillRect(0, graph.height - 1, graph.width, graph.height, OCCUPIED_CELL_ODDS, graph);
+    fillRect(0, 0, 1, graph.height, OCCUPIED_CELL_ODDS, graph);
+    fillRect(graph.width - 1, 0, graph.width, graph.height, OCCUPIED_CELL_ODDS, graph);
+}
+
+void generateEmptyMap(int width, int height, GridGraph& graph) {
+    graph = GridGraph();
+    graph.width = width;
+    graph.height = height;
+    graph.meters_per_cell = GENERATED_MAP_MPC;
+    graph.origin_x = -0.5 * width * graph.meters_per_cell;
+    graph.origin_y = -0.5 * height * graph.meters_per_cell;
+    graph.collision_radius = ROBOT_RADIUS + graph.meters_per_cell;
+
+    int num_cells = width * height;
+    graph.cell_odds.assign(num_cells, FREE_CELL_ODDS);
+    graph.obstacle_distances.assign(num_cells, 0);
+    updateOccupancyBits(graph);
+    markMapChanged(graph);
+    drawBorder(graph);
+
+    initGraph(graph);
+}
+
+void generateRandomObstacleMap(int width, int height, float density, unsigned int seed, GridGraph& graph) {
+    generateEmptyMap(width, height, graph);
+    if (width < 3 || height < 3) return;
+
+    // Obstacles have the same size distribution at every map size, so maps of
+    // different sizes have the same texture.
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> pos_i(1, width - 2);
+    std::uniform_int_distribution<int> pos_j(1, height - 2);
+    std::uniform_int_distribution<int> extent(2, 12);
+
+    long interior = static_cast<long>(width - 2) * (height - 2);
+    long target = static_cast<long>(std::min(std::max(density, 0.0f), 1.0f) * interior);
+    long covered = 0;
+    long max_attempts = 100 + 10 * interior;
+    for (long attempt = 0; covered < target && attempt < max_attempts; ++attempt) {
+        int i0 = pos_i(gen), j0 = pos_j(gen);
+        int i1 = std::min(i0 + extent(gen), width - 1);
+        int j1 = std::min(j0 + extent(gen), height - 1);
+        for (int j = j0; j < j1 && covered < target; ++j) {
+            for (int i = i0; i < i1 && covered < target; ++i) {
+                if (graph.cell_odds[cellToIdx(i, j, graph)] != OCCUPIED_CELL_ODDS) ++covered;
+                setOdds(i, j, OCCUPIED_CELL_ODDS, graph);
+            }
+        }
+    }
+}
+
+void generateMazeMap(int width, int height, int corridor_width, unsigned int seed, GridGraph& graph) {
+    generateEmptyMap(width, height, graph);
+
+    // The maze is laid out on a coarse grid where each coarse cell is a
+    // corridor_width square surrounded by one cell thick walls.
+    int s = std::max(corridor_width, 1) + 1;
+    int cols = (width - 1) / s;
+    int rows = (height - 1) / s;
+    if (cols < 1 || rows < 1) return;
+
+    // Anything past the last full coarse cell is filled in.
+    fillRect(cols * s, 0, width, height, OCCUPIED_CELL_ODDS, graph);
+    fillRect(0, rows * s, width, height, OCCUPIED_CELL_ODDS, graph);
+
+    std::mt19937 gen(seed);
+    auto randInt = [&gen](int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(gen);
+    };
+
+    // Chambers are stored as [x0, x1) x [y0, y1) in coarse cells. An explicit
+    // stack avoids deep recursion on large maps.
+    std::vector<std::array<int, 4> > chambers = {{{0, 0, cols, rows}}};
+    while (!chambers.empty()) {
+        std::array<int, 4> c = chambers.back();
+        chambers.pop_back();
+        int x0 = c[0], y0 = c[1], x1 = c[2], y1 = c[3];
+        int w = x1 - x0, h = y1 - y0;
+        if (w < 2 && h < 2) continue;
+
+        bool vertical = w > h || (w == h && randInt(0, 1) == 0);
+        if (w < 2) vertical = false;
+        if (h < 2) vertical = true;
+
+        if (vertical) {
+            int wall = randInt(x0 + 1, x1 - 1);
+            int door = randInt(y0, y1 - 1);
+            fillRect(wall * s, y0 * s, wall * s + 1, y1 * s + 1, OCCUPIED_CELL_ODDS, graph);
+            fillRect(wall * s, door * s + 1, wall * s + 1, door * s + s, FREE_CELL_ODDS, graph);
+            chambers.push_back({{x0, y0, wall, y1}});
+            chambers.push_back({{wall, y0, x1, y1}});
+        } else {
+            int wall = randInt(y0 + 1, y1 - 1);
+            int door = randInt(x0, x1 - 1);
+            fillRect(x0 * s, wall * s, x1 * s + 1, wall * s + 1, OCCUPIED_CELL_ODDS, graph);
+            fillRect(door * s + 1, wall * s, door * s + s, wall * s + 1, FREE_CELL_ODDS, graph);
+            chambers.push_back({{x0, y0, x1, wall}});
+            chambers.push_back({{x0, wall, x1, y1}});
+        }
+    }
+}
+
+void generateRoomsMap(int width, int height, int num_rooms, int corridor_width, unsigned int seed,
+                      GridGraph& graph) {
+    generateEmptyMap(width, height, graph);
+    fillRect(0, 0, width, height, OCCUPIED_CELL_ODDS, graph);
+    if (width < 3 || height < 3 || num_rooms < 1) return;
+
+    std::mt19937 gen(seed);
+    auto randInt = [&gen](int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, std::max(lo, hi))(gen);
+    };
+
+    // Rooms are sized so that they roughly tile the map.
+    int max_size = std::min(width, height) / static_cast<int>(std::ceil(std::sqrt(num_rooms)) + 1);
+    max_size = std::max(max_size, 2 * corridor_width + 2);
+    int min_size = std::max(max_size / 2, corridor_width);
+
+    std::vector<Cell> centers;
+    for (int k = 0; k < num_rooms; ++k) {
+        int w = std::min(randInt(min_size, max_size), width - 2);
+        int h = std::min(randInt(min_size, max_size), height - 2);
+        int i0 = randInt(1, width - 1 - w);
+        int j0 = randInt(1, height - 1 - h);
+        fillRect(i0, j0, i0 + w, j0 + h, FREE_CELL_ODDS, graph);
+        centers.push_back({i0 + w / 2, j0 + h / 2});
+    }
+
+    // Join each room to the previous one with an L-shaped corridor, which
+    // connects all the rooms.
+    int half = corridor_width / 2;
+    for (size_t k = 1; k < centers.size(); ++k) {
+        const Cell& a = centers[k - 1];
+        const Cell& b = centers[k];
+        fillRect(std::min(a.i, b.i) - half, a.j - half, std::max(a.i, b.i) - half + corridor_width,
+                 a.j - half + corridor_width, FREE_CELL_ODDS, graph);
+        fillRect(b.i - half, std::min(a.j, b.j) - half, b.i - half + corridor_width,
+                 std::max(a.j, b.j) - half + corridor_width, FREE_CELL_ODDS, graph);
+    }
+    drawBorder(graph);
+}
+
+void generateNarrowPassageMap(int width, int height, int num_walls, int gap_width, unsigned int seed,
+                              GridGraph& graph) {
+    generateEmptyMap(width, height, graph);
+    if (num_walls < 1 || width < 3) return;
+
+    std::mt19937 gen(seed);
+    gap_width = std::min(std::max(gap_width, 1), width - 2);
+    std::uniform_int_distribution<int> gap_pos(1, width - 1 - gap_width);
+
+    // Walls take up about a third of the map height, like data/narrow.map.
+    int thickness = std::max(1, (height - 2) / (3 * num_walls));
+    for (int k = 0; k < num_walls; ++k) {
+        int center = (k + 1) * height / (num_walls + 1);
+        int j0 = center - thickness / 2;
+        fillRect(1, j0, width - 1, j0 + thickness, OCCUPIED_CELL_ODDS, graph);
+        int i0 = gap_pos(gen);
+        fillRect(i0, j0, i0 + gap_width, j0 + thickness, FREE_CELL_ODDS, graph);
+    }
+}
+
+bool generateMap(const std::string& type, int width, int height, float param, unsigned int seed,
+                 GridGraph& graph) {
+    if (type == "random") {
+        generateRandomObstacleMap(width, height, param, seed, graph);
+    } else if (type == "maze") {
+        generateMazeMap(width, height, static_cast<int>(param), seed, graph);
+    } else if (type == "rooms") {
+        // Rooms and corridors are wide enough for the robot to fit through.
+        generateRoomsMap(width, height, static_cast<int>(param), 12, seed, graph);
+    } else if (type == "narrow") {
+        generateNarrowPassageMap(width, height, 1, static_cast<int>(param), seed, graph);
+    } else {
+        return false;
+    }
+    return true;
+}
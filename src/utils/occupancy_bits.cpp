@@ -0,0 +1,155 @@
+#include <cmath>
+#include <algorithm>
+
+#include <path_planning/utils/occupancy_bits.h>
+
+#define ALL_BITS (~static_cast<uint64_t>(0))
+
+/**
+ * Gets a mask of the bits for columns [i0, i1] within the word that starts at
+ * column 64 * w.
+ */
+static uint64_t spanMask(int w, int i0, int i1) {
+    uint64_t mask = ALL_BITS;
+    if (w == (i0 >> 6)) mask &= ALL_BITS << (i0 & 63);
+    if (w == (i1 >> 6)) mask &= ALL_BITS >> (63 - (i1 & 63));
+    return mask;
+}
+
+void initOccupancyBits(int width, int height, OccupancyBits& bits) {
+    bits.width = std::max(width, 0);
+    bits.height = std::max(height, 0);
+    bits.words_per_row = (bits.width + 63) / 64;
+    bits.words.assign(static_cast<size_t>(bits.words_per_row) * bits.height, 0);
+
+    // Set the padding bits past the end of each row.
+    if (bits.width % 64 != 0) {
+        uint64_t padding = ALL_BITS << (bits.width % 64);
+        for (int j = 0; j < bits.height; ++j) {
+            bits.words[(j + 1) * static_cast<size_t>(bits.words_per_row) - 1] = padding;
+        }
+    }
+}
+
+uint64_t rowWord(const OccupancyBits& bits, int i, int j) {
+    if (j < 0 || j >= bits.height) return ALL_BITS;
+    const uint64_t* row = bits.words.data() + j * static_cast<size_t>(bits.words_per_row);
+    auto wordAt = [&](int w) {
+        return w < 0 || w >= bits.words_per_row ? ALL_BITS : row[w];
+    };
+
+    // Floor division, so that columns left of the grid work too.
+    int w = i >= 0 ? i / 64 : -((63 - i) / 64);
+    int shift = i - 64 * w;
+    uint64_t word = wordAt(w) >> shift;
+    if (shift != 0) word |= wordAt(w + 1) << (64 - shift);
+    return word;
+}
+
+bool isRowSpanClear(const OccupancyBits& bits, int j, int i0, int i1) {
+    if (i0 > i1) return true;
+    if (j < 0 || j >= bits.height || i0 < 0 || i1 >= bits.width) return false;
+    const uint64_t* row = bits.words.data() + j * static_cast<size_t>(bits.words_per_row);
+    for (int w = i0 >> 6; w <= (i1 >> 6); ++w) {
+        if (row[w] & spanMask(w, i0, i1)) return false;
+    }
+    return true;
+}
+
+bool isRectClear(const OccupancyBits& bits, int i0, int j0, int i1, int j1) {
+    for (int j = j0; j <= j1; ++j) {
+        if (!isRowSpanClear(bits, j, i0, i1)) return false;
+    }
+    return true;
+}
+
+int64_t countSetBits(const OccupancyBits& bits, int i0, int j0, int i1, int j1) {
+    i0 = std::max(i0, 0);
+    j0 = std::max(j0, 0);
+    i1 = std::min(i1, bits.width - 1);
+    j1 = std::min(j1, bits.height - 1);
+
+    int64_t count = 0;
+    for (int j = j0; j <= j1 && i0 <= i1; ++j) {
+        const uint64_t* row = bits.words.data() + j * static_cast<size_t>(bits.words_per_row);
+        for (int w = i0 >> 6; w <= (i1 >> 6); ++w) {
+            count += __builtin_popcountll(row[w] & spanMask(w, i0, i1));
+        }
+    }
+    return count;
+}
+
+bool lineOfSight(const OccupancyBits& bits, int i0, int j0, int i1, int j1) {
+    if (testBit(bits, i0, j0) || testBit(bits, i1, j1)) return false;
+    if (j0 > j1) {
+        std::swap(i0, i1);
+        std::swap(j0, j1);
+    }
+    if (j0 == j1) return isRowSpanClear(bits, j0, std::min(i0, i1), std::max(i0, i1));
+
+    // Work in half cell units so that cell centers and cell edges are both
+    // integers, and the crossing points are exact rationals. Cell k covers
+    // [2k, 2k + 2] and its center is at 2k + 1.
+    int64_t x0 = 2 * i0 + 1, y0 = 2 * j0 + 1;
+    int64_t dx = 2 * (i1 - i0), dy = 2 * (j1 - j0);
+    for (int j = j0; j <= j1; ++j) {
+        // The part of the segment inside row j, as x * dy at each end.
+        int64_t lo = x0 * dy + (std::max<int64_t>(2 * j, y0) - y0) * dx;
+        int64_t hi = x0 * dy + (std::min<int64_t>(2 * j + 2, y0 + dy) - y0) * dx;
+        if (lo > hi) std::swap(lo, hi);
+
+        // A segment that touches the left edge of a cell also touches the
+        // cell to its left.
+        int first = static_cast<int>(lo / (2 * dy));
+        if (lo % (2 * dy) == 0) --first;
+        int last = static_cast<int>(hi / (2 * dy));
+        if (!isRowSpanClear(bits, j, first, last)) return false;
+    }
+    return true;
+}
+
+bool isDiscClear(const OccupancyBits& bits, int i, int j, float radius) {
+    int reach = static_cast<int>(std::floor(radius));
+    for (int dj = -reach; dj <= reach; ++dj) {
+        int half = static_cast<int>(std::floor(std::sqrt(radius * radius - dj * dj)));
+        if (!isRowSpanClear(bits, j + dj, i - half, i + half)) return false;
+    }
+    return true;
+}
+
+/**
+ * ORs each pair of adjacent bits of a word, then packs the 32 results into the
+ * low half of the word.
+ */
+static uint64_t poolBitPairs(uint64_t x) {
+    x = (x | (x >> 1)) & 0x5555555555555555ull;
+    x = (x | (x >> 1)) & 0x3333333333333333ull;
+    x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0full;
+    x = (x | (x >> 4)) & 0x00ff00ff00ff00ffull;
+    x = (x | (x >> 8)) & 0x0000ffff0000ffffull;
+    x = (x | (x >> 16)) & 0x00000000ffffffffull;
+    return x;
+}
+
+void downsampleOccupancyBits(const OccupancyBits& fine, OccupancyBits& coarse) {
+    initOccupancyBits((fine.width + 1) / 2, (fine.height + 1) / 2, coarse);
+
+    // Clear the padding of the fine rows, so that the last column of an odd
+    // width is only pooled with itself.
+    uint64_t last_mask = fine.width % 64 != 0 ? ALL_BITS >> (64 - fine.width % 64) : ALL_BITS;
+    auto fineWord = [&](const uint64_t* row, int w) {
+        if (w >= fine.words_per_row) return static_cast<uint64_t>(0);
+        return w == fine.words_per_row - 1 ? row[w] & last_mask : row[w];
+    };
+
+    for (int j = 0; j < coarse.height; ++j) {
+        const uint64_t* row0 = fine.words.data() + 2 * j * static_cast<size_t>(fine.words_per_row);
+        const uint64_t* row1 = 2 * j + 1 < fine.height ? row0 + fine.words_per_row : row0;
+        uint64_t* out = coarse.words.data() + j * static_cast<size_t>(coarse.words_per_row);
+        for (int w = 0; w < coarse.words_per_row; ++w) {
+            uint64_t low = fineWord(row0, 2 * w) | fineWord(row1, 2 * w);
+            uint64_t high = fineWord(row0, 2 * w + 1) | fineWord(row1, 2 * w + 1);
+            out[w] |= poolBitPairs(low) | (poolBitPairs(high) << 32);
+        }
+    }
+}
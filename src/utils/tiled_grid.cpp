@@ -0,0 +1,224 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <path_planning/utils/math_helpers.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/utils/tiled_grid.h>
+
+TiledGridGraph::TiledGridGraph() :
+    width(-1),
+    height(-1),
+    origin_x(0),
+    origin_y(0),
+    meters_per_cell(0),
+    collision_radius(0.15),
+    threshold(-100),
+    fd_(-1),
+    writable_(false),
+    tile_size_(256),
+    max_resident_bytes_(0),
+    resident_bytes_(0),
+    offsets_{0, 0, 0},
+    elem_size_{sizeof(int8_t), sizeof(float), sizeof(uint8_t)},
+    has_last_{false, false, false}
+{
+}
+
+TiledGridGraph::~TiledGridGraph() {
+    close();
+}
+
+bool TiledGridGraph::open(const std::string& file_path, int tile_size, size_t max_resident_bytes, bool writable) {
+    close();
+
+    fd_ = ::open(file_path.c_str(), writable ? O_RDWR : O_RDONLY);
+    if (fd_ < 0) {
+        std::cerr << "ERROR: TiledGridGraph: Failed to open " << file_path << std::endl;
+        return false;
+    }
+
+    BinaryMapHeader header;
+    if (pread(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+        std::memcmp(header.magic, BINARY_MAP_MAGIC, sizeof(header.magic)) != 0 ||
+        header.endian_tag != BINARY_MAP_ENDIAN_TAG || header.version != BINARY_MAP_VERSION) {
+        std::cerr << "ERROR: TiledGridGraph: Not a binary map with native byte order: " << file_path << std::endl;
+        close();
+        return false;
+    }
+
+    width = header.width;
+    height = header.height;
+    origin_x = header.origin_x;
+    origin_y = header.origin_y;
+    meters_per_cell = header.meters_per_cell;
+    collision_radius = header.collision_radius;
+    threshold = header.threshold;
+
+    offsets_[kOddsLayer] = header.odds_offset;
+    offsets_[kDistanceLayer] = (header.flags & BINARY_MAP_HAS_DT) ? header.dt_offset : 0;
+    offsets_[kCSpaceLayer] = (header.flags & BINARY_MAP_HAS_CSPACE) ? header.cspace_offset : 0;
+
+    file_path_ = file_path;
+    writable_ = writable;
+    tile_size_ = std::max(tile_size, 1);
+    // At least one tile of each layer must fit.
+    max_resident_bytes_ = std::max(max_resident_bytes, 3 * sizeof(float) * tile_size_ * tile_size_);
+    resetStats();
+    return true;
+}
+
+void TiledGridGraph::close() {
+    if (fd_ < 0) return;
+    flush();
+    tiles_.clear();
+    index_.clear();
+    std::fill(has_last_, has_last_ + kNumLayers, false);
+    resident_bytes_ = 0;
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool TiledGridGraph::flush() {
+    bool wrote = false, ok = true;
+    for (Tile& tile : tiles_) {
+        if (!tile.dirty) continue;
+        ok = writeTile(tile) && ok;
+        wrote = true;
+    }
+    if (wrote) ok = updateBinaryMapChecksums(file_path_) && ok;
+    return ok;
+}
+
+int8_t TiledGridGraph::cellOdds(int i, int j) {
+    return *reinterpret_cast<int8_t*>(cell(kOddsLayer, i, j, false));
+}
+
+bool TiledGridGraph::isCellOccupied(int i, int j) {
+    return cellOdds(i, j) >= threshold;
+}
+
+float TiledGridGraph::obstacleDistance(int i, int j) {
+    if (!hasDistances()) return 0;
+    float distance;
+    std::memcpy(&distance, cell(kDistanceLayer, i, j, false), sizeof(distance));
+    return distance;
+}
+
+void TiledGridGraph::setObstacleDistance(int i, int j, float distance) {
+    if (!hasDistances() || !writable_) return;
+    std::memcpy(cell(kDistanceLayer, i, j, true), &distance, sizeof(distance));
+}
+
+bool TiledGridGraph::checkCollision(int i, int j) {
+    if (hasCSpace()) return *cell(kCSpaceLayer, i, j, false) != 0;
+    if (isCellOccupied(i, j)) return true;
+
+    // Same as checkCollision() on a GridGraph.
+    double dtheta = meters_per_cell / collision_radius;
+    double theta = 0;
+    float x0 = (i + 0.5) * meters_per_cell + origin_x;
+    float y0 = (j + 0.5) * meters_per_cell + origin_y;
+    while (theta < 2 * PI) {
+        double x = x0 + collision_radius * cos(theta);
+        double y = y0 + collision_radius * sin(theta);
+        int ci = static_cast<int>(floor((static_cast<float>(x) - origin_x) / meters_per_cell));
+        int cj = static_cast<int>(floor((static_cast<float>(y) - origin_y) / meters_per_cell));
+        if (!isCellInBounds(ci, cj) || isCellOccupied(ci, cj)) {
+            return true;
+        }
+        theta += dtheta;
+    }
+    return false;
+}
+
+char* TiledGridGraph::cell(int layer, int i, int j, bool write) {
+    int tx = i / tile_size_, ty = j / tile_size_;
+
+    TileList::iterator tile;
+    if (has_last_[layer] && last_[layer]->tx == tx && last_[layer]->ty == ty) {
+        tile = last_[layer];
+        // Another layer may have used a tile since, so this one still has to
+        // move to the front to keep the eviction order least recently used.
+        if (tile != tiles_.begin()) tiles_.splice(tiles_.begin(), tiles_, tile);
+        ++stats_.hits;
+    } else {
+        uint64_t key = (static_cast<uint64_t>(layer) << 62) | (static_cast<uint64_t>(ty) << 31) | tx;
+        auto found = index_.find(key);
+        if (found != index_.end()) {
+            tile = found->second;
+            tiles_.splice(tiles_.begin(), tiles_, tile);
+            ++stats_.hits;
+        } else {
+            tile = loadTile(layer, tx, ty);
+            index_[key] = tile;
+            ++stats_.misses;
+        }
+        last_[layer] = tile;
+        has_last_[layer] = true;
+    }
+
+    if (write) tile->dirty = true;
+    size_t offset = (j - ty * tile_size_) * static_cast<size_t>(tile->cols) + (i - tx * tile_size_);
+    return tile->data.data() + offset * elem_size_[layer];
+}
+
+TiledGridGraph::TileList::iterator TiledGridGraph::loadTile(int layer, int tx, int ty) {
+    Tile tile;
+    tile.layer = layer;
+    tile.tx = tx;
+    tile.ty = ty;
+    tile.cols = std::min(tile_size_, width - tx * tile_size_);
+    tile.rows = std::min(tile_size_, height - ty * tile_size_);
+    tile.dirty = false;
+
+    size_t elem = elem_size_[layer];
+    size_t row_bytes = tile.cols * elem;
+    evictUntil(max_resident_bytes_ - row_bytes * tile.rows);
+
+    tile.data.resize(row_bytes * tile.rows);
+    for (int r = 0; r < tile.rows; ++r) {
+        int64_t idx = cellToIdx(tx * tile_size_, ty * tile_size_ + r);
+        ssize_t read = pread(fd_, tile.data.data() + r * row_bytes, row_bytes, offsets_[layer] + idx * elem);
+        if (read != static_cast<ssize_t>(row_bytes)) {
+            std::cerr << "ERROR: TiledGridGraph: Failed to read tile from " << file_path_ << std::endl;
+        }
+    }
+
+    resident_bytes_ += tile.data.size();
+    tiles_.push_front(std::move(tile));
+    return tiles_.begin();
+}
+
+bool TiledGridGraph::writeTile(Tile& tile) {
+    size_t elem = elem_size_[tile.layer];
+    size_t row_bytes = tile.cols * elem;
+    bool ok = true;
+    for (int r = 0; r < tile.rows; ++r) {
+        int64_t idx = cellToIdx(tile.tx * tile_size_, tile.ty * tile_size_ + r);
+        ssize_t written = pwrite(fd_, tile.data.data() + r * row_bytes, row_bytes, offsets_[tile.layer] + idx * elem);
+        ok = ok && written == static_cast<ssize_t>(row_bytes);
+    }
+    if (!ok) std::cerr << "ERROR: TiledGridGraph: Failed to write tile to " << file_path_ << std::endl;
+    tile.dirty = false;
+    ++stats_.writebacks;
+    return ok;
+}
+
+void TiledGridGraph::evictUntil(size_t max_bytes) {
+    while (!tiles_.empty() && resident_bytes_ > max_bytes) {
+        Tile& tile = tiles_.back();
+        if (tile.dirty) writeTile(tile);
+        if (has_last_[tile.layer] && &*last_[tile.layer] == &tile) has_last_[tile.layer] = false;
+
+        uint64_t key = (static_cast<uint64_t>(tile.layer) << 62) | (static_cast<uint64_t>(tile.ty) << 31) | tile.tx;
+        index_.erase(key);
+        resident_bytes_ -= tile.data.size();
+        tiles_.pop_back();
+        ++stats_.evictions;
+    }
+}
@@ -0,0 +1,281 @@
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <iostream>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/utils/viz_utils.h>
+
+/**
+ * The parts of a graph written to a plan file. They point either into a
+ * graph or into copies owned by an asynchronous write.
+ */
+struct PlanFileData {
+    Cell start, goal;
+    const std::vector<Cell>* path;
+    const std::vector<Cell>* visited_cells;
+    const float* obstacle_distances;
+    size_t num_distances;
+    const int8_t* cell_odds;
+    size_t num_cells;
+    std::string map_header;     // The header of the text map, ending in a space.
+    std::string algo;
+};
+
+/**
+ * Buffers the text of a plan file and writes it out in large blocks.
+ */
+class PlanFileStream {
+public:
+    explicit PlanFileStream(FILE* file) : file_(file), buffer_(1 << 16), used_(0), ok_(true) {}
+
+    void write(const char* text, size_t size) {
+        while (size > 0) {
+            if (used_ == buffer_.size()) flush();
+            size_t n = std::min(size, buffer_.size() - used_);
+            std::memcpy(buffer_.data() + used_, text, n);
+            used_ += n;
+            text += n;
+            size -= n;
+        }
+    }
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    void put(char c) {
+        if (used_ == buffer_.size()) flush();
+        buffer_[used_++] = c;
+    }
+
+    void writeInt(int64_t value) {
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* begin = end;
+        uint64_t magnitude = value < 0 ? -static_cast<uint64_t>(value) : value;
+        do {
+            *--begin = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0) *--begin = '-';
+        write(begin, end - begin);
+    }
+
+    /**
+     * Writes a float the way std::to_string() does, with six decimals.
+     * Scaling a float by 10^6 is exact in double precision, so rounding
+     * that gives the same digits as printf().
+     */
+    void writeFloat(float value) {
+        double scaled = std::fabs(static_cast<double>(value)) * 1e6;
+        if (!std::isfinite(value) || scaled >= 9e15) {
+            char text[64];
+            int n = std::snprintf(text, sizeof(text), "%f", value);
+            write(text, n);
+            return;
+        }
+        uint64_t units = static_cast<uint64_t>(std::nearbyint(scaled));
+        if (std::signbit(value)) put('-');
+        writeInt(static_cast<int64_t>(units / 1000000));
+        char decimals[7] = {'.'};
+        uint64_t fraction = units % 1000000;
+        for (int k = 6; k >= 1; --k) {
+            decimals[k] = '0' + fraction % 10;
+            fraction /= 10;
+        }
+        write(decimals, sizeof(decimals));
+    }
+
+    void writeCell(const Cell& c) {
+        put('[');
+        writeInt(c.i);
+        put(',');
+        writeInt(c.j);
+        put(']');
+    }
+
+    void writeCells(const std::vector<Cell>& cells) {
+        for (size_t k = 0; k < cells.size(); ++k) {
+            if (k > 0) put(',');
+            writeCell(cells[k]);
+        }
+    }
+
+    void writeHash(uint64_t hash) {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+        put('"');
+        write(text, 16);
+        put('"');
+    }
+
+    /**
+     * Writes bytes in base64, keeping up to two bytes back until the next
+     * call or finishBase64().
+     */
+    void writeBase64(const uint8_t* bytes, size_t size) {
+        for (size_t k = 0; k < size; ++k) {
+            pending_[num_pending_++] = bytes[k];
+            if (num_pending_ == 3) encodePending();
+        }
+    }
+
+    void finishBase64() {
+        if (num_pending_ > 0) encodePending();
+    }
+
+    bool flush() {
+        if (used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_) ok_ = false;
+        used_ = 0;
+        return ok_;
+    }
+
+private:
+    void encodePending() {
+        static const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        uint32_t group = pending_[0] << 16;
+        if (num_pending_ > 1) group |= pending_[1] << 8;
+        if (num_pending_ > 2) group |= pending_[2];
+        char text[4] = {kAlphabet[(group >> 18) & 63], kAlphabet[(group >> 12) & 63],
+                        num_pending_ > 1 ? kAlphabet[(group >> 6) & 63] : '=',
+                        num_pending_ > 2 ? kAlphabet[group & 63] : '='};
+        write(text, 4);
+        num_pending_ = 0;
+    }
+
+    FILE* file_;
+    std::vector<char> buffer_;
+    size_t used_;
+    bool ok_;
+    uint8_t pending_[3];
+    int num_pending_ = 0;
+};
+
+static bool writePlanFile(const PlanFileData& data, const std::string& out_name, const PlanFileOptions& options) {
+    FILE* file = std::fopen(out_name.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "ERROR: generatePlanFile: Failed to open " << out_name << std::endl;
+        return false;
+    }
+    std::unique_ptr<FILE, int (*)(FILE*)> closer(file, std::fclose);
+    PlanFileStream out(file);
+
+    out.write("{ \"path\" : [");
+    out.writeCells(*data.path);
+    out.put(']');
+
+    if (options.visited_cells) {
+        out.write(", \"visited_cells\":[");
+        out.writeCells(*data.visited_cells);
+        out.put(']');
+    }
+
+    if (options.dt == PLAN_SECTION_TEXT) {
+        out.write(", \"dt\":[");
+        for (size_t k = 0; k < data.num_distances; ++k) {
+            if (k > 0) out.put(',');
+            out.writeFloat(data.obstacle_distances[k]);
+        }
+        out.put(']');
+    } else if (options.dt == PLAN_SECTION_BASE64) {
+        // Bytes are taken out least significant first, whatever the byte
+        // order of this machine.
+        out.write(", \"dt_base64\": \"");
+        for (size_t k = 0; k < data.num_distances; ++k) {
+            uint32_t bits;
+            std::memcpy(&bits, &data.obstacle_distances[k], sizeof(bits));
+            uint8_t bytes[4] = {static_cast<uint8_t>(bits), static_cast<uint8_t>(bits >> 8),
+                                static_cast<uint8_t>(bits >> 16), static_cast<uint8_t>(bits >> 24)};
+            out.writeBase64(bytes, 4);
+        }
+        out.finishBase64();
+        out.put('"');
+    } else if (options.dt == PLAN_SECTION_HASH) {
+        out.write(", \"dt_hash\": ");
+        out.writeHash(fnv1aChecksum(data.obstacle_distances, data.num_distances * sizeof(float)));
+    }
+
+    if (options.map == PLAN_SECTION_TEXT) {
+        out.write(", \"map\": \"");
+        out.write(data.map_header);
+        for (size_t k = 0; k < data.num_cells; ++k) {
+            out.writeInt(data.cell_odds[k]);
+            out.put(' ');
+        }
+        out.put('"');
+    } else if (options.map == PLAN_SECTION_BASE64) {
+        out.write(", \"map_header\": \"");
+        out.write(data.map_header);
+        out.write("\", \"map_base64\": \"");
+        out.writeBase64(reinterpret_cast<const uint8_t*>(data.cell_odds), data.num_cells);
+        out.finishBase64();
+        out.put('"');
+    } else if (options.map == PLAN_SECTION_HASH) {
+        out.write(", \"map_hash\": ");
+        out.writeHash(fnv1aChecksum(data.cell_odds, data.num_cells));
+    }
+
+    out.write(", \"start\": ");
+    out.writeCell(data.start);
+    out.write(", \"goal\": ");
+    out.writeCell(data.goal);
+    out.write(", \"planning_algo\": \"");
+    out.write(data.algo);
+    out.write("\"}");
+    return out.flush();
+}
+
+bool generatePlanFile(const Cell& start, const Cell& goal, const std::vector<Cell>& path, const GridGraph& graph,
+                      const std::string& algo, const std::string& out_name, const PlanFileOptions& options) {
+    std::cout << "Saving planning data to file: " << out_name << std::endl;
+    PlanFileData data = {start, goal, &path, &graph.visited_cells,
+                         graph.obstacle_distances.data(), graph.obstacle_distances.size(),
+                         graph.cell_odds.data(), graph.cell_odds.size(),
+                         formatHeader(graph, ' '), algo};
+    return writePlanFile(data, out_name, options);
+}
+
+std::future<bool> generatePlanFileAsync(const Cell& start, const Cell& goal, const std::vector<Cell>& path,
+                                        const GridGraph& graph, const std::string& algo,
+                                        const std::string& out_name, const PlanFileOptions& options) {
+    std::cout << "Saving planning data to file: " << out_name << std::endl;
+
+    // Copy what the options need, since the graph may change while writing.
+    struct Copies {
+        std::vector<Cell> path, visited_cells;
+        std::vector<float> obstacle_distances;
+        std::vector<int8_t> cell_odds;
+    };
+    auto copies = std::make_shared<Copies>();
+    copies->path = path;
+    if (options.visited_cells) copies->visited_cells = graph.visited_cells;
+    if (options.dt != PLAN_SECTION_OMIT) {
+        copies->obstacle_distances.assign(graph.obstacle_distances.begin(), graph.obstacle_distances.end());
+    }
+    if (options.map != PLAN_SECTION_OMIT) copies->cell_odds.assign(graph.cell_odds.begin(), graph.cell_odds.end());
+
+    PlanFileData data = {start, goal, &copies->path, &copies->visited_cells,
+                         copies->obstacle_distances.data(), copies->obstacle_distances.size(),
+                         copies->cell_odds.data(), copies->cell_odds.size(),
+                         formatHeader(graph, ' '), algo};
+    return std::async(std::launch::async, [copies, data, out_name, options]() {
+        return writePlanFile(data, out_name, options);
+    });
+}
+
+bool parsePlanFileMode(const std::string& name, PlanFileOptions& options) {
+    options = PlanFileOptions();
+    if (name == "full") return true;
+    if (name == "compact") {
+        options.dt = options.map = PLAN_SECTION_BASE64;
+    } else if (name == "hash") {
+        options.dt = options.map = PLAN_SECTION_HASH;
+    } else if (name == "path") {
+        options.dt = options.map = PLAN_SECTION_OMIT;
+    } else {
+        return false;
+    }
+    return true;
+}
@@ -8,6 +8,40 @@ TEST(PlanningInMichigan, SaginawBentonHarbor) {
     testMichiganBfs("saginaw", "benton_harbor", "../data/planning_in_michigan/mi_graph.txt");
 }
 
+TEST(PlanningInMichigan, GraphArcs) {
+    testMichiganGraphArcs("../data/planning_in_michigan/mi_graph.txt");
+    testMichiganGraphArcs("../data/planning_in_michigan/bereaf23_graph.txt");
+}
+
+TEST(PlanningInMichigan, DimacsGraph) {
+    testDimacsGraph();
+}
+
+TEST(PlanningInMichigan, ShortestPaths) {
+    testGraphShortestPaths("../data/planning_in_michigan/mi_graph.txt");
+    testGraphShortestPaths("../data/planning_in_michigan/bereaf23_graph.txt");
+}
+
+TEST(PlanningInMichigan, AStar) {
+    testGraphAStar();
+}
+
+TEST(PlanningInMichigan, LargePathCosts) {
+    testLargePathCosts();
+}
+
+TEST(PlanningInMichigan, ContractionHierarchy) {
+    testContractionHierarchy();
+}
+
+TEST(PlanningInMichigan, AltLandmarks) {
+    testAltLandmarks();
+}
+
+TEST(PlanningInMichigan, DistanceTable) {
+    testDistanceTable();
+}
+
 TEST(FindNeighbors, TestMiddle) {
     int node_index = 6;  // Node in the middle.
     std::vector<int> correct_neighbor_indicies = {0, 5, 10, 1, 11, 2, 7, 12};
@@ -34,4 +68,268 @@ TEST(BFS, TestCorner) {
                                        47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 
                                        34, 33, 32, 31, 30, 29, 28, 28, 28, 28, 28, 28, 28};
     testGridGraphBreadthFirstSearch(correct_path_i, correct_path_j, "../data/maze3.map");
-}
\ No newline at end of file
+}
+
+TEST(MapIO, RoundTripMaze) {
+    testMapRoundTrip("../data/maze3.map");
+}
+
+TEST(MapIO, RoundTripTiny) {
+    testMapRoundTrip("../data/tiny_map.map");
+}
+
+TEST(MapIO, BinaryRoundTrip) {
+    testBinaryMapRoundTrip("../data/maze3.map");
+}
+
+TEST(MapIO, BinaryCorruption) {
+    testBinaryMapCorruption("../data/maze3.map");
+}
+
+TEST(TiledGrid, DistanceTransform) {
+    testTiledDistanceTransform("../data/maze3.map", 16);
+}
+
+TEST(TiledGrid, AStar) {
+    testTiledAStar("../data/maze2.map", {50, 50}, {92, 50});
+}
+
+TEST(OccupancyBits, MatchesCellOdds) {
+    testOccupancyBits("../data/maze3.map");
+}
+
+TEST(OccupancyBits, NarrowPassage) {
+    testOccupancyBits("../data/narrow.map");
+}
+
+TEST(Wavefront, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    testWavefront(graph, {50, 50});
+}
+
+TEST(Wavefront, WideGeneratedMap) {
+    GridGraph graph;
+    generateRoomsMap(300, 140, 6, 12, 3, graph);
+    int start = 0;
+    while (checkCollision(start, graph)) ++start;
+    testWavefront(graph, idxToCell(start, graph));
+}
+
+TEST(FlowField, MatchesAStar) {
+    testFlowField("../data/maze2.map", {50, 50});
+}
+
+TEST(FlowField, CacheInvalidation) {
+    testFlowFieldCache("../data/narrow.map", {100, 30}, {100, 170});
+}
+
+TEST(HPAStar, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    testHierarchicalSearch(graph, {50, 50}, 10);
+}
+
+TEST(HPAStar, GeneratedRooms) {
+    GridGraph graph;
+    generateRoomsMap(256, 256, 10, 12, 5, graph);
+    computeCSpace(graph);
+    testHierarchicalSearch(graph, nearestFreeCell(graph, graph.width * graph.height - 1, -1), 16);
+}
+
+TEST(PathDatabase, Maze) {
+    testPathDatabase("../data/maze2.map");
+}
+
+TEST(MapPyramid, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    testMapPyramid(graph, {50, 50});
+}
+
+TEST(MapPyramid, GeneratedObstacles) {
+    GridGraph graph;
+    generateRandomObstacleMap(301, 257, 0.05, 3, graph);
+    computeCSpace(graph);
+    testMapPyramid(graph, nearestFreeCell(graph, graph.width * graph.height / 2, 1));
+}
+
+TEST(Quadtree, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    testQuadtree(graph, {50, 50});
+}
+
+TEST(Quadtree, GeneratedRooms) {
+    GridGraph graph;
+    generateRoomsMap(256, 256, 10, 12, 5, graph);
+    computeCSpace(graph);
+    testQuadtree(graph, nearestFreeCell(graph, graph.width * graph.height - 1, -1));
+}
+
+TEST(Quadtree, EmptyMapExpansions) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/empty_map.map", graph));
+    computeCSpace(graph);
+    Cell start = {10, 10}, goal = {graph.width - 10, graph.height - 10};
+    ASSERT_FALSE(graph.cspace[cellToIdx(start.i, start.j, graph)]);
+    ASSERT_FALSE(graph.cspace[cellToIdx(goal.i, goal.j, graph)]);
+
+    QuadtreeMap quadtree;
+    buildQuadtree(graph, quadtree);
+    QuadtreeSearchStats quadtree_stats;
+    std::vector<Cell> path = quadtreeSearch(graph, quadtree, start, goal, &quadtree_stats);
+    MapPyramid full_resolution;
+    buildMapPyramid(graph, full_resolution, 0);
+    PyramidSearchStats grid_stats;
+    std::vector<Cell> grid_path = pyramidSearch(graph, full_resolution, start, goal, &grid_stats);
+
+    ASSERT_NEAR(octilePathCost(path), octilePathCost(grid_path), 1e-3);
+    ASSERT_LT(10 * quadtree_stats.leaves_expanded, grid_stats.expanded);
+}
+
+TEST(CollisionModes, BreadthFirstSearch) {
+    auto checks = testCollisionModes("../data/maze2.map", breadthFirstSearch, {50, 50}, {92, 50});
+    // Cluttered maps generate many neighbors in collision that are never expanded.
+    ASSERT_LT(2 * checks.second, checks.first);
+}
+
+TEST(CollisionModes, AStar) {
+    testCollisionModes("../data/maze2.map", aStarSearch, {50, 50}, {92, 50});
+}
+
+TEST(CollisionModes, DepthFirstSearch) {
+    testCollisionModes("../data/maze2.map", depthFirstSearch, {50, 50}, {92, 50});
+}
+
+TEST(CollisionModes, IterativeDeepeningSearch) {
+    testCollisionModes("../data/empty_map.map", iterativeDeepeningSearch, {20, 20}, {30, 26});
+}
+
+TEST(BoundedSearch, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    computeCSpace(graph);
+    testBoundedSearch(graph, {50, 50});
+}
+
+TEST(BoundedSearch, GeneratedObstacles) {
+    GridGraph graph;
+    generateRandomObstacleMap(301, 257, 0.1, 3, graph);
+    computeCSpace(graph);
+    testBoundedSearch(graph, nearestFreeCell(graph, graph.width * graph.height / 2, 1));
+}
+
+TEST(MultiGoalSearch, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    computeCSpace(graph);
+    testMultiGoalSearch(graph, 8, 1);
+}
+
+TEST(MultiGoalSearch, ManyGoals) {
+    GridGraph graph;
+    generateRandomObstacleMap(301, 257, 0.1, 3, graph);
+    computeCSpace(graph);
+    // More goals than MULTI_GOAL_EXACT_HEURISTIC_GOALS, so the bounding box heuristic is used.
+    testMultiGoalSearch(graph, MULTI_GOAL_EXACT_HEURISTIC_GOALS + 20, 2);
+}
+
+TEST(MultiGoalSearch, SingleGoal) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    Cell start = {50, 50}, goal = {92, 50};
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    std::vector<Cell> expected = flowFieldPath(field, start);
+    MultiGoalResult result = multiGoalSearch(graph, start, {goal});
+    ASSERT_FALSE(result.path.empty());
+    ASSERT_EQ(result.goal_index, 0);
+    ASSERT_NEAR(result.cost, octilePathCost(expected), 1e-3);
+}
+
+TEST(AnyAngle, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    computeCSpace(graph);
+    testAnyAngle(graph, {50, 50});
+}
+
+TEST(AnyAngle, GeneratedObstacles) {
+    GridGraph graph;
+    generateRandomObstacleMap(301, 257, 0.05, 3, graph);
+    computeCSpace(graph);
+    testAnyAngle(graph, nearestFreeCell(graph, graph.width * graph.height / 2, 1));
+}
+
+TEST(StateLattice, Primitives) {
+    StateLattice lattice;
+    buildStateLattice(lattice);
+    testLatticePrimitives(lattice);
+}
+
+TEST(StateLattice, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    computeCSpace(graph);
+    StateLattice lattice;
+    buildStateLattice(lattice);
+    testLatticeSearch(graph, lattice, {50, 50});
+}
+
+TEST(StateLattice, GeneratedRooms) {
+    GridGraph graph;
+    generateRoomsMap(192, 192, 8, 10, 5, graph);
+    computeCSpace(graph);
+    StateLattice lattice;
+    buildStateLattice(lattice);
+    testLatticeSearch(graph, lattice, nearestFreeCell(graph, graph.width * graph.height - 1, -1));
+}
+
+TEST(StateLattice, CellsToPosesHeadings) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/empty_map.map", graph));
+    std::vector<Cell> path = {{5, 5}, {6, 5}, {7, 6}, {7, 7}};
+    auto poses = cellsToPoses(path, graph);
+    ASSERT_EQ(poses.size(), path.size());
+    ASSERT_NEAR(poses[0][2], 0, 1e-6);
+    ASSERT_NEAR(poses[1][2], M_PI / 4, 1e-6);
+    ASSERT_NEAR(poses[2][2], M_PI / 2, 1e-6);
+    ASSERT_NEAR(poses[3][2], M_PI / 2, 1e-6);
+}
+
+TEST(ParallelAStar, Maze) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    computeCSpace(graph);
+    testParallelAStar(graph, {50, 50}, {1, 2, 4});
+}
+
+TEST(ParallelAStar, GeneratedObstacles) {
+    GridGraph graph;
+    generateRandomObstacleMap(301, 257, 0.1, 3, graph);
+    computeCSpace(graph);
+    testParallelAStar(graph, nearestFreeCell(graph, graph.width * graph.height / 2, 1), {1, 3, 8});
+}
+
+TEST(PathCache, HitsSubpathsAndEdits) {
+    testPathCache("../data/narrow.map", {100, 30}, {100, 170});
+}
+
+TEST(PathCache, MemoryCap) {
+    GridGraph graph;
+    generateRandomObstacleMap(128, 128, 0.05, 4, graph);
+    computeCSpace(graph);
+    std::vector<Cell> goals;
+    for (int idx = 0; idx < graph.width * graph.height && goals.size() < 6; idx += 2749) {
+        if (!graph.cspace[idx]) goals.push_back(idxToCell(idx, graph));
+    }
+    testPathCacheMemoryCap(graph, goals);
+}
+
+TEST(PlanFile, Sections) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile("../data/maze2.map", graph));
+    distanceTransformEuclidean2D(graph);
+    testPlanFile(graph, {50, 50}, {92, 50});
+}
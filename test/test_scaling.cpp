@@ -0,0 +1,162 @@
+#include <cmath>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/graph_search/graph_search.h>
+
+// Map sizes in the sweep. Each planner is timed on a random obstacle map of each size.
+static const std::vector<int> kSweepSizes = {64, 128, 256, 512};
+static const float kSweepDensity = 0.1;
+static const int kRepeats = 5;
+
+// Maximum allowed growth exponent of the time per cell, i.e. time per cell
+// must grow slower than N^exponent for N cells. Linear time planners sit near
+// 0, and log factors and timer noise stay well under the default. Can be
+// overridden with the PLANNER_SCALING_MAX_EXPONENT environment variable.
+static const double kDefaultMaxExponent = 0.5;
+
+using SearchFn = std::vector<Cell> (*)(GridGraph&, const Cell&, const Cell&);
+
+/**
+ * Gets the maximum allowed time per cell growth exponent.
+ */
+double maxExponent() {
+    const char* env = std::getenv("PLANNER_SCALING_MAX_EXPONENT");
+    return env ? std::atof(env) : kDefaultMaxExponent;
+}
+
+/**
+ * Finds the first collision free cell scanning from the start or the end of the map.
+ */
+Cell firstFreeCell(const GridGraph& graph, bool from_end) {
+    int num_cells = graph.width * graph.height;
+    for (int k = 0; k < num_cells; ++k) {
+        int idx = from_end ? num_cells - 1 - k : k;
+        if (!checkCollision(idx, graph)) return idxToCell(idx, graph);
+    }
+    return {-1, -1};
+}
+
+/**
+ * Times a search between opposite corners of the graph, taking the fastest of
+ * a few repeats to reduce noise.
+ * @return  The time taken in seconds.
+ */
+double timeSearch(SearchFn search, GridGraph& graph) {
+    Cell start = firstFreeCell(graph, false);
+    Cell goal = firstFreeCell(graph, true);
+    double best = INFINITY;
+    for (int r = 0; r < kRepeats; ++r) {
+        graph.visited_cells.clear();
+        auto t0 = std::chrono::steady_clock::now();
+        search(graph, start, goal);
+        auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(t1 - t0).count());
+    }
+    return best;
+}
+
+/**
+ * Fits time = c * cells^k by least squares in log space.
+ * @return  The exponent k.
+ */
+double fitExponent(const std::vector<double>& cells, const std::vector<double>& times) {
+    double n = cells.size(), sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t k = 0; k < cells.size(); ++k) {
+        double x = std::log(cells[k]), y = std::log(times[k]);
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+/**
+ * Runs a planner over the size sweep and asserts that the time per cell does
+ * not grow faster than the allowed exponent.
+ */
+void testScaling(const std::string& name, SearchFn search) {
+    std::vector<double> cells, times;
+    for (int size : kSweepSizes) {
+        GridGraph graph;
+        generateRandomObstacleMap(size, size, kSweepDensity, 0, graph);
+        double t = timeSearch(search, graph);
+        cells.push_back(static_cast<double>(size) * size);
+        times.push_back(std::max(t, 1e-7));
+        std::cout << name << " " << size << "x" << size << ": " << t * 1e3 << " ms, "
+                  << t * 1e9 / cells.back() << " ns/cell\n";
+    }
+
+    double per_cell_exponent = fitExponent(cells, times) - 1;
+    std::cout << name << " time per cell grows as N^" << per_cell_exponent << std::endl;
+    EXPECT_LE(per_cell_exponent, maxExponent()) << name << " scales worse than expected.";
+}
+
+TEST(Scaling, BreadthFirstSearch) {
+    testScaling("breadthFirstSearch", breadthFirstSearch);
+}
+
+TEST(Scaling, DepthFirstSearch) {
+    testScaling("depthFirstSearch", depthFirstSearch);
+}
+
+TEST(Scaling, AStarSearch) {
+    testScaling("aStarSearch", aStarSearch);
+}
+
+TEST(MapGenerator, SameSeedSameMap) {
+    for (std::string type : {"random", "maze", "rooms", "narrow"}) {
+        GridGraph a, b;
+        float param = type == "random" ? 0.2 : type == "rooms" ? 6 : 10;
+        ASSERT_TRUE(generateMap(type, 120, 90, param, 7, a));
+        ASSERT_TRUE(generateMap(type, 120, 90, param, 7, b));
+        ASSERT_TRUE(isLoaded(a));
+        EXPECT_EQ(a.cell_odds, b.cell_odds) << type;
+    }
+}
+
+TEST(MapGenerator, MazeIsConnected) {
+    // Every free cell of a recursive division maze is reachable from every other.
+    GridGraph graph;
+    generateMazeMap(101, 101, 9, 3, graph);
+    int num_cells = graph.width * graph.height;
+    int start = -1, num_free = 0;
+    for (int idx = 0; idx < num_cells; ++idx) {
+        if (!isIdxOccupied(idx, graph)) {
+            if (start < 0) start = idx;
+            ++num_free;
+        }
+    }
+    ASSERT_GE(start, 0);
+
+    std::vector<bool> seen(num_cells, false);
+    std::vector<int> stack = {start};
+    seen[start] = true;
+    int num_seen = 0;
+    while (!stack.empty()) {
+        int current = stack.back();
+        stack.pop_back();
+        ++num_seen;
+        Cell c = idxToCell(current, graph);
+        const int steps[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+        for (const auto& step : steps) {
+            int ni = c.i + step[0], nj = c.j + step[1];
+            if (!isCellInBounds(ni, nj, graph) || isCellOccupied(ni, nj, graph)) continue;
+            int n = cellToIdx(ni, nj, graph);
+            if (!seen[n]) {
+                seen[n] = true;
+                stack.push_back(n);
+            }
+        }
+    }
+    EXPECT_EQ(num_seen, num_free);
+}
@@ -1,10 +1,39 @@
+#include <cmath>
+#include <queue>
+#include <limits>
+#include <random>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <iostream>
+#include <algorithm>
 
 #include <gtest/gtest.h>
 
 #include <planning.h>
+#include <contraction_hierarchy.h>
+#include <alt_landmarks.h>
+#include <distance_table.h>
 #include <path_planning/utils/graph_utils.h>
+#include <path_planning/utils/map_binary.h>
+#include <path_planning/utils/tiled_grid.h>
+#include <path_planning/utils/map_generator.h>
+#include <path_planning/utils/viz_utils.h>
 #include <path_planning/graph_search/graph_search.h>
+#include <path_planning/graph_search/distance_transform.h>
+#include <path_planning/graph_search/wavefront.h>
+#include <path_planning/graph_search/flow_field.h>
+#include <path_planning/graph_search/hpa_star.h>
+#include <path_planning/graph_search/path_database.h>
+#include <path_planning/graph_search/map_pyramid.h>
+#include <path_planning/graph_search/quadtree.h>
+#include <path_planning/graph_search/bounded_search.h>
+#include <path_planning/graph_search/multi_goal_search.h>
+#include <path_planning/graph_search/any_angle.h>
+#include <path_planning/graph_search/state_lattice.h>
+#include <path_planning/graph_search/parallel_astar.h>
+#include <path_planning/graph_search/path_cache.h>
 
 /**
  * Runs BFS on a graph and asserts that the path goes from start to goal and contains all valid edges.
@@ -14,8 +43,8 @@
  */
 void testMichiganBfs(std::string start_name, std::string goal_name, std::string graph_file) {
     Graph graph = createGraph(graph_file);
-    int start_index = nameToIdx(start_name, graph.data);
-    int goal_index = nameToIdx(goal_name, graph.data);
+    int start_index = nameToIdx(start_name, graph);
+    int goal_index = nameToIdx(goal_name, graph);
     std::vector<int> path = bfs(start_index, goal_index, graph);
     
     // Check size, start, and goal.
@@ -84,3 +113,1691 @@ void testGridGraphBreadthFirstSearch(const std::vector<int> correct_i, const std
         ASSERT_EQ(path[i].j, correct_path[i].j);
     }
 }
+
+/**
+ * Loads a map file and asserts that mapAsString() matches the original
+ * formatting of every field with an std::ostringstream, and that the map
+ * survives a round trip through saveToFile().
+ * @param  map_file The map file to load into a graph.
+ */
+void testMapRoundTrip(const std::string &map_file) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    ASSERT_TRUE(isLoaded(graph));
+
+    std::ostringstream expected;
+    expected << graph.origin_x << " " << graph.origin_y << " ";
+    expected << graph.width << " " << graph.height << " " << graph.meters_per_cell << " ";
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        expected << +graph.cell_odds[idx] << " ";
+    }
+    ASSERT_EQ(mapAsString(graph), expected.str());
+
+    std::string out_file = "round_trip.map";
+    ASSERT_TRUE(saveToFile(out_file, graph));
+    GridGraph reloaded;
+    ASSERT_TRUE(loadFromFile(out_file, reloaded));
+    std::remove(out_file.c_str());
+    ASSERT_EQ(reloaded.width, graph.width);
+    ASSERT_EQ(reloaded.height, graph.height);
+    ASSERT_EQ(reloaded.origin_x, graph.origin_x);
+    ASSERT_EQ(reloaded.meters_per_cell, graph.meters_per_cell);
+    ASSERT_EQ(reloaded.cell_odds, graph.cell_odds);
+}
+
+/**
+ * Loads a map file, saves it as a binary map with its distance transform and
+ * C-space, and asserts that the binary map loads in place with the same data.
+ * @param  map_file The map file to load into a graph.
+ */
+void testBinaryMapRoundTrip(const std::string &map_file) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    distanceTransformEuclidean2D(graph);
+    computeCSpace(graph);
+
+    std::string out_file = "round_trip.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph, true, true));
+    ASSERT_TRUE(isBinaryMapFile(out_file));
+
+    GridGraph loaded;
+    ASSERT_TRUE(loadFromFile(out_file, loaded));
+    ASSERT_TRUE(loadFromBinaryFile(out_file, loaded, true));
+    std::remove(out_file.c_str());
+
+    // The file stays mapped until the graph releases it.
+    ASSERT_TRUE(loaded.cell_odds.isExternal());
+    ASSERT_TRUE(loaded.obstacle_distances.isExternal());
+    ASSERT_EQ(loaded.width, graph.width);
+    ASSERT_EQ(loaded.height, graph.height);
+    ASSERT_EQ(loaded.origin_x, graph.origin_x);
+    ASSERT_EQ(loaded.collision_radius, graph.collision_radius);
+    ASSERT_EQ(loaded.cell_odds, graph.cell_odds);
+    ASSERT_EQ(loaded.obstacle_distances, graph.obstacle_distances);
+    ASSERT_EQ(loaded.cspace, graph.cspace);
+    ASSERT_TRUE(loaded.occupancy_bits.words.isExternal());
+    ASSERT_EQ(loaded.occupancy_bits.words, graph.occupancy_bits.words);
+
+    // Copies own their data, so writes do not leak between graphs.
+    GridGraph copy = loaded;
+    ASSERT_FALSE(copy.cell_odds.isExternal());
+    copy.cell_odds[0] = copy.cell_odds[0] == 127 ? -128 : 127;
+    ASSERT_NE(copy.cell_odds[0], loaded.cell_odds[0]);
+}
+
+/**
+ * Saves a map as a binary map, flips one byte of the cell data, and asserts
+ * that loading with checksum verification fails.
+ * @param  map_file The map file to load into a graph.
+ */
+void testBinaryMapCorruption(const std::string &map_file) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    std::string out_file = "corrupt.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph));
+
+    {
+        std::fstream file(out_file, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(sizeof(BinaryMapHeader) + 10);
+        file.put(42);
+    }
+
+    GridGraph loaded;
+    EXPECT_TRUE(loadFromBinaryFile(out_file, loaded, false));
+    EXPECT_FALSE(loadFromBinaryFile(out_file, loaded, true));
+    std::remove(out_file.c_str());
+}
+
+/**
+ * Saves a map as a binary map, runs the tiled distance transform over it with
+ * a tile cache much smaller than the map, and asserts that the distances match
+ * the brute force transform.
+ * @param  map_file The map file to load into a graph.
+ * @param  tile_size The tile size to use.
+ */
+void testTiledDistanceTransform(const std::string &map_file, int tile_size) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    std::string out_file = "tiled_dt.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph));
+    ASSERT_TRUE(addBinaryMapDistanceLayer(out_file));
+
+    {
+        TiledGridGraph tiled;
+        ASSERT_TRUE(tiled.open(out_file, tile_size, 0, true));
+        int max_distance = graph.width + graph.height;
+        ASSERT_TRUE(distanceTransformEuclidean2D(tiled, max_distance));
+        ASSERT_LE(tiled.residentBytes(), tiled.maxResidentBytes());
+        ASSERT_GT(tiled.stats().misses, 0);
+        ASSERT_GT(tiled.stats().evictions, 0);
+    }
+
+    GridGraph loaded;
+    ASSERT_TRUE(loadFromBinaryFile(out_file, loaded, true));
+    std::remove(out_file.c_str());
+
+    distanceTransformSlow(graph);
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        ASSERT_NEAR(loaded.obstacle_distances[idx], graph.obstacle_distances[idx], 1e-3) << "at index " << idx;
+    }
+}
+
+/**
+ * Runs A* over a tiled graph with a small tile cache and asserts that the path
+ * goes from start to goal through adjacent, collision free cells.
+ * @param  map_file The map file to load into a graph.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ */
+void testTiledAStar(const std::string &map_file, const Cell &start, const Cell &goal) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    std::string out_file = "tiled_astar.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph));
+
+    TiledGridGraph tiled;
+    ASSERT_TRUE(tiled.open(out_file, 16, 0));
+    int64_t num_expanded = 0;
+    std::vector<Cell> path = aStarSearch(tiled, start, goal, &num_expanded);
+    std::remove(out_file.c_str());
+
+    ASSERT_GE(path.size(), 2);
+    ASSERT_GT(num_expanded, 0);
+    ASSERT_GT(tiled.stats().hits, tiled.stats().misses);
+    ASSERT_LE(tiled.residentBytes(), tiled.maxResidentBytes());
+    ASSERT_EQ(path.front().i, start.i);
+    ASSERT_EQ(path.front().j, start.j);
+    ASSERT_EQ(path.back().i, goal.i);
+    ASSERT_EQ(path.back().j, goal.j);
+    for (size_t k = 1; k < path.size(); ++k) {
+        ASSERT_LE(std::abs(path[k].i - path[k - 1].i), 1);
+        ASSERT_LE(std::abs(path[k].j - path[k - 1].j), 1);
+        ASSERT_FALSE(checkCollision(cellToIdx(path[k].i, path[k].j, graph), graph));
+    }
+}
+
+/**
+ * Checks whether the segment between the centers of two cells touches the
+ * closed square of cell (i, j), by testing the corners of the square against
+ * the line in half cell units.
+ */
+bool segmentTouchesCell(int i0, int j0, int i1, int j1, int i, int j) {
+    if (i < std::min(i0, i1) - 1 || i > std::max(i0, i1) + 1) return false;
+    if (j < std::min(j0, j1) - 1 || j > std::max(j0, j1) + 1) return false;
+    long x0 = 2 * i0 + 1, y0 = 2 * j0 + 1, dx = 2 * (i1 - i0), dy = 2 * (j1 - j0);
+    int num_positive = 0, num_negative = 0;
+    for (int corner = 0; corner < 4; ++corner) {
+        long x = 2 * i + 2 * (corner & 1), y = 2 * j + (corner & 2);
+        long cross = dx * (y - y0) - dy * (x - x0);
+        num_positive += cross > 0;
+        num_negative += cross < 0;
+    }
+    // The square must also overlap the segment's extent, not just its line.
+    bool overlaps = 2 * i <= std::max(x0, x0 + dx) && 2 * i + 2 >= std::min(x0, x0 + dx) &&
+                    2 * j <= std::max(y0, y0 + dy) && 2 * j + 2 >= std::min(y0, y0 + dy);
+    return overlaps && num_positive < 4 && num_negative < 4;
+}
+
+/**
+ * Asserts that the occupancy bits of a map match the cell odds, and that the
+ * word at a time row, count and line of sight queries match cell by cell
+ * reference versions.
+ * @param  map_file The map file to load into a graph.
+ */
+void testOccupancyBits(const std::string &map_file) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    const OccupancyBits& bits = graph.occupancy_bits;
+    ASSERT_EQ(bits.width, graph.width);
+    ASSERT_EQ(bits.height, graph.height);
+    for (int j = 0; j < graph.height; ++j) {
+        for (int i = 0; i < graph.width; ++i) {
+            ASSERT_EQ(testBit(bits, i, j), graph.cell_odds[cellToIdx(i, j, graph)] >= graph.threshold);
+        }
+    }
+    ASSERT_TRUE(testBit(bits, -1, 0));
+    ASSERT_TRUE(testBit(bits, graph.width, 0));
+
+    std::srand(7);
+    for (int trial = 0; trial < 200; ++trial) {
+        int i = std::rand() % (graph.width + 80) - 40, j = std::rand() % graph.height;
+        uint64_t word = rowWord(bits, i, j);
+        for (int k = 0; k < 64; ++k) {
+            ASSERT_EQ((word >> k) & 1, testBit(bits, i + k, j)) << "at " << i + k << ", " << j;
+        }
+
+        int i0 = std::rand() % graph.width, i1 = std::rand() % graph.width;
+        int j0 = std::rand() % graph.height, j1 = std::rand() % graph.height;
+        if (i0 > i1) std::swap(i0, i1);
+        if (j0 > j1) std::swap(j0, j1);
+        int64_t count = 0;
+        for (int jj = j0; jj <= j1; ++jj) {
+            for (int ii = i0; ii <= i1; ++ii) count += testBit(bits, ii, jj);
+        }
+        ASSERT_EQ(countSetBits(bits, i0, j0, i1, j1), count);
+        ASSERT_EQ(isRectClear(bits, i0, j0, i1, j1), count == 0);
+    }
+
+    // Short segments, so that some of them have line of sight.
+    for (int trial = 0; trial < 2000; ++trial) {
+        int i0 = std::rand() % graph.width, j0 = std::rand() % graph.height;
+        int i1 = std::min(std::max(i0 + std::rand() % 41 - 20, 0), graph.width - 1);
+        int j1 = std::min(std::max(j0 + std::rand() % 41 - 20, 0), graph.height - 1);
+        bool expected = true;
+        for (int j = std::min(j0, j1) - 1; j <= std::max(j0, j1) + 1; ++j) {
+            for (int i = std::min(i0, i1) - 1; i <= std::max(i0, i1) + 1; ++i) {
+                if (segmentTouchesCell(i0, j0, i1, j1, i, j) && testBit(bits, i, j)) expected = false;
+            }
+        }
+        ASSERT_EQ(lineOfSight(bits, i0, j0, i1, j1), expected)
+            << "from " << i0 << ", " << j0 << " to " << i1 << ", " << j1;
+        ASSERT_EQ(lineOfSight(bits, i1, j1, i0, j0), expected);
+    }
+}
+
+/**
+ * Computes hop distances with a plain queue based breadth first search over
+ * the cells that are not in collision, for reference.
+ */
+std::vector<int> referenceHopDistances(GridGraph &graph, const Cell &start) {
+    std::vector<int> hops(graph.width * graph.height, -1);
+    std::queue<int> visit_queue;
+    int start_idx = cellToIdx(start.i, start.j, graph);
+    hops[start_idx] = 0;
+    visit_queue.push(start_idx);
+    while (!visit_queue.empty()) {
+        int current = visit_queue.front();
+        visit_queue.pop();
+        for (int neighbor : findNeighbors(current, graph)) {
+            if (hops[neighbor] < 0 && !checkCollision(neighbor, graph)) {
+                hops[neighbor] = hops[current] + 1;
+                visit_queue.push(neighbor);
+            }
+        }
+    }
+    return hops;
+}
+
+/**
+ * Calls fn(start) for about num_samples cells spread evenly over a graph,
+ * stopping at the first fatal failure.
+ * @param  graph The graph to sample.
+ * @param  num_samples The number of cells to sample.
+ * @param  fn The function to call with each cell.
+ * @param  skip_blocked Whether to skip cells in the C-space.
+ */
+template <typename Fn>
+void forEachSampledStart(const GridGraph &graph, int num_samples, Fn fn, bool skip_blocked = true) {
+    int num_cells = graph.width * graph.height;
+    int stride = num_cells / num_samples + 1;
+    for (int idx = 0; idx < num_cells; idx += stride) {
+        if (skip_blocked && graph.cspace[idx]) continue;
+        fn(idxToCell(idx, graph));
+        if (::testing::Test::HasFatalFailure()) return;
+    }
+}
+
+/**
+ * Finds the first cell not in the C-space scanning from an index in steps of
+ * step, for picking a free goal on a generated map.
+ * @param  graph The graph to search, with the C-space computed.
+ * @param  idx The index to start scanning from.
+ * @param  step The index step, 1 to scan forwards and -1 backwards.
+ * @return  The free cell, or {-1, -1}, failing the test, if there is none.
+ */
+Cell nearestFreeCell(const GridGraph &graph, int idx, int step) {
+    int num_cells = graph.width * graph.height;
+    for (; idx >= 0 && idx < num_cells; idx += step) {
+        if (!graph.cspace[idx]) return idxToCell(idx, graph);
+    }
+    ADD_FAILURE() << "No free cell found.";
+    return {-1, -1};
+}
+
+/**
+ * Runs the bit-parallel wavefront from a start cell and asserts that the hop
+ * distances match a queue based search, that the reachable set matches, and
+ * that breadthFirstSearch() finds a path to exactly the reachable goals.
+ * @param  graph The graph to search over.
+ * @param  start The start cell.
+ */
+void testWavefront(GridGraph &graph, const Cell &start) {
+    std::vector<int> hops = wavefrontHopDistances(graph, start);
+    std::vector<int> expected = referenceHopDistances(graph, start);
+    ASSERT_EQ(hops, expected);
+
+    OccupancyBits reached = wavefrontReachable(graph, start);
+    int max_hops = *std::max_element(hops.begin(), hops.end());
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        Cell c = idxToCell(idx, graph);
+        ASSERT_EQ((reached.words[c.j * reached.words_per_row + c.i / 64] >> (c.i % 64)) & 1, hops[idx] >= 0);
+    }
+
+    // Stopping early only keeps the cells within the limit.
+    std::vector<int> limited = wavefrontHopDistances(graph, start, max_hops / 2);
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        ASSERT_EQ(limited[idx], hops[idx] <= max_hops / 2 ? hops[idx] : -1);
+    }
+
+    // Breadth first search is slow, so only about 50 goals are checked.
+    forEachSampledStart(graph, 50, [&](const Cell &goal) {
+        int idx = cellToIdx(goal.i, goal.j, graph);
+        std::vector<Cell> path = breadthFirstSearch(graph, start, goal);
+        ASSERT_EQ(path.empty(), hops[idx] < 0) << "at " << goal.i << ", " << goal.j;
+        if (!path.empty()) {
+            ASSERT_GE(static_cast<int>(path.size()) - 1, hops[idx]);
+        }
+    }, false);
+}
+
+/**
+ * Computes the octile cost of a path, asserting that every step moves to an
+ * adjacent cell.
+ */
+float octilePathCost(const std::vector<Cell> &path) {
+    float cost = 0;
+    for (size_t k = 1; k < path.size(); ++k) {
+        int di = std::abs(path[k].i - path[k - 1].i), dj = std::abs(path[k].j - path[k - 1].j);
+        EXPECT_TRUE(di <= 1 && dj <= 1 && di + dj > 0);
+        cost += di + dj == 2 ? std::sqrt(2.0f) : 1.0f;
+    }
+    return cost;
+}
+
+/**
+ * Computes a flow field to a goal and asserts that, from a spread of starts,
+ * following it gives a collision free path exactly when the goal is reachable,
+ * with the same cost as the tiled A* search.
+ * @param  map_file The map file to load into a graph.
+ * @param  goal The goal cell.
+ */
+void testFlowField(const std::string &map_file, const Cell &goal) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    computeCSpace(graph);
+    std::string out_file = "flow_field.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph, false, true));
+    TiledGridGraph tiled;
+    ASSERT_TRUE(tiled.open(out_file, 64));
+    std::remove(out_file.c_str());
+
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    std::vector<int> hops = wavefrontHopDistances(graph, goal);
+
+    int num_paths = 0;
+    forEachSampledStart(graph, 200, [&](const Cell &start) {
+        int idx = cellToIdx(start.i, start.j, graph);
+        std::vector<Cell> path = flowFieldPath(field, start);
+        if (graph.cspace[idx] || hops[idx] < 0) {
+            ASSERT_TRUE(path.empty()) << "at " << start.i << ", " << start.j;
+            return;
+        }
+        ASSERT_FALSE(path.empty()) << "at " << start.i << ", " << start.j;
+        ASSERT_EQ(path.front().i, start.i);
+        ASSERT_EQ(path.front().j, start.j);
+        ASSERT_EQ(path.back().i, goal.i);
+        ASSERT_EQ(path.back().j, goal.j);
+        for (size_t k = 0; k + 1 < path.size(); ++k) {
+            ASSERT_FALSE(graph.cspace[cellToIdx(path[k].i, path[k].j, graph)]);
+        }
+        std::vector<Cell> expected = aStarSearch(tiled, start, goal);
+        ASSERT_NEAR(octilePathCost(path), octilePathCost(expected), 1e-3);
+        ++num_paths;
+    }, false);
+    ASSERT_GT(num_paths, 20);
+}
+
+/**
+ * Asserts that a flow field cache reuses fields per goal, and that editing
+ * the map drops them so new paths avoid the edit.
+ * @param  map_file The map file to load into a graph.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ */
+void testFlowFieldCache(const std::string &map_file, const Cell &start, const Cell &goal) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    FlowFieldCache cache(2);
+
+    std::vector<Cell> path = cache.findPath(graph, start, goal);
+    ASSERT_GE(path.size(), 3);
+    ASSERT_EQ(cache.findPath(graph, start, goal).size(), path.size());
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.hits(), 1);
+
+    // Other goals push out the least recently used field.
+    cache.getField(graph, path[1]);
+    cache.getField(graph, path[2]);
+    ASSERT_EQ(cache.size(), 2);
+    cache.findPath(graph, start, goal);
+    ASSERT_EQ(cache.misses(), 4);
+
+    // Blocking the middle of the path changes the map version and the C-space.
+    Cell blocked = path[path.size() / 2];
+    uint64_t version = graph.map_version;
+    setCellOdds(cellToIdx(blocked.i, blocked.j, graph), 127, graph);
+    ASSERT_NE(graph.map_version, version);
+    ASSERT_TRUE(isCellOccupied(blocked.i, blocked.j, graph));
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        ASSERT_EQ(graph.cspace[idx], checkCollision(idx, graph)) << "at index " << idx;
+    }
+
+    std::vector<Cell> new_path = cache.findPath(graph, start, goal);
+    ASSERT_EQ(cache.misses(), 5);
+    ASSERT_EQ(cache.size(), 1);
+    for (const Cell &c : new_path) {
+        ASSERT_FALSE(c.i == blocked.i && c.j == blocked.j);
+    }
+}
+
+/**
+ * Builds the HPA* abstraction of a graph and asserts that, from a spread of
+ * starts to one goal, it finds a collision free path exactly when the goal is
+ * reachable, with a cost close to the optimal cost from a flow field.
+ * @param  graph The graph to search over.
+ * @param  goal The goal cell.
+ * @param  cluster_size The cluster size to use.
+ */
+void testHierarchicalSearch(GridGraph &graph, const Cell &goal, int cluster_size) {
+    HierarchicalGraph hpa;
+    buildHierarchicalGraph(graph, cluster_size, hpa);
+    ASSERT_GT(hpa.node_cells.size(), 0);
+    ASSERT_EQ(hpa.map_version, graph.map_version);
+
+    FlowField field;
+    computeFlowField(graph, goal, field);
+
+    int num_paths = 0;
+    Cell reachable = goal;
+    forEachSampledStart(graph, 300, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+        HpaSearchStats stats;
+        std::vector<Cell> path = hierarchicalSearch(graph, hpa, start, goal, &stats);
+        ASSERT_EQ(path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+        if (path.empty()) return;
+
+        ASSERT_EQ(path.front().i, start.i);
+        ASSERT_EQ(path.front().j, start.j);
+        ASSERT_EQ(path.back().i, goal.i);
+        ASSERT_EQ(path.back().j, goal.j);
+        for (const Cell &c : path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+        float cost = octilePathCost(path), optimal = octilePathCost(expected);
+        ASSERT_GE(cost, optimal - 1e-3);
+        ASSERT_LE(cost, 1.2 * optimal + 2) << "at " << start.i << ", " << start.j;
+        reachable = start;
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 20);
+
+    // A graph built for an older map is rejected until it is rebuilt.
+    markMapChanged(graph);
+    ASSERT_TRUE(hierarchicalSearch(graph, hpa, reachable, goal).empty());
+    buildHierarchicalGraph(graph, cluster_size, hpa);
+    ASSERT_FALSE(hierarchicalSearch(graph, hpa, reachable, goal).empty());
+}
+
+/**
+ * Builds a path database for a map and asserts that, for a spread of goals,
+ * it gives a collision free path from a spread of starts exactly when the
+ * goal is reachable, with the same cost as the flow field to the goal. Then
+ * saves it with the map and asserts that it loads back the same, and is only
+ * accepted for the map it was built from.
+ * @param  map_file The map file to load into a graph.
+ */
+void testPathDatabase(const std::string &map_file) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    computeCSpace(graph);
+    PathDatabase db;
+    buildPathDatabase(graph, db, 2);
+    ASSERT_TRUE(isPathDatabaseFor(db, graph));
+    ASSERT_GT(db.rank_cells.size(), 0);
+    // Runs compress the table well below one entry per pair of cells.
+    ASSERT_LT(db.runs.size(), db.rank_cells.size() * db.rank_cells.size() / 10);
+
+    int num_cells = graph.width * graph.height;
+    int num_paths = 0;
+    for (int goal_idx = num_cells / 7; goal_idx < num_cells; goal_idx += num_cells / 7) {
+        // Only free cells are in the database.
+        if (graph.cspace[goal_idx]) continue;
+        Cell goal = idxToCell(goal_idx, graph);
+        FlowField field;
+        computeFlowField(graph, goal, field);
+        forEachSampledStart(graph, 100, [&](const Cell &start) {
+            std::vector<Cell> path = pathDatabasePath(db, start, goal);
+            std::vector<Cell> expected = flowFieldPath(field, start);
+            ASSERT_EQ(path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+            if (path.empty()) return;
+
+            ASSERT_EQ(path.front().i, start.i);
+            ASSERT_EQ(path.front().j, start.j);
+            ASSERT_EQ(path.back().i, goal.i);
+            ASSERT_EQ(path.back().j, goal.j);
+            for (const Cell &c : path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+            ASSERT_NEAR(octilePathCost(path), octilePathCost(expected), 1e-3);
+            ++num_paths;
+        }, false);
+    }
+    ASSERT_GT(num_paths, 50);
+
+    std::string out_file = "path_database.bin";
+    ASSERT_TRUE(saveToBinaryFile(out_file, graph));
+    ASSERT_TRUE(savePathDatabase(out_file, db));
+    PathDatabase loaded;
+    ASSERT_TRUE(loadPathDatabase(out_file, loaded, true));
+    GridGraph loaded_graph;
+    ASSERT_TRUE(loadFromFile(out_file, loaded_graph));
+    std::remove(out_file.c_str());
+
+    ASSERT_TRUE(loaded.runs.isExternal());
+    ASSERT_TRUE(isPathDatabaseFor(loaded, loaded_graph));
+    ASSERT_EQ(loaded.ranks, db.ranks);
+    ASSERT_EQ(loaded.rank_cells, db.rank_cells);
+    ASSERT_EQ(loaded.run_offsets, db.run_offsets);
+    ASSERT_EQ(loaded.runs, db.runs);
+
+    // Any change to the map or collision radius invalidates the database.
+    setCellOdds(db.rank_cells[0], 127, graph);
+    ASSERT_FALSE(isPathDatabaseFor(db, graph));
+    loaded_graph.collision_radius *= 2;
+    ASSERT_FALSE(isPathDatabaseFor(loaded, loaded_graph));
+}
+
+/**
+ * Builds the pyramid of a map and asserts that each coarse cell is blocked
+ * exactly when a cell it covers is. Then asserts that, from a spread of starts
+ * to one goal, the pyramid search finds a collision free path exactly when
+ * the goal is reachable, mostly within corridors, and that editing the map
+ * rebuilds the pyramid.
+ * @param  graph The graph to search over.
+ * @param  goal The goal cell.
+ */
+void testMapPyramid(GridGraph &graph, const Cell &goal) {
+    MapPyramid pyramid;
+    buildMapPyramid(graph, pyramid);
+    ASSERT_EQ(pyramid.levels.size(), PYRAMID_DEFAULT_LEVELS + 1);
+    for (size_t level = 1; level < pyramid.levels.size(); ++level) {
+        const OccupancyBits &fine = pyramid.levels[level - 1], &coarse = pyramid.levels[level];
+        ASSERT_EQ(coarse.width, (fine.width + 1) / 2);
+        ASSERT_EQ(coarse.height, (fine.height + 1) / 2);
+        for (int j = 0; j < coarse.height; ++j) {
+            for (int i = 0; i < coarse.width; ++i) {
+                bool any_blocked = false;
+                for (int k = 0; k < 4; ++k) {
+                    int fi = 2 * i + k % 2, fj = 2 * j + k / 2;
+                    if (fi < fine.width && fj < fine.height) any_blocked |= testBit(fine, fi, fj);
+                }
+                ASSERT_EQ(testBit(coarse, i, j), any_blocked) << "at level " << level << ", " << i << ", " << j;
+            }
+        }
+    }
+
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0, num_corridor_paths = 0;
+    forEachSampledStart(graph, 200, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+        PyramidSearchStats stats;
+        std::vector<Cell> path = pyramidSearch(graph, pyramid, start, goal, &stats);
+        ASSERT_EQ(path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+        if (path.empty()) return;
+
+        ASSERT_EQ(path.front().i, start.i);
+        ASSERT_EQ(path.front().j, start.j);
+        ASSERT_EQ(path.back().i, goal.i);
+        ASSERT_EQ(path.back().j, goal.j);
+        for (const Cell &c : path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+        ASSERT_GE(octilePathCost(path), octilePathCost(expected) - 1e-3);
+        ++num_paths;
+        if (stats.coarse_level > 0 && !stats.fallback) ++num_corridor_paths;
+    });
+    ASSERT_GT(num_paths, 20);
+    ASSERT_GT(num_corridor_paths, num_paths / 2);
+
+    // Blocking a cell of a path rebuilds the pyramid before the next search.
+    Cell start = idxToCell(0, graph);
+    while (graph.cspace[cellToIdx(start.i, start.j, graph)] || flowFieldPath(field, start).size() < 3) {
+        start = idxToCell(cellToIdx(start.i, start.j, graph) + 1, graph);
+    }
+    std::vector<Cell> path = pyramidSearch(graph, pyramid, start, goal);
+    Cell blocked = path[path.size() / 2];
+    setCellOdds(cellToIdx(blocked.i, blocked.j, graph), 127, graph);
+    for (const Cell &c : pyramidSearch(graph, pyramid, start, goal)) {
+        ASSERT_FALSE(c.i == blocked.i && c.j == blocked.j);
+    }
+    ASSERT_EQ(pyramid.map_version, graph.map_version);
+}
+
+/**
+ * Builds the quadtree of a map and asserts that its leaves are free and
+ * cover every free cell once. Then asserts that, from a spread of starts to
+ * one goal, the quadtree search finds a collision free path exactly when the
+ * goal is reachable, with a cost close to the optimal cost from a flow field.
+ * @param  graph The graph to search over.
+ * @param  goal The goal cell.
+ */
+void testQuadtree(GridGraph &graph, const Cell &goal) {
+    QuadtreeMap quadtree;
+    buildQuadtree(graph, quadtree);
+    ASSERT_EQ(quadtree.map_version, graph.map_version);
+    for (int idx = 0; idx < graph.width * graph.height; ++idx) {
+        int leaf = quadtree.leaf_of_cell[idx];
+        ASSERT_EQ(leaf < 0, graph.cspace[idx] != 0) << "at index " << idx;
+        if (leaf < 0) continue;
+        Cell c = idxToCell(idx, graph);
+        const QuadLeaf &rect = quadtree.leaves[leaf];
+        ASSERT_TRUE(c.i >= rect.x0 && c.i < rect.x1 && c.j >= rect.y0 && c.j < rect.y1);
+    }
+
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0;
+    forEachSampledStart(graph, 200, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+        std::vector<Cell> path = quadtreeSearch(graph, quadtree, start, goal);
+        ASSERT_EQ(path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+        if (path.empty()) return;
+
+        ASSERT_EQ(path.front().i, start.i);
+        ASSERT_EQ(path.front().j, start.j);
+        ASSERT_EQ(path.back().i, goal.i);
+        ASSERT_EQ(path.back().j, goal.j);
+        for (const Cell &c : path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+        float cost = octilePathCost(path), optimal = octilePathCost(expected);
+        ASSERT_GE(cost, optimal - 1e-3);
+        ASSERT_LE(cost, 1.2 * optimal + 2) << "at " << start.i << ", " << start.j;
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 20);
+}
+
+/**
+ * Runs a search between two cells in each collision mode, and asserts that
+ * every mode finds the same collision free path, that lazy mode calls
+ * checkCollision() at most as often as eager mode, and that precomputed
+ * mode never calls it during the search.
+ * @param  map_file The map file to load into a graph.
+ * @param  search The search to run.
+ * @param  start The start cell.
+ * @param  goal The goal cell.
+ * @return  The number of checkCollision() calls in eager and lazy mode.
+ */
+std::pair<int64_t, int64_t> testCollisionModes(const std::string &map_file,
+                                               std::vector<Cell> (*search)(GridGraph &, const Cell &, const Cell &),
+                                               const Cell &start, const Cell &goal) {
+    GridGraph graph;
+    EXPECT_TRUE(loadFromFile(map_file, graph));
+    std::vector<std::vector<Cell>> paths;
+    std::vector<std::vector<Cell>> visited;
+    std::vector<int64_t> checks;
+    for (int mode : {COLLISION_EAGER, COLLISION_LAZY, COLLISION_PRECOMPUTED}) {
+        graph.collision_mode = mode;
+        graph.collision_checks = 0;
+        graph.visited_cells.clear();
+        paths.push_back(search(graph, start, goal));
+        visited.push_back(graph.visited_cells);
+        checks.push_back(graph.collision_checks);
+    }
+
+    EXPECT_FALSE(paths[0].empty());
+    for (size_t k = 1; k < paths[0].size(); ++k) {
+        EXPECT_FALSE(checkCollision(cellToIdx(paths[0][k].i, paths[0][k].j, graph), graph));
+    }
+    for (size_t mode = 1; mode < paths.size(); ++mode) {
+        EXPECT_EQ(paths[mode].size(), paths[0].size()) << "in mode " << mode;
+        EXPECT_EQ(visited[mode].size(), visited[0].size()) << "in mode " << mode;
+        for (size_t k = 0; k < paths[0].size() && k < paths[mode].size(); ++k) {
+            EXPECT_EQ(paths[mode][k].i, paths[0][k].i);
+            EXPECT_EQ(paths[mode][k].j, paths[0][k].j);
+        }
+    }
+    EXPECT_LE(checks[1], checks[0]);
+    EXPECT_EQ(checks[2], 0);
+    return {checks[0], checks[1]};
+}
+
+/**
+ * Runs weighted A* and focal search between sampled free cells and a goal
+ * for several bounds, and asserts that each path is collision free, that its
+ * cost is within the proven bound of the shortest path, that the proven
+ * bound is no more than w, and that a bound of 1 gives shortest paths.
+ * @param  graph The graph to search over, with its C-space computed.
+ * @param  goal The goal cell, which must be free.
+ */
+void testBoundedSearch(GridGraph &graph, const Cell &goal) {
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0;
+    forEachSampledStart(graph, 30, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+        float optimal = octilePathCost(expected);
+        for (float w : {1.0f, 1.5f, 3.0f}) {
+            for (auto search : {weightedAStarSearch, focalSearch}) {
+                BoundedSearchResult result = search(graph, start, goal, w);
+                ASSERT_EQ(result.path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+                if (result.path.empty()) continue;
+
+                ASSERT_EQ(result.path.front().i, start.i);
+                ASSERT_EQ(result.path.front().j, start.j);
+                ASSERT_EQ(result.path.back().i, goal.i);
+                ASSERT_EQ(result.path.back().j, goal.j);
+                for (const Cell &c : result.path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+                ASSERT_NEAR(result.cost, octilePathCost(result.path), 1e-3);
+                ASSERT_GE(result.cost, optimal - 1e-3);
+                ASSERT_LE(result.bound, w);
+                ASSERT_LE(result.cost, result.bound * optimal + 1e-3) << "with w " << w;
+                if (w == 1.0f) {
+                    ASSERT_NEAR(result.cost, optimal, 1e-3);
+                }
+                ASSERT_GT(result.expanded, 0);
+            }
+            ++num_paths;
+        }
+    });
+    ASSERT_GT(num_paths, 20);
+}
+
+/**
+ * Searches for the nearest of randomly placed free goals with random biases
+ * from sampled free cells, and asserts that the single pass finds the goal
+ * with the lowest path cost plus bias, as found by a flow field from each
+ * goal, along a collision free path.
+ * @param  graph The graph to search over, with its C-space computed.
+ * @param  num_goals The number of goals to place.
+ * @param  seed The random seed for the goals and biases.
+ */
+void testMultiGoalSearch(GridGraph &graph, int num_goals, unsigned int seed) {
+    graph.collision_mode = COLLISION_PRECOMPUTED;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> pos(0, graph.width * graph.height - 1);
+    std::uniform_real_distribution<float> bias(0, 20);
+    std::vector<Cell> goals;
+    std::vector<float> biases;
+    std::vector<FlowField> fields(num_goals);
+    while (static_cast<int>(goals.size()) < num_goals) {
+        int idx = pos(gen);
+        if (graph.cspace[idx]) continue;
+        goals.push_back(idxToCell(idx, graph));
+        biases.push_back(goals.size() % 2 == 0 ? 0 : bias(gen));
+        computeFlowField(graph, goals.back(), fields[goals.size() - 1]);
+    }
+
+    int num_paths = 0;
+    forEachSampledStart(graph, 60, [&](const Cell &start) {
+        float expected = HIGH;
+        for (int k = 0; k < num_goals; ++k) {
+            std::vector<Cell> path = flowFieldPath(fields[k], start);
+            if (!path.empty()) expected = std::min(expected, octilePathCost(path) + biases[k]);
+        }
+
+        MultiGoalResult result = multiGoalSearch(graph, start, goals, biases);
+        ASSERT_EQ(result.path.empty(), expected == HIGH) << "at " << start.i << ", " << start.j;
+        if (result.path.empty()) return;
+
+        ASSERT_GE(result.goal_index, 0);
+        ASSERT_LT(result.goal_index, num_goals);
+        const Cell &goal = goals[result.goal_index];
+        ASSERT_EQ(result.path.front().i, start.i);
+        ASSERT_EQ(result.path.front().j, start.j);
+        ASSERT_EQ(result.path.back().i, goal.i);
+        ASSERT_EQ(result.path.back().j, goal.j);
+        for (const Cell &c : result.path) ASSERT_FALSE(graph.cspace[cellToIdx(c.i, c.j, graph)]);
+        ASSERT_NEAR(result.cost, octilePathCost(result.path) + biases[result.goal_index], 1e-3);
+        ASSERT_NEAR(result.cost, expected, 1e-3) << "at " << start.i << ", " << start.j;
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 10);
+}
+
+/**
+ * Asserts that each pair of waypoints of a path is in line of sight or
+ * 8-connected, and that every waypoint but the start is free.
+ */
+void assertWaypointsConnected(GridGraph &graph, const std::vector<Cell> &waypoints) {
+    const OccupancyBits &blocked = getCSpaceBits(graph);
+    for (size_t k = 1; k < waypoints.size(); ++k) {
+        const Cell &a = waypoints[k - 1], &b = waypoints[k];
+        ASSERT_FALSE(testBit(blocked, b.i, b.j));
+        bool adjacent = std::max(std::abs(a.i - b.i), std::abs(a.j - b.j)) == 1;
+        ASSERT_TRUE(adjacent || lineOfSight(blocked, a.i, a.j, b.i, b.j))
+            << "from " << a.i << ", " << a.j << " to " << b.i << ", " << b.j;
+    }
+}
+
+/**
+ * Plans any-angle paths with Theta* and Lazy Theta* from sampled free cells
+ * to a goal, and shortcuts the shortest 8-connected paths. Asserts that the
+ * waypoints are connected, that the paths are no longer than the shortest
+ * 8-connected path, and that they need fewer waypoints than it has cells.
+ * @param  graph The graph to search over, with its C-space computed.
+ * @param  goal The goal cell, which must be free.
+ */
+void testAnyAngle(GridGraph &graph, const Cell &goal) {
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0;
+    size_t grid_cells = 0, theta_waypoints = 0;
+    forEachSampledStart(graph, 60, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+        float optimal = octilePathCost(expected);
+
+        for (auto search : {thetaStarSearch, lazyThetaStarSearch}) {
+            AnyAngleStats stats;
+            std::vector<Cell> path = search(graph, start, goal, &stats);
+            ASSERT_EQ(path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+            if (path.empty()) continue;
+
+            ASSERT_EQ(path.front().i, start.i);
+            ASSERT_EQ(path.front().j, start.j);
+            ASSERT_EQ(path.back().i, goal.i);
+            ASSERT_EQ(path.back().j, goal.j);
+            assertWaypointsConnected(graph, path);
+            ASSERT_LE(anyAnglePathLength(path), optimal + 1e-3) << "at " << start.i << ", " << start.j;
+            ASSERT_GT(stats.expanded, 0);
+            if (search == thetaStarSearch) theta_waypoints += path.size();
+        }
+        if (expected.empty()) return;
+
+        std::vector<Cell> shortcut = shortcutPath(graph, expected);
+        ASSERT_EQ(shortcut.front().i, start.i);
+        ASSERT_EQ(shortcut.front().j, start.j);
+        ASSERT_EQ(shortcut.back().i, goal.i);
+        ASSERT_EQ(shortcut.back().j, goal.j);
+        assertWaypointsConnected(graph, shortcut);
+        ASSERT_LE(anyAnglePathLength(shortcut), optimal + 1e-3);
+        grid_cells += expected.size();
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 10);
+    ASSERT_LT(2 * theta_waypoints, grid_cells);
+}
+
+/**
+ * Asserts that two cells are 8-connected neighbors.
+ */
+void assertAdjacent(const Cell &a, const Cell &b) {
+    ASSERT_EQ(std::max(std::abs(a.i - b.i), std::abs(a.j - b.j)), 1)
+        << "from " << a.i << ", " << a.j << " to " << b.i << ", " << b.j;
+}
+
+/**
+ * Checks the primitives of a state lattice: each one starts and ends at its
+ * headings, sweeps an 8-connected chain of cells to its end, and can be
+ * followed by the heuristic table no cheaper than it costs.
+ */
+void testLatticePrimitives(const StateLattice &lattice) {
+    ASSERT_EQ(lattice.primitives.size(), LATTICE_NUM_HEADINGS);
+    for (int heading = 0; heading < LATTICE_NUM_HEADINGS; ++heading) {
+        ASSERT_NEAR(latticeHeuristic(lattice, 0, 0, heading), 0, 1e-6);
+        ASSERT_EQ(latticeHeadingIndex(latticeHeadingAngle(heading)), heading);
+        int num_smooth_turns = 0;
+        for (const MotionPrimitive &primitive : lattice.primitives[heading]) {
+            ASSERT_EQ(primitive.start_heading, heading);
+            ASSERT_FALSE(primitive.poses.empty());
+            const auto &end = primitive.poses.back();
+            ASSERT_NEAR(end[0], primitive.di, 1e-4);
+            ASSERT_NEAR(end[1], primitive.dj, 1e-4);
+            ASSERT_NEAR(end[2], latticeHeadingAngle(primitive.end_heading), 1e-4);
+
+            float chord = std::sqrt(static_cast<float>(primitive.di * primitive.di + primitive.dj * primitive.dj));
+            ASSERT_GE(primitive.cost, chord - 1e-4);
+            // Reaching the origin from the primitive's start costs no more than the primitive.
+            ASSERT_LE(latticeHeuristic(lattice, -primitive.di, -primitive.dj, heading), primitive.cost + 1e-4);
+            if (primitive.di == 0 && primitive.dj == 0) {
+                ASSERT_TRUE(primitive.swept.empty());
+                continue;
+            }
+
+            Cell previous = {0, 0};
+            for (const Cell &c : primitive.swept) {
+                assertAdjacent(previous, c);
+                previous = c;
+            }
+            ASSERT_EQ(previous.i, primitive.di);
+            ASSERT_EQ(previous.j, primitive.dj);
+            if (primitive.end_heading != heading) ++num_smooth_turns;
+        }
+        ASSERT_EQ(num_smooth_turns, 2) << "at heading " << heading;
+    }
+}
+
+/**
+ * Plans lattice paths from sampled free cells, at varied start headings, to
+ * a goal, and asserts that a path is found whenever an 8-connected one
+ * exists, that its cells are free and 8-connected from the start to the
+ * goal, and that its poses start at the start and end at the goal.
+ * @param  graph The graph to search over, with its C-space computed.
+ * @param  lattice The lattice to search.
+ * @param  goal The goal cell, which must be free.
+ */
+void testLatticeSearch(GridGraph &graph, const StateLattice &lattice, const Cell &goal) {
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0;
+    forEachSampledStart(graph, 100, [&](const Cell &start) {
+        int idx = cellToIdx(start.i, start.j, graph);
+        bool reachable = !flowFieldPath(field, start).empty();
+        float theta = latticeHeadingAngle(idx % LATTICE_NUM_HEADINGS);
+        std::vector<Cell> cells;
+        LatticeSearchStats stats;
+        auto poses = latticeSearch(graph, lattice, start, theta, goal, &stats, &cells);
+        ASSERT_EQ(poses.empty(), !reachable) << "at " << start.i << ", " << start.j;
+        if (poses.empty()) return;
+
+        ASSERT_EQ(cells.front().i, start.i);
+        ASSERT_EQ(cells.front().j, start.j);
+        ASSERT_EQ(cells.back().i, goal.i);
+        ASSERT_EQ(cells.back().j, goal.j);
+        for (size_t k = 1; k < cells.size(); ++k) {
+            ASSERT_FALSE(graph.cspace[cellToIdx(cells[k].i, cells[k].j, graph)]);
+            assertAdjacent(cells[k - 1], cells[k]);
+        }
+
+        auto start_pos = cellToPos(start.i, start.j, graph), goal_pos = cellToPos(goal.i, goal.j, graph);
+        ASSERT_NEAR(poses.front()[0], start_pos[0], 1e-4);
+        ASSERT_NEAR(poses.front()[1], start_pos[1], 1e-4);
+        ASSERT_NEAR(poses.front()[2], theta, 1e-4);
+        ASSERT_NEAR(poses.back()[0], goal_pos[0], 1e-4);
+        ASSERT_NEAR(poses.back()[1], goal_pos[1], 1e-4);
+        for (size_t k = 1; k < poses.size(); ++k) {
+            float step = std::hypot(poses[k][0] - poses[k - 1][0], poses[k][1] - poses[k - 1][1]);
+            ASSERT_LE(step, 2 * graph.meters_per_cell);
+        }
+        ASSERT_GT(stats.expanded, 0);
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 10);
+}
+
+/**
+ * Checks that parallel A* finds an optimal path to the goal from cells all
+ * over the graph, with each number of threads given.
+ */
+void testParallelAStar(GridGraph &graph, const Cell &goal, const std::vector<int> &thread_counts) {
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    int num_paths = 0;
+    forEachSampledStart(graph, 40, [&](const Cell &start) {
+        std::vector<Cell> expected = flowFieldPath(field, start);
+
+        for (int num_threads : thread_counts) {
+            ParallelAStarResult result = parallelAStarSearch(graph, start, goal, num_threads);
+            ASSERT_EQ(result.num_threads, num_threads);
+            ASSERT_EQ(result.path.empty(), expected.empty()) << "at " << start.i << ", " << start.j;
+            if (result.path.empty()) continue;
+
+            ASSERT_EQ(result.path.front().i, start.i);
+            ASSERT_EQ(result.path.front().j, start.j);
+            ASSERT_EQ(result.path.back().i, goal.i);
+            ASSERT_EQ(result.path.back().j, goal.j);
+            for (size_t k = 1; k < result.path.size(); ++k) {
+                assertAdjacent(result.path[k - 1], result.path[k]);
+                ASSERT_FALSE(graph.cspace[cellToIdx(result.path[k].i, result.path[k].j, graph)]);
+            }
+            ASSERT_NEAR(result.cost, octilePathCost(result.path), 1e-3);
+            ASSERT_NEAR(result.cost, octilePathCost(expected), 1e-3)
+                << "at " << start.i << ", " << start.j << " with " << num_threads << " threads";
+            ASSERT_GT(result.expanded, 0);
+            if (num_threads == 1) {
+                ASSERT_EQ(result.messages, 0);
+            }
+        }
+        ++num_paths;
+    });
+    ASSERT_GT(num_paths, 10);
+}
+
+/**
+ * Checks that a path cache serves repeated queries and queries along a cached
+ * path from the cache, keeps paths the map edits leave free, and replans
+ * around edits that block them.
+ */
+void testPathCache(const std::string &map_file, const Cell &start, const Cell &goal) {
+    GridGraph graph;
+    ASSERT_TRUE(loadFromFile(map_file, graph));
+    PathCache cache;
+
+    FlowField field;
+    computeFlowField(graph, goal, field);
+    std::vector<Cell> path = cache.findPath(graph, start, goal);
+    ASSERT_GE(path.size(), 10);
+    ASSERT_NEAR(octilePathCost(path), octilePathCost(flowFieldPath(field, start)), 1e-3);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(cache.size(), 1);
+
+    std::vector<Cell> cached = cache.findPath(graph, start, goal);
+    ASSERT_EQ(cached.size(), path.size());
+    ASSERT_EQ(cache.hits(), 1);
+
+    // Both ways along the cached path.
+    size_t first = 2, last = path.size() - 3;
+    std::vector<Cell> forward = cache.findPath(graph, path[first], path[last]);
+    std::vector<Cell> backward = cache.findPath(graph, path[last], path[first]);
+    ASSERT_EQ(cache.subpathHits(), 2);
+    ASSERT_EQ(cache.misses(), 1);
+    ASSERT_EQ(forward.size(), last - first + 1);
+    ASSERT_EQ(backward.size(), last - first + 1);
+    for (size_t k = 0; k < forward.size(); ++k) {
+        ASSERT_EQ(forward[k].i, path[first + k].i);
+        ASSERT_EQ(forward[k].j, path[first + k].j);
+        ASSERT_EQ(backward[k].i, path[last - k].i);
+        ASSERT_EQ(backward[k].j, path[last - k].j);
+    }
+
+    // An edit far from the path keeps it.
+    int reach = static_cast<int>(std::ceil(graph.collision_radius / graph.meters_per_cell)) + 2;
+    int far = -1;
+    for (int idx = 0; idx < graph.width * graph.height && far < 0; ++idx) {
+        Cell c = idxToCell(idx, graph);
+        if (isIdxOccupied(idx, graph)) continue;
+        bool near = std::any_of(path.begin(), path.end(), [&](const Cell &p) {
+            return std::max(std::abs(p.i - c.i), std::abs(p.j - c.j)) <= reach;
+        });
+        if (!near) far = idx;
+    }
+    ASSERT_GE(far, 0);
+    setCellOdds(far, 127, graph);
+    ASSERT_EQ(cache.findPath(graph, start, goal).size(), path.size());
+    ASSERT_EQ(cache.hits(), 2);
+    ASSERT_EQ(cache.revalidated(), 1);
+    ASSERT_EQ(cache.invalidated(), 0);
+
+    // An edit on the path drops it and plans around the new obstacle.
+    Cell blocked = path[path.size() / 2];
+    setCellOdds(cellToIdx(blocked.i, blocked.j, graph), 127, graph);
+    std::vector<Cell> new_path = cache.findPath(graph, start, goal);
+    ASSERT_EQ(cache.invalidated(), 1);
+    ASSERT_EQ(cache.misses(), 2);
+    ASSERT_FALSE(new_path.empty());
+    for (const Cell &c : new_path) {
+        ASSERT_FALSE(c.i == blocked.i && c.j == blocked.j);
+    }
+    ASSERT_NEAR(cache.hitRate(), 4.0 / 6.0, 1e-9);
+}
+
+/**
+ * Checks that a path cache keeps under its memory cap by dropping the least
+ * recently used paths.
+ */
+void testPathCacheMemoryCap(GridGraph &graph, const std::vector<Cell> &goals) {
+    size_t max_bytes = 0;
+    for (size_t k = 1; k < goals.size(); ++k) {
+        PathCache probe;
+        ASSERT_FALSE(probe.findPath(graph, goals.front(), goals[k]).empty());
+        max_bytes = std::max(max_bytes, probe.bytes());
+    }
+    PathCache cache(2 * max_bytes);
+    for (size_t k = 1; k < goals.size(); ++k) {
+        cache.findPath(graph, goals.front(), goals[k]);
+        ASSERT_LE(cache.bytes(), 2 * max_bytes);
+    }
+    ASSERT_GT(cache.evicted(), 0);
+    ASSERT_LT(cache.size(), goals.size() - 1);
+
+    // The most recent path is still cached, the first is not.
+    int64_t misses = cache.misses();
+    cache.findPath(graph, goals.front(), goals.back());
+    ASSERT_EQ(cache.misses(), misses);
+    cache.findPath(graph, goals.front(), goals[1]);
+    ASSERT_EQ(cache.misses(), misses + 1);
+}
+
+/**
+ * Reads a whole file into a string.
+ */
+std::string readFileText(const std::string &file_path) {
+    std::ifstream in(file_path, std::ios::binary);
+    std::ostringstream oss;
+    oss << in.rdbuf();
+    return oss.str();
+}
+
+/**
+ * The plan file text as generatePlanFile() has always written it, built
+ * with std::to_string().
+ */
+std::string legacyPlanFileText(const Cell &start, const Cell &goal, const std::vector<Cell> &path,
+                               GridGraph &graph, const std::string &algo) {
+    std::ostringstream out;
+    out << "{ \"path\" : [";
+    for (size_t k = 0; k < path.size(); ++k) {
+        out << "[" + std::to_string(path[k].i) + "," + std::to_string(path[k].j) + "]";
+        if (k != path.size() - 1) out << ",";
+    }
+    out << "], \"visited_cells\":[";
+    for (size_t k = 0; k < graph.visited_cells.size(); ++k) {
+        out << "[" + std::to_string(graph.visited_cells[k].i) + "," + std::to_string(graph.visited_cells[k].j) + "]";
+        if (k != graph.visited_cells.size() - 1) out << ",";
+    }
+    out << "], \"dt\":[";
+    for (size_t k = 0; k < graph.obstacle_distances.size(); ++k) {
+        out << std::to_string(graph.obstacle_distances[k]);
+        if (k != graph.obstacle_distances.size() - 1) out << ",";
+    }
+    out << "], \"map\": \"" << mapAsString(graph) << "\"";
+    out << ", \"start\": [" + std::to_string(start.i) + "," + std::to_string(start.j) + "]";
+    out << ", \"goal\": [" + std::to_string(goal.i) + "," + std::to_string(goal.j) + "]";
+    out << ", \"planning_algo\": \"" + algo + "\"}";
+    return out.str();
+}
+
+/**
+ * Decodes base64 text with padding.
+ */
+std::vector<uint8_t> decodeBase64(const std::string &text) {
+    static const std::string kAlphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::vector<uint8_t> bytes;
+    uint32_t group = 0;
+    int bits = 0;
+    for (char c : text) {
+        if (c == '=') break;
+        group = (group << 6) | kAlphabet.find(c);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            bytes.push_back((group >> bits) & 0xFF);
+        }
+    }
+    return bytes;
+}
+
+/**
+ * Finds the string value of a key in a plan file.
+ */
+std::string planFileString(const std::string &text, const std::string &key) {
+    size_t at = text.find("\"" + key + "\": \"");
+    if (at == std::string::npos) return "";
+    size_t begin = at + key.size() + 5;
+    return text.substr(begin, text.find('"', begin) - begin);
+}
+
+/**
+ * Checks that plan files are written as before by default, that the compact
+ * sections decode to the map and distance transform, and that asynchronous
+ * writes match synchronous ones.
+ */
+void testPlanFile(GridGraph &graph, const Cell &start, const Cell &goal) {
+    std::vector<Cell> path = aStarSearch(graph, start, goal);
+    ASSERT_FALSE(path.empty());
+    std::string out_file = "plan_file.planner";
+
+    // Some distances with awkward roundings.
+    graph.obstacle_distances[0] = 1.0f / 128;
+    graph.obstacle_distances[1] = -0.0000004f;
+    graph.obstacle_distances[2] = 123456.789f;
+    ASSERT_TRUE(generatePlanFile(start, goal, path, graph, "astar", out_file));
+    ASSERT_EQ(readFileText(out_file), legacyPlanFileText(start, goal, path, graph, "astar"));
+
+    PlanFileOptions options;
+    ASSERT_TRUE(parsePlanFileMode("compact", options));
+    ASSERT_TRUE(generatePlanFile(start, goal, path, graph, "astar", out_file, options));
+    std::string text = readFileText(out_file);
+    ASSERT_EQ(text.find("\"dt\""), std::string::npos);
+    ASSERT_EQ(text.find("\"map\""), std::string::npos);
+    std::vector<uint8_t> dt = decodeBase64(planFileString(text, "dt_base64"));
+    ASSERT_EQ(dt.size(), graph.obstacle_distances.size() * sizeof(float));
+    ASSERT_EQ(std::memcmp(dt.data(), graph.obstacle_distances.data(), dt.size()), 0);
+    std::vector<uint8_t> odds = decodeBase64(planFileString(text, "map_base64"));
+    ASSERT_EQ(odds.size(), graph.cell_odds.size());
+    ASSERT_EQ(std::memcmp(odds.data(), graph.cell_odds.data(), odds.size()), 0);
+    std::string map_text = mapAsString(graph);
+    ASSERT_EQ(map_text.compare(0, planFileString(text, "map_header").size(), planFileString(text, "map_header")), 0);
+
+    ASSERT_TRUE(parsePlanFileMode("hash", options));
+    ASSERT_TRUE(generatePlanFile(start, goal, path, graph, "astar", out_file, options));
+    text = readFileText(out_file);
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx",
+                  static_cast<unsigned long long>(fnv1aChecksum(graph.cell_odds.data(), graph.cell_odds.size())));
+    ASSERT_EQ(planFileString(text, "map_hash"), hash);
+    ASSERT_EQ(planFileString(text, "dt_hash").size(), 16);
+
+    ASSERT_TRUE(parsePlanFileMode("path", options));
+    ASSERT_FALSE(parsePlanFileMode("everything", options));
+
+    // The asynchronous write copies the graph, so changing it after has no effect.
+    std::string expected = legacyPlanFileText(start, goal, path, graph, "astar");
+    std::future<bool> written = generatePlanFileAsync(start, goal, path, graph, "astar", out_file);
+    graph.visited_cells.clear();
+    graph.obstacle_distances[0] = 7;
+    ASSERT_TRUE(written.get());
+    ASSERT_EQ(readFileText(out_file), expected);
+    std::remove(out_file.c_str());
+}
+
+/**
+ * Loads a graph file and asserts that the hash lookup finds every node and
+ * that the compressed arcs of each node match the edges in the file, in the
+ * order they are listed.
+ * @param  graph_file The relative file path to the graph file.
+ */
+void testMichiganGraphArcs(std::string graph_file) {
+    Graph graph = createGraph(graph_file);
+    ASSERT_GT(numNodes(graph), 0);
+    ASSERT_EQ(numNodes(graph), graph.data.size());
+    for (int n = 0; n < numNodes(graph); ++n) {
+        ASSERT_EQ(nameToIdx(graph.data[n], graph), n);
+        ASSERT_EQ(std::find(graph.data.begin(), graph.data.end(), graph.data[n]) - graph.data.begin(), n);
+    }
+    ASSERT_EQ(nameToIdx("not_a_city", graph), -1);
+
+    // Read the edges back the simple way.
+    std::ifstream in(graph_file);
+    std::string s;
+    while (s != "EDGES") in >> s;
+    int num_edges = 0;
+    in >> num_edges;
+    std::vector<std::vector<int>> neighbors(numNodes(graph));
+    std::vector<std::vector<float>> costs(numNodes(graph));
+    for (int k = 0; k < num_edges; ++k) {
+        std::string city1, city2;
+        float dist;
+        in >> city1 >> city2 >> dist;
+        int c1 = nameToIdx(city1, graph), c2 = nameToIdx(city2, graph);
+        neighbors[c1].push_back(c2);
+        costs[c1].push_back(dist);
+        neighbors[c2].push_back(c1);
+        costs[c2].push_back(dist);
+    }
+    ASSERT_EQ(graph.arcs.size(), 2 * num_edges);
+    for (int n = 0; n < numNodes(graph); ++n) {
+        ASSERT_EQ(getNeighbors(n, graph), neighbors[n]);
+        ASSERT_EQ(getEdgeCosts(n, graph), costs[n]);
+    }
+}
+
+/**
+ * Writes a small directed road graph in the DIMACS format, with comments and
+ * no newline at the end, and asserts that it loads with its coordinates.
+ */
+void testDimacsGraph() {
+    const std::string gr_path = "test_dimacs.gr", co_path = "test_dimacs.co";
+    {
+        std::ofstream gr(gr_path);
+        gr << "c A small test graph\n"
+              "p sp 5 6\n"
+              "c Arcs\n"
+              "a 1 2 7\n"
+              "a 2 3 4\n"
+              "a 1 3 20\n"
+              "a 3 1 20\n"
+              "a 5 4 1\n"
+              "a 1 5 3";
+        std::ofstream co(co_path);
+        co << "c Coordinates\n"
+              "p aux sp co 5\n"
+              "v 1 -83743000 42280000\n"
+              "v 2 -83700000 42300000\n"
+              "v 3 -83600000 42310000\n"
+              "v 4 -83500000 42200000\n"
+              "v 5 -83650000 42250000\n";
+    }
+
+    Graph graph = createGraphFromDimacs(gr_path, co_path);
+    std::remove(gr_path.c_str());
+    std::remove(co_path.c_str());
+    ASSERT_EQ(numNodes(graph), 5);
+    ASSERT_EQ(graph.arcs.size(), 6);
+    ASSERT_TRUE(graph.data.empty());
+    ASSERT_EQ(getNeighbors(0, graph), std::vector<int>({1, 2, 4}));
+    ASSERT_EQ(getEdgeCosts(0, graph), std::vector<float>({7, 20, 3}));
+    ASSERT_EQ(getNeighbors(2, graph), std::vector<int>({0}));
+    ASSERT_TRUE(getNeighbors(3, graph).empty());
+    ASSERT_EQ(graph.x.size(), 5);
+    ASSERT_DOUBLE_EQ(graph.x[0], -83743000);
+    ASSERT_DOUBLE_EQ(graph.y[4], 42250000);
+
+    // Nodes are named by their DIMACS id.
+    ASSERT_EQ(nameToIdx("3", graph), 2);
+    ASSERT_EQ(nameToIdx("6", graph), -1);
+    ASSERT_EQ(nodeName(2, graph), "3");
+
+    // The shortest path goes through node 2, the cheaper way round.
+    std::vector<int> path = bfs(nameToIdx("1", graph), nameToIdx("3", graph), graph);
+    ASSERT_EQ(path, std::vector<int>({0, 1, 2}));
+    ASSERT_TRUE(bfs(nameToIdx("4", graph), nameToIdx("1", graph), graph).empty());
+    GraphSearchState state;
+    ASSERT_GT(graph.heuristic_scale, 0);
+    ASSERT_EQ(aStar(0, 2, graph, state), std::vector<int>({0, 1, 2}));
+    ASSERT_FLOAT_EQ(pathCost(2, state), 11);
+    ASSERT_TRUE(dijkstra(3, 0, graph, state).empty());
+
+    ASSERT_EQ(numNodes(createGraphFromDimacs("does_not_exist.gr")), 0);
+}
+
+/**
+ * Asserts that a path found on a graph starts and ends at the right nodes,
+ * follows arcs of the graph and costs what the search says it does.
+ */
+void assertGraphPath(const std::vector<int>& path, int start, int goal, double cost, const Graph& graph) {
+    ASSERT_FALSE(path.empty());
+    ASSERT_EQ(path.front(), start);
+    ASSERT_EQ(path.back(), goal);
+    double total = 0;
+    for (size_t k = 0; k + 1 < path.size(); ++k) {
+        float best = std::numeric_limits<float>::infinity();
+        for (const GraphArc& arc : arcsOf(path[k], graph)) {
+            if (arc.neighbor == path[k + 1]) best = std::min(best, arc.cost);
+        }
+        ASSERT_FALSE(std::isinf(best));
+        total += best;
+    }
+    ASSERT_NEAR(total, cost, 1e-3 * std::max(1.0, cost));
+}
+
+/**
+ * Asserts that dijkstra() and aStar() find the lowest cost paths between
+ * every pair of nodes of a graph file, checking against Floyd-Warshall. One
+ * search state is shared by every query.
+ * @param  graph_file The relative file path to the graph file.
+ */
+void testGraphShortestPaths(std::string graph_file) {
+    Graph graph = createGraph(graph_file);
+    int num_nodes = numNodes(graph);
+    ASSERT_GT(num_nodes, 0);
+    std::vector<std::vector<double>> distances(num_nodes,
+                                               std::vector<double>(num_nodes, std::numeric_limits<double>::infinity()));
+    for (int n = 0; n < num_nodes; ++n) {
+        distances[n][n] = 0;
+        for (const GraphArc& arc : arcsOf(n, graph)) {
+            distances[n][arc.neighbor] = std::min<double>(distances[n][arc.neighbor], arc.cost);
+        }
+    }
+    for (int k = 0; k < num_nodes; ++k) {
+        for (int i = 0; i < num_nodes; ++i) {
+            for (int j = 0; j < num_nodes; ++j) {
+                distances[i][j] = std::min(distances[i][j], distances[i][k] + distances[k][j]);
+            }
+        }
+    }
+
+    GraphSearchState state;
+    for (int start = 0; start < num_nodes; ++start) {
+        for (int goal = 0; goal < num_nodes; ++goal) {
+            double cost = distances[start][goal];
+            std::vector<int> path = dijkstra(start, goal, graph, state);
+            if (std::isinf(cost)) {
+                ASSERT_TRUE(path.empty());
+                ASSERT_TRUE(std::isinf(pathCost(goal, state)));
+                continue;
+            }
+            ASSERT_FLOAT_EQ(pathCost(goal, state), cost);
+            assertGraphPath(path, start, goal, cost, graph);
+
+            path = aStar(start, goal, graph, state);
+            ASSERT_FLOAT_EQ(pathCost(goal, state), cost);
+            assertGraphPath(path, start, goal, cost, graph);
+        }
+    }
+
+    // A missing goal is rejected without searching.
+    state.expanded = 0;
+    ASSERT_TRUE(dijkstra(0, -1, graph, state).empty());
+    ASSERT_TRUE(aStar(0, -1, graph, state).empty());
+    ASSERT_EQ(state.expanded, 0);
+}
+
+/**
+ * Builds a side x side grid road graph with coordinates, where each road
+ * costs its length times a random factor from 1 to 2, like the benchmark
+ * road networks.
+ */
+Graph makeGridRoadGraph(int side, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> factor(1, 2);
+    std::vector<int> sources;
+    std::vector<GraphArc> arcs;
+    Graph graph;
+    for (int j = 0; j < side; ++j) {
+        for (int i = 0; i < side; ++i) {
+            int n = i + j * side;
+            graph.x.push_back(10 * i);
+            graph.y.push_back(10 * j);
+            for (int m : {i + 1 < side ? n + 1 : -1, j + 1 < side ? n + side : -1}) {
+                if (m < 0) continue;
+                float cost = 10 * factor(gen);
+                sources.push_back(n);
+                arcs.push_back({m, cost});
+                sources.push_back(m);
+                arcs.push_back({n, cost});
+            }
+        }
+    }
+    buildGraphArcs(side * side, sources, arcs, graph);
+    setHeuristicScale(graph);
+    return graph;
+}
+
+/**
+ * Asserts that A* with coordinates finds paths as cheap as Dijkstra on a grid
+ * road graph while expanding no more nodes.
+ */
+void testGraphAStar() {
+    const int side = 40;
+    Graph graph = makeGridRoadGraph(side, 7);
+    ASSERT_GT(graph.heuristic_scale, 0.99);
+    ASSERT_LT(graph.heuristic_scale, 1.01);
+
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> node(0, side * side - 1);
+    GraphSearchState dijkstra_state, a_star_state;
+    int dijkstra_expanded = 0, a_star_expanded = 0;
+    for (int k = 0; k < 50; ++k) {
+        int start = node(gen), goal = node(gen);
+        std::vector<int> reference = dijkstra(start, goal, graph, dijkstra_state);
+        std::vector<int> path = aStar(start, goal, graph, a_star_state);
+        double cost = pathCost(goal, dijkstra_state);
+        ASSERT_NEAR(pathCost(goal, a_star_state), cost, 1e-3 * std::max(1.0, cost));
+        assertGraphPath(reference, start, goal, cost, graph);
+        assertGraphPath(path, start, goal, cost, graph);
+        ASSERT_LE(a_star_state.expanded, dijkstra_state.expanded);
+        dijkstra_expanded += dijkstra_state.expanded;
+        a_star_expanded += a_star_state.expanded;
+    }
+    ASSERT_LT(a_star_expanded, dijkstra_expanded);
+}
+
+/**
+ * Asserts that paths costing more than HIGH, and more than a float can hold
+ * exactly, are found with their exact cost, like paths across a continental
+ * road network.
+ */
+void testLargePathCosts() {
+    // A chain 0 -> 1 -> 2 -> 3 -> 4 costing 3e7 + 1 in total.
+    std::vector<int> sources = {0, 1, 2, 3};
+    std::vector<GraphArc> arcs = {{1, 1e7}, {2, 1e7}, {3, 1e7}, {4, 1}};
+    Graph graph;
+    buildGraphArcs(5, sources, arcs, graph);
+
+    GraphSearchState state;
+    ASSERT_EQ(dijkstra(0, 4, graph, state), std::vector<int>({0, 1, 2, 3, 4}));
+    ASSERT_EQ(pathCost(4, state), 30000001.0);
+    ASSERT_TRUE(dijkstra(4, 0, graph, state).empty());
+    ASSERT_TRUE(std::isinf(pathCost(0, state)));
+    ASSERT_EQ(bfs(0, 4, graph), std::vector<int>({0, 1, 2, 3, 4}));
+    ASSERT_EQ(dfs(0, 4, graph), std::vector<int>({0, 1, 2, 3, 4}));
+}
+
+/**
+ * Builds a random graph of one-way arcs, where some nodes cannot reach
+ * others. Each node has out_degree arcs to random nodes, costing 1 to 10.
+ */
+Graph makeRandomDirectedGraph(int num_nodes, int out_degree, int seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> node(0, num_nodes - 1);
+    std::uniform_real_distribution<float> cost(1, 10);
+    std::vector<int> sources;
+    std::vector<GraphArc> arcs;
+    for (int n = 0; n < num_nodes; ++n) {
+        for (int k = 0; k < out_degree; ++k) {
+            sources.push_back(n);
+            arcs.push_back({node(gen), cost(gen)});
+        }
+    }
+    Graph graph;
+    buildGraphArcs(num_nodes, sources, arcs, graph);
+    return graph;
+}
+
+/**
+ * Runs a search between random pairs of nodes and asserts that it finds a
+ * path of the graph as cheap as Dijkstra, or none when Dijkstra finds none.
+ * The search is called as search(start, goal, reference, path, path_cost),
+ * with reference holding the Dijkstra query, and leaves path_cost infinite
+ * when it finds no path.
+ */
+template <typename Search>
+void assertQueriesMatchDijkstra(const Graph& graph, int num_queries, int seed, Search search) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> node(0, numNodes(graph) - 1);
+    GraphSearchState reference;
+    for (int k = 0; k < num_queries; ++k) {
+        int start = node(gen), goal = node(gen);
+        bool found = !dijkstra(start, goal, graph, reference).empty();
+        std::vector<int> path;
+        double path_cost = std::numeric_limits<double>::infinity();
+        search(start, goal, reference, path, path_cost);
+        ASSERT_FALSE(::testing::Test::HasFatalFailure());
+        if (!found) {
+            ASSERT_TRUE(path.empty());
+            ASSERT_TRUE(std::isinf(path_cost));
+            continue;
+        }
+        double cost = pathCost(goal, reference);
+        ASSERT_NEAR(path_cost, cost, 1e-3 * std::max(1.0, cost));
+        assertGraphPath(path, start, goal, cost, graph);
+    }
+}
+
+/**
+ * Asserts that contraction hierarchy queries match Dijkstra between random
+ * nodes.
+ */
+void assertChQueries(const Graph& graph, const ContractionHierarchy& ch, int num_queries, int seed) {
+    ChQueryState query;
+    assertQueriesMatchDijkstra(graph, num_queries, seed, [&](int start, int goal, const GraphSearchState&,
+                                                             std::vector<int>& path, double& path_cost) {
+        path = chQuery(start, goal, ch, query);
+        path_cost = query.path_cost;
+    });
+}
+
+/**
+ * Builds contraction hierarchies of the Michigan graphs, a grid road graph
+ * and a random graph of one-way arcs, and checks their queries against
+ * Dijkstra. The grid is built with one and three threads, which must give
+ * the same hierarchy.
+ */
+void testContractionHierarchy() {
+    for (std::string file : {"../data/planning_in_michigan/mi_graph.txt",
+                             "../data/planning_in_michigan/bereaf23_graph.txt"}) {
+        Graph graph = createGraph(file);
+        ContractionHierarchy ch = buildContractionHierarchy(graph, 1);
+        assertChQueries(graph, ch, 200, 1);
+        ChQueryState query;
+        for (int n = 0; n < numNodes(graph); ++n) {
+            ASSERT_EQ(chQuery(n, n, ch, query), std::vector<int>({n}));
+        }
+    }
+
+    Graph grid = makeGridRoadGraph(30, 11);
+    ContractionHierarchy ch = buildContractionHierarchy(grid, 1);
+    ContractionHierarchy threaded = buildContractionHierarchy(grid, 3);
+    ASSERT_GT(ch.num_shortcuts, 0);
+    ASSERT_EQ(threaded.num_shortcuts, ch.num_shortcuts);
+    ASSERT_EQ(threaded.rank, ch.rank);
+    assertChQueries(grid, ch, 200, 2);
+    assertChQueries(grid, threaded, 50, 3);
+
+    // One-way arcs, where some nodes cannot reach others.
+    Graph directed = makeRandomDirectedGraph(300, 2, 5);
+    assertChQueries(directed, buildContractionHierarchy(directed, 2), 300, 4);
+}
+
+/**
+ * Asserts that the landmark bounds never overestimate and that both ALT
+ * searches find paths as cheap as Dijkstra, or none when Dijkstra finds
+ * none, between random nodes.
+ */
+void assertAltQueries(const Graph& graph, const AltLandmarks& alt, int num_queries, int seed) {
+    GraphSearchState a_star;
+    assertQueriesMatchDijkstra(graph, num_queries, seed, [&](int start, int goal, const GraphSearchState& reference,
+                                                             std::vector<int>& path, double& path_cost) {
+        path = altAStar(start, goal, graph, alt, a_star);
+        path_cost = pathCost(goal, a_star);
+        double cost = pathCost(goal, reference);
+        if (!std::isinf(cost)) {
+            ASSERT_LE(altLowerBound(start, goal, alt), cost * (1 + 1e-4) + 1e-3);
+            ASSERT_LE(a_star.expanded, reference.expanded);
+        }
+    });
+    AltQueryState bidirectional;
+    assertQueriesMatchDijkstra(graph, num_queries, seed, [&](int start, int goal, const GraphSearchState&,
+                                                             std::vector<int>& path, double& path_cost) {
+        path = altBidirectionalAStar(start, goal, graph, alt, bidirectional);
+        path_cost = bidirectional.path_cost;
+    });
+}
+
+/**
+ * Selects landmarks on the Michigan graphs, a grid road graph and a random
+ * graph of one-way arcs with both methods, and checks the ALT searches
+ * against Dijkstra.
+ */
+void testAltLandmarks() {
+    for (int method : {ALT_SELECT_FARTHEST, ALT_SELECT_AVOID}) {
+        for (std::string file : {"../data/planning_in_michigan/mi_graph.txt",
+                                 "../data/planning_in_michigan/bereaf23_graph.txt"}) {
+            Graph graph = createGraph(file);
+            AltLandmarks alt = selectLandmarks(graph, 3, method);
+            ASSERT_TRUE(alt.symmetric);
+            ASSERT_TRUE(alt.to_landmark.empty());
+            ASSERT_EQ(alt.bytes(), 3 * numNodes(graph) * sizeof(float));
+            assertAltQueries(graph, alt, 200, 1);
+        }
+
+        Graph grid = makeGridRoadGraph(30, 13);
+        AltLandmarks alt = selectLandmarks(grid, 8, method);
+        ASSERT_EQ(alt.landmarks.size(), 8);
+        std::vector<int> sorted = alt.landmarks;
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_TRUE(std::unique(sorted.begin(), sorted.end()) == sorted.end());
+        assertAltQueries(grid, alt, 200, 2);
+
+        // One-way arcs, where some nodes cannot reach others.
+        const int num_nodes = 300;
+        Graph directed = makeRandomDirectedGraph(num_nodes, 2, 5);
+        AltLandmarks directed_alt = selectLandmarks(directed, 4, method);
+        ASSERT_FALSE(directed_alt.symmetric);
+        ASSERT_EQ(directed_alt.bytes(), 2 * 4 * num_nodes * sizeof(float));
+        assertAltQueries(directed, directed_alt, 300, 4);
+    }
+
+    // Without landmarks both searches are plain Dijkstra.
+    Graph graph = createGraph("../data/planning_in_michigan/mi_graph.txt");
+    assertAltQueries(graph, selectLandmarks(graph, 0), 50, 6);
+}
+
+/**
+ * Asserts that a distance table holds the same costs as Dijkstra between
+ * each source and target, and that its paths, if any, cost as much.
+ */
+void assertDistanceTable(const DistanceTable& table, const Graph& graph, bool with_paths) {
+    ASSERT_EQ(table.cost.size(), table.sources.size() * table.targets.size());
+    ASSERT_EQ(table.path_offsets.empty(), !with_paths);
+    GraphSearchState search;
+    for (int i = 0; i < static_cast<int>(table.sources.size()); ++i) {
+        for (int j = 0; j < static_cast<int>(table.targets.size()); ++j) {
+            int start = table.sources[i], goal = table.targets[j];
+            std::vector<int> reference = dijkstra(start, goal, graph, search);
+            std::vector<int> path = tablePath(i, j, table);
+            if (reference.empty()) {
+                ASSERT_TRUE(std::isinf(table.at(i, j)));
+                ASSERT_TRUE(path.empty());
+                continue;
+            }
+            double cost = pathCost(goal, search);
+            ASSERT_DOUBLE_EQ(table.at(i, j), cost);
+            if (with_paths) assertGraphPath(path, start, goal, cost, graph);
+        }
+    }
+}
+
+/**
+ * Builds distance tables on a grid road graph and a random graph of one-way
+ * arcs, with and without paths and on one or several threads, including
+ * repeated targets and indices that are not nodes.
+ */
+void testDistanceTable() {
+    Graph grid = makeGridRoadGraph(30, 17);
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> node(0, numNodes(grid) - 1);
+    std::vector<int> sources, targets;
+    for (int k = 0; k < 12; ++k) sources.push_back(node(gen));
+    for (int k = 0; k < 20; ++k) targets.push_back(node(gen));
+    targets.push_back(targets[0]);
+    targets.push_back(sources[0]);
+    targets.push_back(-1);
+    sources.push_back(numNodes(grid));
+    for (int threads : {1, 3}) {
+        for (bool with_paths : {false, true}) {
+            DistanceTable table = distanceTable(sources, targets, grid, with_paths, threads);
+            assertDistanceTable(table, grid, with_paths);
+            ASSERT_DOUBLE_EQ(table.at(0, targets.size() - 2), 0);
+        }
+    }
+
+    // One-way arcs, where some targets cannot be reached.
+    const int num_nodes = 200;
+    Graph directed = makeRandomDirectedGraph(num_nodes, 1, 3);
+    std::vector<int> all(num_nodes);
+    for (int n = 0; n < num_nodes; ++n) all[n] = n;
+    assertDistanceTable(distanceTable(all, all, directed, true, 2), directed, true);
+
+    // Empty sets of sources or targets give an empty table.
+    DistanceTable empty = distanceTable({}, targets, grid, true);
+    ASSERT_TRUE(empty.cost.empty());
+    ASSERT_TRUE(distanceTable(sources, {}, grid).cost.empty());
+}